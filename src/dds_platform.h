@@ -14,6 +14,35 @@
     #define DDS_DEBUG_PRINT(...) Serial.printf(__VA_ARGS__)
     #define DDS_DEBUG_PRINTLN(msg) Serial.println(msg)
     
+#elif defined(DDS_HOST)
+    // Host build (Linux/macOS) for tests and benchmarks without hardware
+    #include <stdint.h>
+    #include <stdio.h>
+    #include <time.h>
+    #include <unistd.h>
+    
+    static inline uint64_t dds_host_time_us(void) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+    }
+    
+    // Added to DDS_MICROS only, lets tests run the 32-bit clock across its wrap
+    inline uint32_t& dds_host_micros_offset(void) {
+        static uint32_t offset;
+        return offset;
+    }
+    
+    // Host platform implementations
+    #define DDS_DELAY(ms) usleep((useconds_t)(ms) * 1000)
+    #define DDS_MILLIS() (uint32_t)(dds_host_time_us() / 1000ULL)
+    #define DDS_MICROS() ((uint32_t)dds_host_time_us() + dds_host_micros_offset())
+    #define DDS_TASK_DELAY(ms) DDS_DELAY(ms)
+    
+    // Host debug output
+    #define DDS_DEBUG_PRINT(...) printf(__VA_ARGS__)
+    #define DDS_DEBUG_PRINTLN(msg) printf("%s\n", msg)
+    
 #else
     // Generic FreeRTOS implementations
     #include <freertos/FreeRTOS.h>
@@ -1,474 +1,3446 @@
 #include "esp_dds.h"
 
-static esp_dds_context_t dds_ctx;
+ESP_DDS_DOMAIN_DEFINE(default_domain, ESP_DDS_MAX_TOPICS, ESP_DDS_MAX_SERVICES, ESP_DDS_MAX_ACTIONS,
+                      ESP_DDS_NAME_ARENA_SIZE);
 
-// Internal helper functions
-static bool esp_dds_validate_name(const char* name) {
-    if (!name || name[0] == '\0') {
-        return false; // Null or empty
+// Name API - one pass for validation, length and hash
+esp_dds_name_t esp_dds_make_name(const char* name) {
+    esp_dds_name_t n = { name, ESP_DDS_NAME_HASH_SEED, 0 };
+    if (!name || name[0] != '/') {
+        return n; // Null, empty or no leading slash (ROS2 convention)
+    }
+    
+    uint8_t length = 0;
+    while (name[length] != '\0') {
+        if (length == ESP_DDS_MAX_NAME_LENGTH - 1) {
+            return n; // Too long
+        }
+        n.hash = (n.hash ^ (uint8_t)name[length]) * ESP_DDS_NAME_HASH_PRIME;
+        length++;
     }
-    if (strlen(name) >= ESP_DDS_MAX_NAME_LENGTH) {
-        return false; // Too long
+    if (length >= ESP_DDS_MIN_NAME_LENGTH) {
+        n.length = length;
     }
-    if (strlen(name) < ESP_DDS_MIN_NAME_LENGTH) {
-        return false; // Too short
+    return n;
+}
+
+// Internal helper functions
+static bool esp_dds_validate_name(const char* name) {
+    return esp_dds_make_name(name).length != 0;
+}
+
+static const char* name_str(esp_dds_domain_t* d, uint16_t id) {
+    return &d->names.data[id];
+}
+
+// Hashes decide, the byte compare only guards against collisions on a hit
+static bool name_equals(esp_dds_domain_t* d, uint16_t stored, uint32_t stored_hash,
+                        const esp_dds_name_t* name) {
+    return stored_hash == name->hash && stored != ESP_DDS_NO_NAME &&
+           memcmp(name_str(d, stored), name->str, name->length + 1) == 0;
+}
+
+// Setup path only - returns the existing copy of a name or appends a new one
+static uint16_t intern_name(esp_dds_domain_t* d, const char* str, size_t length) {
+    esp_dds_name_arena_t* arena = &d->names;
+    for (uint16_t pos = 0; pos < arena->used; pos += strlen(&arena->data[pos]) + 1) {
+        if (strcmp(&arena->data[pos], str) == 0) return pos;
     }
-    if (name[0] != '/') {
-        return false; // Must start with slash (ROS2 convention)
+    if (arena->used + length + 1 > arena->size) return ESP_DDS_NO_NAME;
+    
+    uint16_t id = arena->used;
+    memcpy(&arena->data[id], str, length + 1);
+    arena->used += length + 1;
+    return id;
+}
+
+// Pops the free list, otherwise takes the next never-used slot - O(1) either way
+static bool alloc_slot(esp_dds_slot_t* slots, esp_dds_index_t* free_head, esp_dds_index_t* count,
+                       esp_dds_index_t max, esp_dds_index_t* index) {
+    if (*free_head != ESP_DDS_NO_SLOT) {
+        *index = *free_head;
+        *free_head = slots[*index].next_free;
+    } else if (*count < max) {
+        *index = (*count)++;
+    } else {
+        return false;
     }
+    slots[*index].in_use = true;
     return true;
 }
 
-static bool find_empty_slot(uint8_t* count, uint8_t max, uint8_t* index) {
-    for (uint8_t i = 0; i < max; i++) {
-        if (*count < max) {
-            *index = i;
-            (*count)++;
-            return true;
-        }
+static void free_slot(esp_dds_slot_t* slots, esp_dds_index_t* free_head, esp_dds_index_t index) {
+    slots[index].in_use = false;
+    slots[index].generation++;
+    slots[index].next_free = *free_head;
+    *free_head = index;
+}
+
+static void reset_slots(esp_dds_domain_t* d) {
+    memset(d->topic_slots, 0, d->max_topics * sizeof(esp_dds_slot_t));
+    memset(d->service_slots, 0, d->max_services * sizeof(esp_dds_slot_t));
+    memset(d->action_slots, 0, d->max_actions * sizeof(esp_dds_slot_t));
+    d->free_topic = ESP_DDS_NO_SLOT;
+    d->free_service = ESP_DDS_NO_SLOT;
+    d->free_action = ESP_DDS_NO_SLOT;
+}
+
+static bool pending_target_alive(esp_dds_domain_t* d, const esp_dds_pending_t* p) {
+    if (p->remote) return true;
+    const esp_dds_slot_t* slot = p->is_action ? &d->action_slots[p->target_index]
+                                              : &d->service_slots[p->target_index];
+    return slot->in_use && slot->generation == p->target_generation;
+}
+
+static void remove_pending(esp_dds_domain_t* d, esp_dds_index_t i) {
+    for (esp_dds_index_t j = i; j < d->pending_count - 1; j++) {
+        d->pending[j] = d->pending[j + 1];
     }
-    return false;
+    d->pending_count--;
 }
 
-static bool take_mutex(uint32_t timeout_ms) {
+static bool take_mutex(esp_dds_domain_t* d, uint32_t timeout_ms) {
 #ifdef ESP_PLATFORM
-    return xSemaphoreTake(dds_ctx.mutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+    return xSemaphoreTake(d->mutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
 #else
     return true; // Stub for non-ESP platforms
 #endif
 }
 
-static void give_mutex(void) {
+static void give_mutex(esp_dds_domain_t* d) {
 #ifdef ESP_PLATFORM
-    xSemaphoreGive(dds_ctx.mutex);
+    xSemaphoreGive(d->mutex);
 #endif
 }
 
-static esp_dds_topic_t* find_topic(const char* name) {
-    for (uint8_t i = 0; i < dds_ctx.topic_count; i++) {
-        if (strcmp(dds_ctx.topics[i].name, name) == 0) {
-            return &dds_ctx.topics[i];
+static esp_dds_topic_t* find_topic(esp_dds_domain_t* d, const esp_dds_name_t* name) {
+    for (esp_dds_index_t i = 0; i < d->topic_count; i++) {
+        if (name_equals(d, d->topic_info[i].name_id, d->topic_hashes[i], name)) {
+            return &d->topics[i];
         }
     }
     return NULL;
 }
 
-static esp_dds_service_t* find_service(const char* name) {
-    for (uint8_t i = 0; i < dds_ctx.service_count; i++) {
-        if (strcmp(dds_ctx.services[i].name, name) == 0) {
-            return &dds_ctx.services[i];
+// Wildcard trie helpers
+#define MAX_NAME_SEGMENTS (ESP_DDS_MAX_NAME_LENGTH / 2)
+
+typedef struct {
+    uint8_t start[MAX_NAME_SEGMENTS];
+    uint8_t length[MAX_NAME_SEGMENTS];
+    uint32_t hash[MAX_NAME_SEGMENTS];
+    uint8_t count;
+} name_segments_t;
+
+static uint32_t hash_segment(const char* s, uint8_t length) {
+    uint32_t h = 2166136261UL; // FNV-1a
+    for (uint8_t i = 0; i < length; i++) {
+        h = (h ^ (uint8_t)s[i]) * 16777619UL;
+    }
+    return h;
+}
+
+static void split_name(const char* name, name_segments_t* segs) {
+    segs->count = 0;
+    uint8_t pos = 1; // Skip leading slash
+    while (segs->count < MAX_NAME_SEGMENTS) {
+        uint8_t len = 0;
+        while (name[pos + len] != '\0' && name[pos + len] != '/') len++;
+        segs->start[segs->count] = pos;
+        segs->length[segs->count] = len;
+        segs->hash[segs->count] = hash_segment(&name[pos], len);
+        segs->count++;
+        if (name[pos + len] == '\0') break;
+        pos += len + 1;
+    }
+}
+
+static bool is_segment(const char* name, const name_segments_t* segs, uint8_t i, char c) {
+    return segs->length[i] == 1 && name[segs->start[i]] == c;
+}
+
+// Direct pattern match, used to confirm trie hits against hash collisions
+static bool pattern_matches(const char* pattern, const char* name) {
+    // Both start with a slash, compare one segment per iteration
+    while (*pattern == '/') {
+        pattern++;
+        if (*pattern == '#') return true; // Zero or more remaining segments
+        if (*name != '/') return false;
+        name++;
+        
+        if (*pattern == '*') {
+            pattern++;
+            while (*name && *name != '/') name++;
+        } else {
+            while (*pattern && *pattern != '/') {
+                if (*pattern++ != *name++) return false;
+            }
+            if (*name && *name != '/') return false;
         }
     }
-    return NULL;
+    return *pattern == '\0' && *name == '\0';
 }
 
-static esp_dds_action_t* find_action(const char* name) {
-    for (uint8_t i = 0; i < dds_ctx.action_count; i++) {
-        if (strcmp(dds_ctx.actions[i].name, name) == 0) {
-            return &dds_ctx.actions[i];
+static uint32_t collect_wildcard_subs(esp_dds_domain_t* d, uint8_t node) {
+    uint32_t matched = 0;
+    for (uint8_t k = 0; k < ESP_DDS_MAX_WILDCARD_SUBS; k++) {
+        if (d->wildcard_subs[k].in_use && d->wildcard_subs[k].node == node) {
+            matched |= 1UL << k;
         }
     }
-    return NULL;
+    return matched;
 }
 
-// Public API implementation
-void esp_dds_init(void) {
-    memset(&dds_ctx, 0, sizeof(dds_ctx));
+static uint32_t match_trie(esp_dds_domain_t* d, uint8_t list, const name_segments_t* segs, uint8_t i) {
+    static const uint32_t star_hash = hash_segment("*", 1);
+    static const uint32_t hash_hash = hash_segment("#", 1);
+    uint32_t matched = 0;
     
-#ifdef ESP_PLATFORM
-    dds_ctx.mutex = xSemaphoreCreateMutex();
-#endif
-    
-    dds_ctx.running = true;
+    for (uint8_t n = list; n != ESP_DDS_TRIE_NONE; n = d->trie_nodes[n].next_sibling) {
+        const esp_dds_trie_node_t* node = &d->trie_nodes[n];
+        if (node->length == 1 && node->hash == hash_hash) {
+            matched |= collect_wildcard_subs(d, n);
+            continue;
+        }
+        if (i == segs->count) continue;
+        
+        if ((node->length == 1 && node->hash == star_hash) ||
+            (node->length == segs->length[i] && node->hash == segs->hash[i])) {
+            if (i + 1 == segs->count) matched |= collect_wildcard_subs(d, n);
+            matched |= match_trie(d, node->first_child, segs, i + 1);
+        }
+    }
+    return matched;
 }
 
-void esp_dds_reset(void) {
-    if (!take_mutex(1000)) return;
-    
-    dds_ctx.running = false;
-    
-    // Clear all state
-    memset(dds_ctx.topics, 0, sizeof(dds_ctx.topics));
-    memset(dds_ctx.services, 0, sizeof(dds_ctx.services));
-    memset(dds_ctx.actions, 0, sizeof(dds_ctx.actions));
-    memset(dds_ctx.pending, 0, sizeof(dds_ctx.pending));
-    
-    dds_ctx.topic_count = 0;
-    dds_ctx.service_count = 0;
-    dds_ctx.action_count = 0;
-    dds_ctx.pending_count = 0;
-    
-    dds_ctx.running = true;
-    
-    give_mutex();
+static uint8_t find_trie_child(esp_dds_domain_t* d, uint8_t list, uint32_t hash, uint8_t length) {
+    for (uint8_t n = list; n != ESP_DDS_TRIE_NONE; n = d->trie_nodes[n].next_sibling) {
+        if (d->trie_nodes[n].hash == hash && d->trie_nodes[n].length == length) {
+            return n;
+        }
+    }
+    return ESP_DDS_TRIE_NONE;
 }
 
-// Topic implementation
-bool esp_dds_publish(const char* topic, const void* data, size_t size) {
-    if (!esp_dds_validate_name(topic)) return false;
-    if (!topic || !data || size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
-    if (!take_mutex(100)) return false;
-    
-    esp_dds_topic_t* t = find_topic(topic);
-    if (!t) {
-        // Auto-create topic on first publish
-        if (dds_ctx.topic_count >= ESP_DDS_MAX_TOPICS) {
-            give_mutex();
-            return false;
+static uint8_t trie_insert(esp_dds_domain_t* d, const name_segments_t* segs) {
+    // Make sure the whole path fits before touching the trie
+    uint8_t missing = 0;
+    uint8_t list = d->trie_root;
+    for (uint8_t i = 0; i < segs->count; i++) {
+        uint8_t n = list == ESP_DDS_TRIE_NONE ? ESP_DDS_TRIE_NONE :
+                    find_trie_child(d, list, segs->hash[i], segs->length[i]);
+        if (n == ESP_DDS_TRIE_NONE) {
+            missing = segs->count - i;
+            break;
         }
-        t = &dds_ctx.topics[dds_ctx.topic_count];
-        strncpy(t->name, topic, ESP_DDS_MAX_NAME_LENGTH - 1);
-        t->subscriber_count = 0;
-        dds_ctx.topic_count++;
+        list = d->trie_nodes[n].first_child;
     }
+    uint8_t free_nodes = 0;
+    for (uint8_t n = 0; n < ESP_DDS_MAX_TRIE_NODES; n++) {
+        if (d->trie_nodes[n].refs == 0) free_nodes++;
+    }
+    if (free_nodes < missing) return ESP_DDS_TRIE_NONE;
     
-    // Deliver to subscribers immediately (in publisher's thread)
-    for (uint8_t i = 0; i < t->subscriber_count; i++) {
-        if (t->callbacks[i]) {
-            t->callbacks[i](topic, data, size, t->contexts[i]);
+    uint8_t* link = &d->trie_root;
+    uint8_t node = ESP_DDS_TRIE_NONE;
+    for (uint8_t i = 0; i < segs->count; i++) {
+        node = find_trie_child(d, *link, segs->hash[i], segs->length[i]);
+        if (node == ESP_DDS_TRIE_NONE) {
+            for (node = 0; d->trie_nodes[node].refs != 0; node++) {}
+            esp_dds_trie_node_t* fresh = &d->trie_nodes[node];
+            fresh->hash = segs->hash[i];
+            fresh->length = segs->length[i];
+            fresh->first_child = ESP_DDS_TRIE_NONE;
+            fresh->next_sibling = *link;
+            *link = node;
         }
+        d->trie_nodes[node].refs++;
+        link = &d->trie_nodes[node].first_child;
     }
-    
-    give_mutex();
-    return true;
+    return node;
 }
 
-bool esp_dds_subscribe(const char* topic, esp_dds_topic_cb_t callback, void* context) {
-    if (!esp_dds_validate_name(topic)) return false;
-    if (!topic || !callback) return false;
-    if (!take_mutex(100)) return false;
-    
-    esp_dds_topic_t* t = find_topic(topic);
-    if (!t) {
-        // Create topic if it doesn't exist
-        if (dds_ctx.topic_count >= ESP_DDS_MAX_TOPICS) {
-            give_mutex();
-            return false;
+static void trie_remove(esp_dds_domain_t* d, const name_segments_t* segs) {
+    uint8_t* link = &d->trie_root;
+    for (uint8_t i = 0; i < segs->count; i++) {
+        uint8_t node = find_trie_child(d, *link, segs->hash[i], segs->length[i]);
+        if (node == ESP_DDS_TRIE_NONE) return;
+        
+        esp_dds_trie_node_t* n = &d->trie_nodes[node];
+        if (--n->refs == 0) {
+            // Unlink; the rest of the path belongs only to this pattern and is freed too
+            uint8_t* prev = link;
+            while (*prev != node) prev = &d->trie_nodes[*prev].next_sibling;
+            *prev = n->next_sibling;
+            for (uint8_t j = i + 1; j < segs->count; j++) {
+                node = find_trie_child(d, n->first_child, segs->hash[j], segs->length[j]);
+                if (node == ESP_DDS_TRIE_NONE) break;
+                n = &d->trie_nodes[node];
+                n->refs = 0;
+            }
+            return;
         }
-        t = &dds_ctx.topics[dds_ctx.topic_count];
-        strncpy(t->name, topic, ESP_DDS_MAX_NAME_LENGTH - 1);
-        dds_ctx.topic_count++;
+        link = &n->first_child;
     }
+}
+
+static bool validate_pattern(const char* pattern, name_segments_t* segs) {
+    if (!esp_dds_validate_name(pattern)) return false;
     
-    if (t->subscriber_count >= ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC) {
-        give_mutex();
-        return false;
+    split_name(pattern, segs);
+    for (uint8_t i = 0; i < segs->count; i++) {
+        for (uint8_t c = 0; c < segs->length[i]; c++) {
+            char ch = pattern[segs->start[i] + c];
+            if ((ch == '*' || ch == '#') && segs->length[i] != 1) return false;
+        }
+        if (is_segment(pattern, segs, i, '#') && i + 1 != segs->count) return false;
     }
-    
-    t->callbacks[t->subscriber_count] = callback;
-    t->contexts[t->subscriber_count] = context;
-    t->subscriber_count++;
-    
-    give_mutex();
     return true;
 }
 
-void esp_dds_unsubscribe(const char* topic, esp_dds_topic_cb_t callback) {
-    if (!take_mutex(100)) return;
+static void append_subscriber(esp_dds_domain_t* d, esp_dds_topic_t* t, esp_dds_topic_cb_t callback,
+                              void* context, uint8_t wildcard) {
+    if (t->subscriber_count >= d->max_subscribers) return;
     
-    esp_dds_topic_t* t = find_topic(topic);
-    if (t) {
-        for (uint8_t i = 0; i < t->subscriber_count; i++) {
-            if (t->callbacks[i] == callback) {
-                // Shift remaining subscribers
-                for (uint8_t j = i; j < t->subscriber_count - 1; j++) {
-                    t->callbacks[j] = t->callbacks[j + 1];
-                    t->contexts[j] = t->contexts[j + 1];
+    esp_dds_subscriber_t* sub = &t->subscribers[t->subscriber_count];
+    sub->callback = callback;
+    sub->context = context;
+    sub->filter = ESP_DDS_NO_FILTER;
+    sub->rate_limit = ESP_DDS_NO_RATE_LIMIT;
+    sub->group = ESP_DDS_NO_GROUP;
+    sub->key_set = ESP_DDS_NO_KEY_SET;
+    sub->wildcard = wildcard;
+    t->subscriber_count++;
+}
+
+static void remove_subscriber(esp_dds_topic_t* t, uint8_t i) {
+    for (uint8_t j = i; j < t->subscriber_count - 1; j++) {
+        t->subscribers[j] = t->subscribers[j + 1];
+    }
+    t->subscriber_count--;
+}
+
+static esp_dds_topic_t* find_or_create_topic(esp_dds_domain_t* d, const esp_dds_name_t* name) {
+    esp_dds_topic_t* t = find_topic(d, name);
+    if (!t) {
+        esp_dds_index_t index;
+        if (!alloc_slot(d->topic_slots, &d->free_topic, &d->topic_count,
+                        d->max_topics, &index)) {
+            return NULL;
+        }
+        uint16_t name_id = intern_name(d, name->str, name->length);
+        if (name_id == ESP_DDS_NO_NAME) {
+            free_slot(d->topic_slots, &d->free_topic, index);
+            return NULL;
+        }
+        d->topic_hashes[index] = name->hash;
+        d->topic_info[index].name_id = name_id;
+        t = &d->topics[index];
+        t->subscriber_count = 0;
+        
+        // Resolve wildcard subscriptions once, here, so publish stays a flat list walk
+        if (d->trie_root != ESP_DDS_TRIE_NONE) {
+            name_segments_t segs;
+            split_name(name->str, &segs);
+            uint32_t matched = match_trie(d, d->trie_root, &segs, 0);
+            for (uint8_t k = 0; k < ESP_DDS_MAX_WILDCARD_SUBS; k++) {
+                esp_dds_wildcard_sub_t* w = &d->wildcard_subs[k];
+                if ((matched & (1UL << k)) && pattern_matches(name_str(d, w->pattern_id), name->str)) {
+                    append_subscriber(d, t, w->callback, w->context, k);
                 }
-                t->subscriber_count--;
-                break;
             }
         }
     }
-    
-    give_mutex();
+    return t;
 }
 
-// Service implementation
-bool esp_dds_create_service(const char* service, esp_dds_service_cb_t callback,
-                           esp_dds_service_mode_t mode, void* context) {
-    if (!esp_dds_validate_name(service)) return false;
-    if (!service || !callback) return false;
-    if (!take_mutex(100)) return false;
-    
-    if (find_service(service) || dds_ctx.service_count >= ESP_DDS_MAX_SERVICES) {
-        give_mutex();
-        return false;
+static esp_dds_service_t* find_service(esp_dds_domain_t* d, const esp_dds_name_t* name) {
+    for (esp_dds_index_t i = 0; i < d->service_count; i++) {
+        if (name_equals(d, d->services[i].name_id, d->services[i].name_hash, name)) {
+            return &d->services[i];
+        }
     }
-    
-    esp_dds_service_t* s = &dds_ctx.services[dds_ctx.service_count];
-    strncpy(s->name, service, ESP_DDS_MAX_NAME_LENGTH - 1);
-    s->callback = callback;
-    s->mode = mode;
-    s->context = context;
-    dds_ctx.service_count++;
-    
-    give_mutex();
-    return true;
+    return NULL;
 }
 
-bool esp_dds_call_service_sync(const char* service, const void* request, size_t req_size,
-                              void* response, size_t* resp_size, uint32_t timeout_ms) {
-    if (!service || !request || !response || !resp_size || req_size > ESP_DDS_MAX_MESSAGE_SIZE) {
-        return false;
+static esp_dds_action_t* find_action(esp_dds_domain_t* d, const esp_dds_name_t* name) {
+    for (esp_dds_index_t i = 0; i < d->action_count; i++) {
+        if (name_equals(d, d->actions[i].name_id, d->actions[i].name_hash, name)) {
+            return &d->actions[i];
+        }
     }
+    return NULL;
+}
+
+// Content filter helpers
+static bool read_filter_field(const esp_dds_filter_cond_t* c, const void* data, size_t size,
+                              uint32_t* value) {
+    if ((size_t)c->offset + c->width > size) return false;
     
-    if (!take_mutex(100)) {
-        return false;
+    const uint8_t* field = (const uint8_t*)data + c->offset;
+    bool is_signed = (c->op & ESP_DDS_FILTER_SIGNED) != 0;
+    switch (c->width) {
+        case 1: {
+            uint8_t v = field[0];
+            *value = is_signed ? (uint32_t)(int32_t)(int8_t)v : v;
+            return true;
+        }
+        case 2: {
+            uint16_t v;
+            memcpy(&v, field, sizeof(v));
+            *value = is_signed ? (uint32_t)(int32_t)(int16_t)v : v;
+            return true;
+        }
+        case 4:
+            memcpy(value, field, sizeof(*value));
+            return true;
+        default:
+            return false;
     }
+}
+
+static bool evaluate_filter(esp_dds_filter_slot_t* slot, const void* data, size_t size) {
+    const esp_dds_filter_t* f = &slot->filter;
+    bool pass = true;
     
-    esp_dds_service_t* s = find_service(service);
-    
-    if (!s || !s->callback) {
-        give_mutex();
-        return false;
+    // No early exit: CHANGED conditions must track every sample
+    for (uint8_t i = 0; i < f->condition_count; i++) {
+        const esp_dds_filter_cond_t* c = &f->conditions[i];
+        uint32_t v;
+        if (!read_filter_field(c, data, size, &v)) {
+            pass = false;
+            continue;
+        }
+        
+        bool is_signed = (c->op & ESP_DDS_FILTER_SIGNED) != 0;
+        int32_t sv = (int32_t)v;
+        int32_t sref = (int32_t)c->value;
+        bool ok;
+        switch (c->op & ~ESP_DDS_FILTER_SIGNED) {
+            case ESP_DDS_FILTER_EQ: ok = v == c->value; break;
+            case ESP_DDS_FILTER_NE: ok = v != c->value; break;
+            case ESP_DDS_FILTER_LT: ok = is_signed ? sv < sref : v < c->value; break;
+            case ESP_DDS_FILTER_LE: ok = is_signed ? sv <= sref : v <= c->value; break;
+            case ESP_DDS_FILTER_GT: ok = is_signed ? sv > sref : v > c->value; break;
+            case ESP_DDS_FILTER_GE: ok = is_signed ? sv >= sref : v >= c->value; break;
+            case ESP_DDS_FILTER_MASK_ANY: ok = (v & c->value) != 0; break;
+            case ESP_DDS_FILTER_CHANGED:
+                ok = !slot->primed || v != slot->last_values[i];
+                slot->last_values[i] = v;
+                break;
+            default: ok = false; break;
+        }
+        pass = pass && ok;
     }
+    slot->primed = true;
     
-    // Cache the callback and context while we have the mutex
-    esp_dds_service_cb_t callback = s->callback;
-    void* context = s->context;
-    
-    // Release mutex before calling callback (callback might take time)
-    give_mutex();
-    
-    // Verify callback is still valid (extra safety check)
-    if (!callback) {
-        return false;
+    if (pass && f->predicate) {
+        pass = f->predicate(data, size, f->predicate_context);
     }
-    
-    // Execute callback in caller's thread
-    bool result = callback(request, req_size, response, resp_size, context);
-    
-    return result;
+    return pass;
 }
 
-bool esp_dds_call_service_async(const char* service, const void* request, size_t req_size,
-                               esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms) {
-    if (!service || !request || !callback || req_size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
-    if (!take_mutex(100)) return false;
+// Finds an identical filter on the same topic or claims a free slot
+static bool acquire_filter(esp_dds_domain_t* d, esp_dds_index_t topic_index, const esp_dds_filter_t* filter, uint8_t* id) {
+    // Normalize so unused conditions don't defeat deduplication
+    esp_dds_filter_t key;
+    memset(&key, 0, sizeof(key));
+    memcpy(key.conditions, filter->conditions,
+           filter->condition_count * sizeof(esp_dds_filter_cond_t));
+    key.condition_count = filter->condition_count;
+    key.predicate = filter->predicate;
+    key.predicate_context = filter->predicate_context;
     
-    esp_dds_service_t* s = find_service(service);
-    if (!s || !s->callback || dds_ctx.pending_count >= ESP_DDS_MAX_ACTIONS) {
-        give_mutex();
-        return false;
+    uint8_t free_slot = ESP_DDS_NO_FILTER;
+    for (uint8_t i = 0; i < ESP_DDS_MAX_FILTERS; i++) {
+        esp_dds_filter_slot_t* slot = &d->filters[i];
+        if (slot->refs == 0) {
+            if (free_slot == ESP_DDS_NO_FILTER) free_slot = i;
+        } else if (slot->topic_index == topic_index &&
+                   memcmp(&slot->filter, &key, sizeof(key)) == 0) {
+            slot->refs++;
+            *id = i;
+            return true;
+        }
     }
     
-    // Store pending request
-    esp_dds_pending_t* pending = &dds_ctx.pending[dds_ctx.pending_count];
-    strncpy(pending->target_name, service, ESP_DDS_MAX_NAME_LENGTH - 1);
-    pending->caller_task = xTaskGetCurrentTaskHandle();
-    pending->callback.async_cb = callback;
-    pending->context = context;
-    pending->is_action = false;
-    pending->response_ready = false;
-    
-    // Execute service immediately (in current thread)
-    uint8_t temp_response[ESP_DDS_MAX_MESSAGE_SIZE];
-    size_t temp_size = sizeof(temp_response);
-    bool success = s->callback(request, req_size, temp_response, &temp_size, s->context);
+    if (free_slot == ESP_DDS_NO_FILTER) return false;
     
-    if (success) {
-        memcpy(pending->response_data, temp_response, temp_size);
-        pending->response_size = temp_size;
-        pending->response_ready = true;
-        dds_ctx.pending_count++;
+    esp_dds_filter_slot_t* slot = &d->filters[free_slot];
+    memset(slot, 0, sizeof(*slot));
+    memcpy(&slot->filter, &key, sizeof(key));
+    slot->topic_index = topic_index;
+    slot->refs = 1;
+    *id = free_slot;
+    return true;
+}
+
+static void release_filter(esp_dds_domain_t* d, uint8_t id) {
+    if (id != ESP_DDS_NO_FILTER && d->filters[id].refs > 0) {
+        d->filters[id].refs--;
     }
-    
-    give_mutex();
-    return success;
 }
 
-// Action implementation
-bool esp_dds_create_action(const char* action, esp_dds_goal_cb_t goal_cb,
-                          esp_dds_execute_cb_t execute_cb, esp_dds_cancel_cb_t cancel_cb,
-                          void* context) {
-    if (!esp_dds_validate_name(action)) return false;
-    if (!action || !goal_cb || !execute_cb) return false;
-    if (!take_mutex(100)) return false;
-    
-    if (find_action(action) || dds_ctx.action_count >= ESP_DDS_MAX_ACTIONS) {
-        give_mutex();
-        return false;
+// Keyed topic helpers
+static bool read_key(const esp_dds_domain_t* d, esp_dds_index_t topic_index, const void* data, size_t size,
+                     uint32_t* key) {
+    esp_dds_filter_cond_t field = { d->topic_info[topic_index].key_offset, d->topics[topic_index].key_width,
+                                    ESP_DDS_FILTER_EQ, 0 };
+    return read_filter_field(&field, data, size, key);
+}
+
+// Keeps the sample as the latest of its key, new keys are linked at the head of the
+// topic's instance list. Returns false when the instance pool is full.
+static bool store_instance(esp_dds_domain_t* d, esp_dds_index_t topic_index, uint32_t key,
+                           const void* data, size_t size, uint32_t now) {
+    esp_dds_topic_info_t* info = &d->topic_info[topic_index];
+    uint8_t id = info->first_instance;
+    while (id != ESP_DDS_NO_INSTANCE && d->instances[id].key != key) {
+        id = d->instances[id].next;
     }
     
-    esp_dds_action_t* a = &dds_ctx.actions[dds_ctx.action_count];
-    strncpy(a->name, action, ESP_DDS_MAX_NAME_LENGTH - 1);
-    a->goal_callback = goal_cb;
-    a->execute_callback = execute_cb;
-    a->cancel_callback = cancel_cb;
-    a->context = context;
-    a->state = ESP_DDS_ACTION_ACCEPTED;
-    a->active = false;
-    a->cancel_requested = false;
-    dds_ctx.action_count++;
+    if (id == ESP_DDS_NO_INSTANCE) {
+        for (uint8_t i = 0; i < ESP_DDS_MAX_INSTANCES; i++) {
+            if (!d->instances[i].in_use) {
+                id = i;
+                break;
+            }
+        }
+        if (id == ESP_DDS_NO_INSTANCE) return false;
+        
+        esp_dds_instance_t* inst = &d->instances[id];
+        inst->key = key;
+        inst->topic_index = topic_index;
+        inst->next = info->first_instance;
+        inst->in_use = true;
+        info->first_instance = id;
+    }
     
-    give_mutex();
+    esp_dds_instance_t* inst = &d->instances[id];
+    memcpy(inst->data, data, size);
+    inst->size = size;
+    inst->publish_us = now;
     return true;
 }
 
-bool esp_dds_send_goal(const char* action, const void* goal, size_t goal_size,
-                      esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
-                      void* context, uint32_t timeout_ms) {
-    if (!action || !goal || goal_size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
-    if (!take_mutex(100)) return false;
-    
-    esp_dds_action_t* a = find_action(action);
-    if (!a || a->active || !a->goal_callback) {
-        give_mutex();
-        return false;
+static bool key_set_contains(const esp_dds_key_set_t* set, uint32_t key) {
+    for (uint8_t i = 0; i < set->count; i++) {
+        if (set->keys[i] == key) return true;
     }
-    
-    // Check if goal is accepted
-    if (!a->goal_callback(goal, goal_size, a->context)) {
-        give_mutex();
-        return false;
+    return false;
+}
+
+static uint8_t acquire_key_set(esp_dds_domain_t* d, const uint32_t* keys, uint8_t count) {
+    for (uint8_t i = 0; i < ESP_DDS_MAX_KEY_SETS; i++) {
+        esp_dds_key_set_t* set = &d->key_sets[i];
+        if (!set->in_use) {
+            memcpy(set->keys, keys, count * sizeof(uint32_t));
+            set->count = count;
+            set->in_use = true;
+            return i;
+        }
     }
-    
-    // Store goal and client info
-    memcpy(a->goal_data, goal, goal_size);
-    a->goal_size = goal_size;
-    a->active = true;
-    a->state = ESP_DDS_ACTION_ACCEPTED;
-    a->cancel_requested = false;
-    
-    // Create pending result tracker
-    if (dds_ctx.pending_count < ESP_DDS_MAX_ACTIONS) {
-        esp_dds_pending_t* pending = &dds_ctx.pending[dds_ctx.pending_count];
-        strncpy(pending->target_name, action, ESP_DDS_MAX_NAME_LENGTH - 1);
-        pending->caller_task = xTaskGetCurrentTaskHandle();
-        pending->callback.result_cb = result_cb;
-        pending->context = context;
-        pending->is_action = true;
-        pending->response_ready = false;
-        dds_ctx.pending_count++;
+    return ESP_DDS_NO_KEY_SET;
+}
+
+static void release_key_set(esp_dds_domain_t* d, uint8_t id) {
+    if (id != ESP_DDS_NO_KEY_SET) {
+        d->key_sets[id].in_use = false;
+    }
+}
+
+// Timer wheel helpers - node (topic_index * 2 + kind) monitors one QoS of one topic
+#define WHEEL_KIND_DEADLINE 0
+#define WHEEL_KIND_LIVELINESS 1
+#define WHEEL_MASK (ESP_DDS_TIMER_WHEEL_SLOTS - 1)
+#define WHEEL_SPAN (1UL << (ESP_DDS_TIMER_WHEEL_BITS * ESP_DDS_TIMER_WHEEL_LEVELS))
+// Ticks wrap with the 32-bit microsecond clock, so tick arithmetic is modulo 2^22
+#define WHEEL_TICK_MASK ((1UL << (32 - ESP_DDS_TIMER_TICK_SHIFT)) - 1)
+
+static void wheel_init(esp_dds_timer_wheel_t* w, uint16_t node_count) {
+    memset(w->nodes, 0, node_count * sizeof(esp_dds_timer_node_t));
+    for (uint16_t i = 0; i < DDS_ARRAY_SIZE(w->slots); i++) {
+        w->slots[i] = ESP_DDS_TIMER_NONE;
     }
+    w->last_tick = DDS_MICROS() >> ESP_DDS_TIMER_TICK_SHIFT;
+}
+
+static void wheel_remove(esp_dds_timer_wheel_t* w, uint16_t id) {
+    esp_dds_timer_node_t* n = &w->nodes[id];
+    if (!n->armed) return;
     
-    give_mutex();
-    return true;
+    if (n->prev == ESP_DDS_TIMER_NONE) {
+        w->slots[n->slot] = n->next;
+    } else {
+        w->nodes[n->prev].next = n->next;
+    }
+    if (n->next != ESP_DDS_TIMER_NONE) {
+        w->nodes[n->next].prev = n->prev;
+    }
+    n->armed = false;
 }
 
-bool esp_dds_cancel_goal(const char* action, uint32_t timeout_ms) {
-    if (!take_mutex(100)) return false;
+// Level 0 holds the next 64 ticks, level n the slots 64^n ticks wide beyond that.
+// Expiries past the top level park in its farthest slot and are placed again when
+// that slot cascades.
+static void wheel_insert(esp_dds_timer_wheel_t* w, uint16_t id, uint32_t expiry_us) {
+    esp_dds_timer_node_t* n = &w->nodes[id];
+    wheel_remove(w, id);
     
-    esp_dds_action_t* a = find_action(action);
-    if (!a || !a->active) {
-        give_mutex();
-        return false;
+    // Expiries that already passed go into the current slot so the next check sees them,
+    // keeping their time for the lateness reported
+    uint32_t tick = expiry_us >> ESP_DDS_TIMER_TICK_SHIFT;
+    if ((int32_t)(expiry_us - (w->last_tick << ESP_DDS_TIMER_TICK_SHIFT)) < 0) {
+        tick = w->last_tick;
+    }
+    uint32_t delta = (tick - w->last_tick) & WHEEL_TICK_MASK;
+    if (delta >= WHEEL_SPAN) {
+        tick = (w->last_tick + WHEEL_SPAN - 1) & WHEEL_TICK_MASK;
+        delta = WHEEL_SPAN - 1;
     }
     
-    a->cancel_requested = true;
-    if (a->cancel_callback) {
-        a->cancel_callback(a->context);
+    uint8_t level = 0;
+    while (delta >> (ESP_DDS_TIMER_WHEEL_BITS * (level + 1))) {
+        level++;
     }
+    uint8_t slot = (uint8_t)(level * ESP_DDS_TIMER_WHEEL_SLOTS +
+                             ((tick >> (ESP_DDS_TIMER_WHEEL_BITS * level)) & WHEEL_MASK));
     
-    give_mutex();
-    return true;
+    n->expiry_us = expiry_us;
+    n->slot = slot;
+    n->prev = ESP_DDS_TIMER_NONE;
+    n->next = w->slots[slot];
+    if (n->next != ESP_DDS_TIMER_NONE) {
+        w->nodes[n->next].prev = id;
+    }
+    n->armed = true;
+    w->slots[slot] = id;
 }
 
-bool esp_dds_send_feedback(const char* action, const void* feedback, size_t size) {
-    if (!action || !feedback || size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
-    if (!take_mutex(100)) return false;
+// Moves every node of a higher level slot down to where it now belongs
+static void wheel_cascade(esp_dds_timer_wheel_t* w, uint8_t slot) {
+    uint16_t id = w->slots[slot];
+    w->slots[slot] = ESP_DDS_TIMER_NONE;
+    while (id != ESP_DDS_TIMER_NONE) {
+        uint16_t next = w->nodes[id].next;
+        w->nodes[id].armed = false;
+        wheel_insert(w, id, w->nodes[id].expiry_us);
+        id = next;
+    }
+}
+
+// Unlinks everything due by now and returns it as a list. Work per tick is constant
+// except for cascades, which touch each node at most once per level.
+static uint16_t wheel_expire(esp_dds_timer_wheel_t* w, uint32_t now) {
+    uint32_t now_tick = now >> ESP_DDS_TIMER_TICK_SHIFT;
+    uint16_t expired = ESP_DDS_TIMER_NONE;
     
-    // Find pending action and deliver feedback
-    for (uint8_t i = 0; i < dds_ctx.pending_count; i++) {
-        esp_dds_pending_t* p = &dds_ctx.pending[i];
-        if (p->is_action && strcmp(p->target_name, action) == 0 && p->callback.feedback_cb) {
-            // Execute feedback callback in caller's thread context
-            p->callback.feedback_cb(action, feedback, size, p->context);
-            break;
+    // After a stall longer than the wheel span every slot is stale - re-place all nodes
+    if (((now_tick - w->last_tick) & WHEEL_TICK_MASK) >= WHEEL_SPAN) {
+        w->last_tick = now_tick;
+        for (uint8_t slot = 0; slot < DDS_ARRAY_SIZE(w->slots); slot++) {
+            wheel_cascade(w, slot);
         }
     }
     
-    give_mutex();
-    return true;
+    while (true) {
+        uint16_t id = w->slots[w->last_tick & WHEEL_MASK];
+        while (id != ESP_DDS_TIMER_NONE) {
+            esp_dds_timer_node_t* n = &w->nodes[id];
+            uint16_t next = n->next;
+            if ((int32_t)(now - n->expiry_us) >= 0) {
+                wheel_remove(w, id);
+                n->next = expired;
+                expired = id;
+            }
+            id = next;
+        }
+        if (w->last_tick == now_tick) break;
+        
+        w->last_tick = (w->last_tick + 1) & WHEEL_TICK_MASK;
+        for (uint8_t level = ESP_DDS_TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+            uint32_t shift = ESP_DDS_TIMER_WHEEL_BITS * level;
+            if ((w->last_tick & ((1UL << shift) - 1)) == 0) {
+                wheel_cascade(w, (uint8_t)(level * ESP_DDS_TIMER_WHEEL_SLOTS +
+                                           ((w->last_tick >> shift) & WHEEL_MASK)));
+            }
+        }
+    }
+    return expired;
 }
 
-// Processing functions
-void esp_dds_process_services(void) {
-    // Services are processed immediately in caller's thread
-    // No background processing needed for this simple design
+// Rate limit helpers - wheel node RATE_NODE_BASE + index flushes keep-latest samples
+#define RATE_NODE_BASE(d) ((uint16_t)((d)->max_topics * 2))
+#define TIMER_NODE_BASE(d) ((uint16_t)(RATE_NODE_BASE(d) + ESP_DDS_MAX_RATE_LIMITS))
+
+static bool acquire_rate_limit(esp_dds_domain_t* d, esp_dds_index_t topic_index, uint32_t min_separation_us, bool keep_latest,
+                               uint8_t* id) {
+    uint8_t held = ESP_DDS_NO_RATE_LIMIT;
+    if (keep_latest) {
+        for (uint8_t i = 0; i < ESP_DDS_MAX_HELD_SAMPLES; i++) {
+            if (!d->held_samples[i].in_use) {
+                held = i;
+                break;
+            }
+        }
+        if (held == ESP_DDS_NO_RATE_LIMIT) return false;
+    }
+    
+    for (uint8_t i = 0; i < ESP_DDS_MAX_RATE_LIMITS; i++) {
+        esp_dds_rate_limit_t* rl = &d->rate_limits[i];
+        if (rl->in_use) continue;
+        
+        // Backdate the last delivery so the first sample passes immediately
+        rl->min_separation_us = min_separation_us;
+        rl->last_delivery_us = DDS_MICROS() - min_separation_us;
+        rl->topic_index = topic_index;
+        rl->held = held;
+        rl->in_use = true;
+        if (held != ESP_DDS_NO_RATE_LIMIT) {
+            d->held_samples[held].in_use = true;
+            d->held_samples[held].pending = false;
+        }
+        *id = i;
+        return true;
+    }
+    return false;
 }
 
-void esp_dds_process_actions(void) {
-    if (!take_mutex(10)) return;
+static void release_rate_limit(esp_dds_domain_t* d, uint8_t id) {
+    if (id == ESP_DDS_NO_RATE_LIMIT) return;
     
-    // Collect active actions quickly (just data copying)
-    esp_dds_action_t active_actions[ESP_DDS_MAX_ACTIONS];
-    uint8_t active_count = 0;
+    esp_dds_rate_limit_t* rl = &d->rate_limits[id];
+    if (rl->held != ESP_DDS_NO_RATE_LIMIT) {
+        d->held_samples[rl->held].in_use = false;
+        d->held_samples[rl->held].pending = false;
+    }
+    wheel_remove(&d->wheel, RATE_NODE_BASE(d) + id);
+    rl->in_use = false;
+}
+
+// Returns true if the sample may be delivered now, otherwise keeps it if requested
+static bool rate_limit_admit(esp_dds_domain_t* d, uint8_t id, const void* data, size_t size, uint32_t now) {
+    esp_dds_rate_limit_t* rl = &d->rate_limits[id];
     
-    for (uint8_t i = 0; i < dds_ctx.action_count; i++) {
-        esp_dds_action_t* a = &dds_ctx.actions[i];
-        if (a->active && (a->state == ESP_DDS_ACTION_ACCEPTED || a->state == ESP_DDS_ACTION_EXECUTING)) {
-            // Copy only what we need for execution
-            memcpy(&active_actions[active_count], a, sizeof(esp_dds_action_t));
-            active_count++;
-            if (active_count >= ESP_DDS_MAX_ACTIONS) break;
+    if (now - rl->last_delivery_us >= rl->min_separation_us) {
+        rl->last_delivery_us = now;
+        if (rl->held != ESP_DDS_NO_RATE_LIMIT && d->held_samples[rl->held].pending) {
+            d->held_samples[rl->held].pending = false;
+            wheel_remove(&d->wheel, RATE_NODE_BASE(d) + id);
         }
+        return true;
     }
     
-    give_mutex();  // RELEASE MUTEX BEFORE CALLBACKS!
+    if (rl->held != ESP_DDS_NO_RATE_LIMIT && size <= ESP_DDS_MAX_MESSAGE_SIZE) {
+        esp_dds_held_sample_t* h = &d->held_samples[rl->held];
+        memcpy(h->data, data, size);
+        h->size = size;
+        if (!h->pending) {
+            h->pending = true;
+            wheel_insert(&d->wheel, RATE_NODE_BASE(d) + id, rl->last_delivery_us + rl->min_separation_us);
+        }
+    }
+    return false;
+}
+
+// Callback groups - a mutually exclusive group is busy while one of its callbacks runs.
+// Claiming runs under the mutex, release is a single store by the claiming thread.
+static bool claim_group(esp_dds_domain_t* d, uint8_t group) {
+    esp_dds_callback_group_t* g = &d->groups[group];
+    if (g->type == ESP_DDS_GROUP_REENTRANT) return true;
+    if (g->busy) return false;
+    g->busy = true;
+    return true;
+}
+
+static void release_group(esp_dds_domain_t* d, uint8_t group) {
+    d->groups[group].busy = false;
+}
+
+static bool wait_for_group(esp_dds_domain_t* d, uint8_t group, uint32_t timeout_ms) {
+    uint32_t start = DDS_MILLIS();
+    while (true) {
+        if (!take_mutex(d, timeout_ms)) return false;
+        bool claimed = claim_group(d, group);
+        give_mutex(d);
+        if (claimed) return true;
+        if (DDS_MILLIS() - start >= timeout_ms) return false;
+        DDS_TASK_DELAY(1);
+    }
+}
+
+// Executor work queue - FIFO, compacted on removal like the pending list. Runs under the mutex.
+static esp_dds_work_item_t* enqueue_work(esp_dds_domain_t* d, uint8_t group, const void* data, size_t size) {
+    if (d->work_count >= ESP_DDS_MAX_QUEUED_WORK || size > ESP_DDS_MAX_MESSAGE_SIZE) return NULL;
     
-    // Execute callbacks WITHOUT holding mutex
-    for (uint8_t i = 0; i < active_count; i++) {
-        esp_dds_action_t* a = &active_actions[i];
-        
-        uint8_t result[ESP_DDS_MAX_MESSAGE_SIZE];
-        size_t result_size = sizeof(result);
-        
-        esp_dds_action_state_t state = a->execute_callback(
-            a->goal_data, a->goal_size, result, &result_size, a->context);
-        
-        // Re-acquire mutex briefly to update state
-        if (take_mutex(100)) {
-            esp_dds_action_t* current_a = find_action(a->name);
-            if (current_a && current_a->active) {
-                current_a->state = state;
-                if (state != ESP_DDS_ACTION_EXECUTING) {
-                    current_a->active = false;
-                    // Store result for delivery...
-                }
+    esp_dds_work_item_t* w = &d->work[d->work_count++];
+    w->group = group;
+    w->size = size;
+    memcpy(w->data, data, size);
+    return w;
+}
+
+// WaitSet helpers - bits are set under the domain mutex and cleared by the waiting task
+static void waitset_signal(esp_dds_waitset_t* ws, uint32_t bits) {
+#ifdef ESP_PLATFORM
+    xEventGroupSetBits(ws->events, bits);
+#elif defined(DDS_HOST)
+    pthread_mutex_lock(&ws->lock);
+    ws->triggered |= bits;
+    pthread_cond_broadcast(&ws->cond);
+    pthread_mutex_unlock(&ws->lock);
+#else
+    __atomic_or_fetch(&ws->triggered, bits, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void waitset_clear(esp_dds_waitset_t* ws, uint32_t bits) {
+#ifdef ESP_PLATFORM
+    xEventGroupClearBits(ws->events, bits);
+#elif defined(DDS_HOST)
+    pthread_mutex_lock(&ws->lock);
+    ws->triggered &= ~bits;
+    pthread_mutex_unlock(&ws->lock);
+#else
+    __atomic_and_fetch(&ws->triggered, ~bits, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Wakes waitsets waiting for a response or result of the named target. Runs under the mutex,
+// costs one pointer check while no waitset exists.
+static void notify_waitsets(esp_dds_domain_t* d, uint8_t kind, uint16_t name_id) {
+    for (esp_dds_waitset_t* ws = d->waitsets; ws; ws = ws->next) {
+        uint32_t bits = 0;
+        for (uint8_t i = 0; i < ESP_DDS_MAX_WAIT_CONDITIONS; i++) {
+            const esp_dds_condition_t* c = &ws->conditions[i];
+            if (c->in_use && c->kind == kind && c->name_id == name_id) {
+                bits |= 1UL << i;
             }
-            give_mutex();
+        }
+        if (bits) {
+            waitset_signal(ws, bits);
         }
     }
 }
 
-void esp_dds_process_pending(uint32_t timeout_ms) {
-    if (!take_mutex(10)) return;
+// Subscriber callback of a read condition - keeps the latest sample, runs under the mutex
+static void waitset_sample(const char* topic, const void* data, size_t size, void* context) {
+    esp_dds_condition_t* c = (esp_dds_condition_t*)context;
+    if (size > ESP_DDS_MAX_MESSAGE_SIZE) return;
+    memcpy(c->data, data, size);
+    c->size = size;
+    c->has_sample = true;
+    waitset_signal(c->waitset, 1UL << (c - c->waitset->conditions));
+}
+
+// Calls the subscriber in this thread, or queues the sample for its executor
+static bool deliver_sample(esp_dds_domain_t* d, const esp_dds_subscriber_t* sub, const char* topic,
+                           esp_dds_index_t topic_index, const void* data, size_t size) {
+    if (sub->group == ESP_DDS_NO_GROUP) {
+        sub->callback(topic, data, size, sub->context);
+        return true;
+    }
     
-    TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+    esp_dds_work_item_t* w = enqueue_work(d, sub->group, data, size);
+    if (!w) return false;
+    w->callback.sample = sub->callback;
+    w->context = sub->context;
+    w->name_id = d->topic_info[topic_index].name_id;  // Stays valid if the topic is collected
+    w->kind = ESP_DDS_WORK_SAMPLE;
+    return true;
+}
+
+static bool add_subscriber(esp_dds_domain_t* d, const esp_dds_name_t* topic, esp_dds_topic_cb_t callback, void* context,
+                           const esp_dds_filter_t* filter, uint32_t min_separation_us,
+                           bool keep_latest, uint8_t group) {
+    // Create topic if it doesn't exist
+    esp_dds_topic_t* t = find_or_create_topic(d, topic);
+    if (!t || t->subscriber_count >= d->max_subscribers) {
+        return false;
+    }
     
-    for (uint8_t i = 0; i < dds_ctx.pending_count; i++) {
-        esp_dds_pending_t* p = &dds_ctx.pending[i];
-        
-        if (p->response_ready && p->caller_task == current_task) {
-            // Execute callback in caller's thread context
-            if (p->is_action && p->callback.result_cb) {
-                p->callback.result_cb(p->target_name, p->response_data, 
-                                    p->response_size, p->action_state, p->context);
-            } else if (!p->is_action && p->callback.async_cb) {
-                p->callback.async_cb(p->target_name, p->response_data,
-                                   p->response_size, p->context);
+    esp_dds_index_t topic_index = (esp_dds_index_t)(t - d->topics);
+    uint8_t filter_id = ESP_DDS_NO_FILTER;
+    if (filter && !acquire_filter(d, topic_index, filter, &filter_id)) {
+        return false;
+    }
+    
+    uint8_t rate_id = ESP_DDS_NO_RATE_LIMIT;
+    if (min_separation_us && !acquire_rate_limit(d, topic_index, min_separation_us, keep_latest, &rate_id)) {
+        release_filter(d, filter_id);
+        return false;
+    }
+    
+    esp_dds_subscriber_t* sub = &t->subscribers[t->subscriber_count];
+    sub->callback = callback;
+    sub->context = context;
+    sub->filter = filter_id;
+    sub->rate_limit = rate_id;
+    sub->group = group;
+    sub->key_set = ESP_DDS_NO_KEY_SET;
+    sub->wildcard = ESP_DDS_NO_WILDCARD;
+    t->subscriber_count++;
+    return true;
+}
+
+// Delivers a held keep-latest sample once its window opened. Runs under the mutex
+// like delivery from esp_dds_publish.
+static void flush_held_sample(esp_dds_domain_t* d, uint8_t id, uint32_t now) {
+    esp_dds_rate_limit_t* rl = &d->rate_limits[id];
+    if (!rl->in_use || rl->held == ESP_DDS_NO_RATE_LIMIT) return;
+    
+    esp_dds_held_sample_t* h = &d->held_samples[rl->held];
+    if (!h->pending) return;
+    h->pending = false;
+    rl->last_delivery_us = now;
+    
+    esp_dds_topic_t* t = &d->topics[rl->topic_index];
+    for (uint8_t i = 0; i < t->subscriber_count; i++) {
+        esp_dds_subscriber_t* sub = &t->subscribers[i];
+        if (sub->rate_limit == id && sub->callback) {
+            deliver_sample(d, sub, name_str(d, d->topic_info[rl->topic_index].name_id), rl->topic_index,
+                           h->data, h->size);
+            break;
+        }
+    }
+}
+
+// Clears all state of a domain, keeping its storage pointers, limits and mutex
+static void clear_domain(esp_dds_domain_t* d) {
+    memset(d->topic_hashes, 0, d->max_topics * sizeof(uint32_t));
+    memset(d->topics, 0, d->max_topics * sizeof(esp_dds_topic_t));
+    memset(d->subscribers, 0, (size_t)d->max_topics * d->max_subscribers * sizeof(esp_dds_subscriber_t));
+    for (esp_dds_index_t i = 0; i < d->max_topics; i++) {
+        d->topics[i].subscribers = &d->subscribers[(size_t)i * d->max_subscribers];
+    }
+    memset(d->topic_info, 0, d->max_topics * sizeof(esp_dds_topic_info_t));
+    memset(d->services, 0, d->max_services * sizeof(esp_dds_service_t));
+    memset(d->actions, 0, d->max_actions * sizeof(esp_dds_action_t));
+    memset(d->pending, 0, d->max_pending * sizeof(esp_dds_pending_t));
+    d->names.used = 0;
+    reset_slots(d);
+    memset(d->filters, 0, sizeof(d->filters));
+    memset(d->rate_limits, 0, sizeof(d->rate_limits));
+    memset(d->held_samples, 0, sizeof(d->held_samples));
+    memset(d->trie_nodes, 0, sizeof(d->trie_nodes));
+    memset(d->wildcard_subs, 0, sizeof(d->wildcard_subs));
+    d->trie_root = ESP_DDS_TRIE_NONE;
+    memset(d->instances, 0, sizeof(d->instances));
+    memset(d->key_sets, 0, sizeof(d->key_sets));
+    memset(d->executors, 0, sizeof(d->executors));  // Worker tasks already exited, see reset
+    memset(d->groups, 0, sizeof(d->groups));
+    d->work_count = 0;
+    d->remote_window = ESP_DDS_REMOTE_WINDOW;
+    d->next_sequence = 0;
+    for (esp_dds_waitset_t* ws = d->waitsets; ws; ws = ws->next) {
+        memset(ws->conditions, 0, sizeof(ws->conditions));  // Waitsets stay linked and usable
+    }
+    memset(d->timers, 0, d->max_timers * sizeof(esp_dds_timer_t));
+    wheel_init(&d->wheel, TIMER_NODE_BASE(d) + d->max_timers);
+    
+    d->topic_count = 0;
+    d->service_count = 0;
+    d->action_count = 0;
+    d->pending_count = 0;
+}
+
+// Public API implementation
+esp_dds_domain_t* esp_dds_default_domain(void) {
+    return &default_domain;
+}
+
+void esp_dds_domain_init(esp_dds_domain_t* d) {
+    clear_domain(d);
+    
+#ifdef ESP_PLATFORM
+    if (!d->mutex) {
+        d->mutex = xSemaphoreCreateMutex();
+    }
+#endif
+    
+    d->running = true;
+}
+
+void esp_dds_domain_reset(esp_dds_domain_t* d) {
+    // Workers take the mutex to spin, so they are stopped before it is held
+    for (uint8_t i = 0; i < ESP_DDS_MAX_EXECUTORS; i++) {
+        if (d->executors[i].in_use) {
+            esp_dds_domain_executor_stop(d, i);
+        }
+    }
+    
+    if (!take_mutex(d, 1000)) return;
+    
+    d->running = false;
+    clear_domain(d);
+    d->running = true;
+    
+    give_mutex(d);
+}
+
+// Topic implementation
+bool esp_dds_domain_publish(esp_dds_domain_t* d, const char* topic, const void* data, size_t size) {
+    return esp_dds_domain_publish_name(d, esp_dds_make_name(topic), data, size);
+}
+
+// Hands a sample of a network-visible topic to every transport but the one it came
+// from. Transport failures count as drops, they never fail the local publish.
+static void forward_sample(esp_dds_domain_t* d, esp_dds_index_t topic_index, const char* topic,
+                           const void* data, size_t size, uint32_t now, esp_dds_transport_t* source) {
+    for (esp_dds_transport_t* tr = d->transports; tr; tr = tr->next) {
+        if (tr == source) continue;
+        if (tr->ops->send(tr, topic, d->topic_hashes[topic_index], data, size, now)) {
+            tr->sent++;
+        } else {
+            tr->dropped++;
+        }
+    }
+}
+
+// Delivers one sample to the subscribers of a topic, then to the transports if the topic
+// is network visible. Runs under the mutex.
+static bool publish_topic(esp_dds_domain_t* d, esp_dds_topic_t* t, const char* topic, const void* data, size_t size,
+                          uint32_t now, esp_dds_transport_t* source) {
+    esp_dds_index_t topic_index = (esp_dds_index_t)(t - d->topics);
+    
+    // A keyed sample updates its instance, the key is read once for all subscribers
+    uint32_t key = 0;
+    bool cached = true;
+    if (t->key_width) {
+        if (size > ESP_DDS_MAX_INSTANCE_SIZE || !read_key(d, topic_index, data, size, &key)) return false;
+        cached = store_instance(d, topic_index, key, data, size, now);
+    }
+    t->last_publish_us = now;
+    
+    // Deliver to subscribers immediately (in publisher's thread), grouped ones through
+    // their executor. Each distinct filter is evaluated at most once per sample.
+    bool queued = true;
+    uint32_t evaluated = 0;
+    uint32_t accepted = 0;
+    for (uint8_t i = 0; i < t->subscriber_count; i++) {
+        const esp_dds_subscriber_t* sub = &t->subscribers[i];
+        if (sub->key_set != ESP_DDS_NO_KEY_SET && !key_set_contains(&d->key_sets[sub->key_set], key)) {
+            continue;
+        }
+        uint8_t f = sub->filter;
+        if (f != ESP_DDS_NO_FILTER) {
+            uint32_t bit = 1UL << f;
+            if (!(evaluated & bit)) {
+                evaluated |= bit;
+                if (evaluate_filter(&d->filters[f], data, size)) accepted |= bit;
             }
-            
-            // Remove from pending list
-            for (uint8_t j = i; j < dds_ctx.pending_count - 1; j++) {
-                dds_ctx.pending[j] = dds_ctx.pending[j + 1];
+            if (!(accepted & bit)) continue;
+        }
+        if (sub->rate_limit != ESP_DDS_NO_RATE_LIMIT &&
+            !rate_limit_admit(d, sub->rate_limit, data, size, t->last_publish_us)) {
+            continue;
+        }
+        if (sub->callback) {
+            queued &= deliver_sample(d, sub, topic, topic_index, data, size);
+        }
+    }
+    if (t->network) {
+        forward_sample(d, topic_index, topic, data, size, now, source);
+    }
+    return queued && cached;
+}
+
+static bool publish_locked(esp_dds_domain_t* d, const esp_dds_name_t* topic, const void* data, size_t size,
+                           uint32_t now) {
+    // Auto-create topic on first publish
+    esp_dds_topic_t* t = find_or_create_topic(d, topic);
+    return t && publish_topic(d, t, topic->str, data, size, now, NULL);
+}
+
+// Ends one publish call on the transports, samples sent since the last flush may
+// share a frame
+static void flush_transports(esp_dds_domain_t* d) {
+    for (esp_dds_transport_t* tr = d->transports; tr; tr = tr->next) {
+        if (tr->ops->flush) tr->ops->flush(tr);
+    }
+}
+
+bool esp_dds_domain_publish_name(esp_dds_domain_t* d, esp_dds_name_t topic, const void* data, size_t size) {
+    if (!topic.length) return false;
+    if (!data || size > ESP_DDS_MAX_SAMPLE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    bool queued = publish_locked(d, &topic, data, size, DDS_MICROS());
+    if (d->transports) flush_transports(d);
+    
+    give_mutex(d);
+    return queued;
+}
+
+// Validates every entry first, so an invalid batch publishes nothing. Then one lock and one
+// timestamp cover all samples, delivered in entry order.
+bool esp_dds_domain_publish_batch(esp_dds_domain_t* d, const esp_dds_batch_entry_t* entries, size_t count) {
+    if (!entries || !count) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (!entries[i].topic.length || !entries[i].data || entries[i].size > ESP_DDS_MAX_SAMPLE_SIZE) {
+            return false;
+        }
+    }
+    if (!take_mutex(d, 100)) return false;
+    
+    bool queued = true;
+    uint32_t now = DDS_MICROS();
+    for (size_t i = 0; i < count; i++) {
+        queued &= publish_locked(d, &entries[i].topic, entries[i].data, entries[i].size, now);
+    }
+    if (d->transports) flush_transports(d);
+    
+    give_mutex(d);
+    return queued;
+}
+
+// Binds an unbound topic to the type, true if it is bound to it now. Runs under the mutex.
+static bool bind_type(esp_dds_domain_t* d, const esp_dds_topic_t* t, uint32_t type_hash) {
+    esp_dds_topic_info_t* info = &d->topic_info[t - d->topics];
+    if (!info->type_hash) info->type_hash = type_hash;
+    return info->type_hash == type_hash;
+}
+
+bool esp_dds_domain_publish_typed(esp_dds_domain_t* d, esp_dds_name_t topic, uint32_t type_hash,
+                                  const void* data, size_t size) {
+    if (!topic.length || !type_hash) return false;
+    if (!data || size > ESP_DDS_MAX_SAMPLE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_or_create_topic(d, &topic);
+    bool queued = t && bind_type(d, t, type_hash) && publish_topic(d, t, topic.str, data, size, DDS_MICROS(), NULL);
+    if (d->transports) flush_transports(d);
+    
+    give_mutex(d);
+    return queued;
+}
+
+bool esp_dds_domain_subscribe(esp_dds_domain_t* d, const char* topic, esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_filtered(d, topic, NULL, callback, context);
+}
+
+bool esp_dds_domain_subscribe_name(esp_dds_domain_t* d, esp_dds_name_t topic, esp_dds_topic_cb_t callback, void* context) {
+    if (!topic.length || !callback) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    bool ok = add_subscriber(d, &topic, callback, context, NULL, 0, false, ESP_DDS_NO_GROUP);
+    
+    give_mutex(d);
+    return ok;
+}
+
+bool esp_dds_domain_subscribe_typed(esp_dds_domain_t* d, esp_dds_name_t topic, uint32_t type_hash,
+                                    esp_dds_topic_cb_t callback, void* context) {
+    if (!topic.length || !type_hash || !callback) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_or_create_topic(d, &topic);
+    bool ok = t && bind_type(d, t, type_hash) &&
+              add_subscriber(d, &topic, callback, context, NULL, 0, false, ESP_DDS_NO_GROUP);
+    
+    give_mutex(d);
+    return ok;
+}
+
+bool esp_dds_domain_subscribe_filtered(esp_dds_domain_t* d, const char* topic, const esp_dds_filter_t* filter,
+                               esp_dds_topic_cb_t callback, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length || !callback) return false;
+    if (filter && filter->condition_count > ESP_DDS_MAX_FILTER_CONDITIONS) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    bool ok = add_subscriber(d, &name, callback, context, filter, 0, false, ESP_DDS_NO_GROUP);
+    
+    give_mutex(d);
+    return ok;
+}
+
+bool esp_dds_domain_subscribe_rate_limited(esp_dds_domain_t* d, const char* topic, uint32_t min_separation_us, bool keep_latest,
+                                   esp_dds_topic_cb_t callback, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length || !callback || min_separation_us == 0 || min_separation_us > 0x7FFFFFFFUL) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    bool ok = add_subscriber(d, &name, callback, context, NULL, min_separation_us, keep_latest, ESP_DDS_NO_GROUP);
+    
+    give_mutex(d);
+    return ok;
+}
+
+void esp_dds_domain_unsubscribe(esp_dds_domain_t* d, const char* topic, esp_dds_topic_cb_t callback) {
+    esp_dds_domain_unsubscribe_name(d, esp_dds_make_name(topic), callback);
+}
+
+void esp_dds_domain_unsubscribe_name(esp_dds_domain_t* d, esp_dds_name_t topic, esp_dds_topic_cb_t callback) {
+    if (!topic.length || !take_mutex(d, 100)) return;
+    
+    esp_dds_topic_t* t = find_topic(d, &topic);
+    if (t) {
+        for (uint8_t i = 0; i < t->subscriber_count; i++) {
+            if (t->subscribers[i].callback == callback && t->subscribers[i].wildcard == ESP_DDS_NO_WILDCARD) {
+                release_filter(d, t->subscribers[i].filter);
+                release_rate_limit(d, t->subscribers[i].rate_limit);
+                release_key_set(d, t->subscribers[i].key_set);
+                remove_subscriber(t, i);
+                break;
             }
-            dds_ctx.pending_count--;
-            i--; // Recheck current position
         }
     }
     
-    give_mutex();
+    give_mutex(d);
 }
 
-bool esp_dds_is_goal_canceled(const char* action) {
-    if (!take_mutex(10)) return false;
+bool esp_dds_domain_subscribe_pattern(esp_dds_domain_t* d, const char* pattern, esp_dds_topic_cb_t callback, void* context) {
+    if (!pattern || !callback) return false;
     
-    esp_dds_action_t* a = find_action(action);
-    bool canceled = a ? a->cancel_requested : false;
+    name_segments_t segs;
+    if (!validate_pattern(pattern, &segs)) return false;
+    if (!take_mutex(d, 100)) return false;
     
-    give_mutex();
-    return canceled;
-}
\ No newline at end of file
+    uint8_t k = 0;
+    while (k < ESP_DDS_MAX_WILDCARD_SUBS && d->wildcard_subs[k].in_use) k++;
+    uint16_t pattern_id = k < ESP_DDS_MAX_WILDCARD_SUBS ? intern_name(d, pattern, strlen(pattern)) : ESP_DDS_NO_NAME;
+    uint8_t node = pattern_id != ESP_DDS_NO_NAME ? trie_insert(d, &segs) : ESP_DDS_TRIE_NONE;
+    if (node == ESP_DDS_TRIE_NONE) {
+        give_mutex(d);
+        return false;
+    }
+    
+    esp_dds_wildcard_sub_t* w = &d->wildcard_subs[k];
+    w->pattern_id = pattern_id;
+    w->callback = callback;
+    w->context = context;
+    w->node = node;
+    w->in_use = true;
+    
+    // Topics that already exist are resolved now, later ones on creation.
+    // Topics whose subscriber list is full are skipped.
+    for (esp_dds_index_t i = 0; i < d->topic_count; i++) {
+        if (d->topic_slots[i].in_use &&
+            pattern_matches(pattern, name_str(d, d->topic_info[i].name_id))) {
+            append_subscriber(d, &d->topics[i], callback, context, k);
+        }
+    }
+    
+    give_mutex(d);
+    return true;
+}
+
+void esp_dds_domain_unsubscribe_pattern(esp_dds_domain_t* d, const char* pattern, esp_dds_topic_cb_t callback) {
+    if (!pattern || !take_mutex(d, 100)) return;
+    
+    for (uint8_t k = 0; k < ESP_DDS_MAX_WILDCARD_SUBS; k++) {
+        esp_dds_wildcard_sub_t* w = &d->wildcard_subs[k];
+        if (!w->in_use || w->callback != callback || strcmp(name_str(d, w->pattern_id), pattern) != 0) continue;
+        
+        name_segments_t segs;
+        split_name(pattern, &segs);
+        trie_remove(d, &segs);
+        w->in_use = false;
+        
+        // Drop the concrete subscriptions this pattern resolved to, and only those
+        for (esp_dds_index_t i = 0; i < d->topic_count; i++) {
+            esp_dds_topic_t* t = &d->topics[i];
+            if (!d->topic_slots[i].in_use) continue;
+            for (uint8_t j = 0; j < t->subscriber_count; j++) {
+                if (t->subscribers[j].wildcard == k) {
+                    remove_subscriber(t, j);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+    
+    give_mutex(d);
+}
+
+// Keyed topic implementation - a key never changes once set, instances live until reset
+bool esp_dds_domain_set_topic_key(esp_dds_domain_t* d, const char* topic, uint16_t key_offset, uint8_t key_width) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length || (key_width != 1 && key_width != 2 && key_width != 4)) return false;
+    if ((size_t)key_offset + key_width > ESP_DDS_MAX_INSTANCE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_or_create_topic(d, &name);
+    esp_dds_topic_info_t* info = t ? &d->topic_info[t - d->topics] : NULL;
+    bool ok = t != NULL;
+    if (ok && t->key_width) {
+        ok = t->key_width == key_width && info->key_offset == key_offset;
+    } else if (ok) {
+        t->key_width = key_width;
+        info->key_offset = key_offset;
+        info->first_instance = ESP_DDS_NO_INSTANCE;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+bool esp_dds_domain_read_instance(esp_dds_domain_t* d, const char* topic, uint32_t key, void* data, size_t* size) {
+    return esp_dds_domain_read_instance_name(d, esp_dds_make_name(topic), key, data, size);
+}
+
+// *size is the buffer size in, the sample size out
+bool esp_dds_domain_read_instance_name(esp_dds_domain_t* d, esp_dds_name_t topic, uint32_t key,
+                                       void* data, size_t* size) {
+    if (!topic.length || !data || !size || !take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_topic(d, &topic);
+    uint8_t id = (t && t->key_width) ? d->topic_info[t - d->topics].first_instance : ESP_DDS_NO_INSTANCE;
+    while (id != ESP_DDS_NO_INSTANCE && d->instances[id].key != key) {
+        id = d->instances[id].next;
+    }
+    
+    bool ok = id != ESP_DDS_NO_INSTANCE && d->instances[id].size <= *size;
+    if (ok) {
+        memcpy(data, d->instances[id].data, d->instances[id].size);
+        *size = d->instances[id].size;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+bool esp_dds_domain_subscribe_instances(esp_dds_domain_t* d, const char* topic, const uint32_t* keys, uint8_t key_count,
+                                        esp_dds_topic_cb_t callback, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length || !callback || !keys || !key_count || key_count > ESP_DDS_MAX_SET_KEYS) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_topic(d, &name);
+    uint8_t set_id = (t && t->key_width) ? acquire_key_set(d, keys, key_count) : ESP_DDS_NO_KEY_SET;
+    bool ok = set_id != ESP_DDS_NO_KEY_SET &&
+              add_subscriber(d, &name, callback, context, NULL, 0, false, ESP_DDS_NO_GROUP);
+    if (ok) {
+        t->subscribers[t->subscriber_count - 1].key_set = set_id;
+    } else {
+        release_key_set(d, set_id);
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Topic QoS implementation
+bool esp_dds_domain_set_deadline(esp_dds_domain_t* d, const char* topic, uint32_t period_us, uint8_t tolerance_percent,
+                         esp_dds_qos_cb_t callback, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length) return false;
+    if (period_us > 0x7FFFFFFFUL / (100 + tolerance_percent)) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_or_create_topic(d, &name);
+    if (!t) {
+        give_mutex(d);
+        return false;
+    }
+    
+    esp_dds_index_t index = (esp_dds_index_t)(t - d->topics);
+    esp_dds_topic_qos_t* q = &d->topic_info[index].qos;
+    uint16_t id = (uint16_t)(index * 2 + WHEEL_KIND_DEADLINE);
+    q->period_us = period_us;
+    if (period_us == 0) {
+        wheel_remove(&d->wheel, id);
+    } else {
+        q->deadline_us = period_us + period_us * tolerance_percent / 100;
+        q->deadline_base_us = DDS_MICROS();
+        q->deadline_seen_us = t->last_publish_us;
+        wheel_insert(&d->wheel, id, q->deadline_base_us + q->deadline_us);
+    }
+    if (callback) {
+        q->callback = callback;
+        q->context = context;
+    }
+    
+    give_mutex(d);
+    return true;
+}
+
+bool esp_dds_domain_set_liveliness(esp_dds_domain_t* d, const char* topic, uint32_t lease_us,
+                           esp_dds_qos_cb_t callback, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length) return false;
+    if (lease_us > 0x7FFFFFFFUL) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_or_create_topic(d, &name);
+    if (!t) {
+        give_mutex(d);
+        return false;
+    }
+    
+    // Liveliness is asserted when the lease is set, like a freshly created writer
+    esp_dds_index_t index = (esp_dds_index_t)(t - d->topics);
+    esp_dds_topic_qos_t* q = &d->topic_info[index].qos;
+    uint16_t id = (uint16_t)(index * 2 + WHEEL_KIND_LIVELINESS);
+    q->lease_us = lease_us;
+    q->alive = true;
+    if (lease_us == 0) {
+        wheel_remove(&d->wheel, id);
+    } else {
+        q->liveliness_base_us = DDS_MICROS();
+        q->liveliness_seen_us = t->last_publish_us;
+        wheel_insert(&d->wheel, id, q->liveliness_base_us + lease_us);
+    }
+    if (callback) {
+        q->callback = callback;
+        q->context = context;
+    }
+    
+    give_mutex(d);
+    return true;
+}
+
+bool esp_dds_domain_get_topic_status(esp_dds_domain_t* d, const char* topic, esp_dds_topic_status_t* status) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length || !status) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_topic(d, &name);
+    if (t) {
+        const esp_dds_topic_qos_t* q = &d->topic_info[t - d->topics].qos;
+        status->last_publish_us = t->last_publish_us;
+        status->deadline_missed = q->deadline_missed;
+        status->liveliness_lost = q->liveliness_lost;
+        status->alive = q->lease_us ? q->alive : true;
+    }
+    
+    give_mutex(d);
+    return t != NULL;
+}
+
+esp_dds_index_t esp_dds_domain_collect_topics(esp_dds_domain_t* d) {
+    if (!take_mutex(d, 100)) return 0;
+    
+    esp_dds_index_t freed = 0;
+    for (esp_dds_index_t i = 0; i < d->topic_count; i++) {
+        const esp_dds_topic_info_t* info = &d->topic_info[i];
+        if (!d->topic_slots[i].in_use || d->topics[i].subscriber_count || d->topics[i].key_width ||
+            d->topics[i].network || info->qos.period_us || info->qos.lease_us) {
+            continue;
+        }
+        
+        // Nothing references an idle topic (no filters, rate limits, instances or armed timers)
+        d->topic_hashes[i] = 0;
+        d->topics[i].subscriber_count = 0;
+        d->topics[i].last_publish_us = 0;
+        memset(&d->topic_info[i], 0, sizeof(d->topic_info[i]));
+        d->topic_info[i].name_id = ESP_DDS_NO_NAME;
+        free_slot(d->topic_slots, &d->free_topic, i);
+        freed++;
+    }
+    
+    give_mutex(d);
+    return freed;
+}
+
+// Timer implementation - each timer owns wheel node TIMER_NODE_BASE + id
+uint16_t esp_dds_domain_create_timer(esp_dds_domain_t* d, uint32_t period_us,
+                                     esp_dds_timer_cb_t callback, void* context) {
+    if (!callback || !period_us || period_us > 0x7FFFFFFFUL) return ESP_DDS_NO_TIMER;
+    if (!take_mutex(d, 100)) return ESP_DDS_NO_TIMER;
+    
+    uint16_t id = ESP_DDS_NO_TIMER;
+    for (uint16_t i = 0; i < d->max_timers; i++) {
+        if (!d->timers[i].in_use) {
+            id = i;
+            break;
+        }
+    }
+    if (id != ESP_DDS_NO_TIMER) {
+        esp_dds_timer_t* t = &d->timers[id];
+        t->callback = callback;
+        t->context = context;
+        t->period_us = period_us;
+        t->expected_us = DDS_MICROS() + period_us;
+        t->group = ESP_DDS_NO_GROUP;
+        t->in_use = true;
+        wheel_insert(&d->wheel, TIMER_NODE_BASE(d) + id, t->expected_us);
+    }
+    
+    give_mutex(d);
+    return id;
+}
+
+// A tick already queued on an executor still runs once
+bool esp_dds_domain_destroy_timer(esp_dds_domain_t* d, uint16_t timer) {
+    if (timer >= d->max_timers || !take_mutex(d, 100)) return false;
+    
+    bool ok = d->timers[timer].in_use;
+    if (ok) {
+        wheel_remove(&d->wheel, TIMER_NODE_BASE(d) + timer);
+        d->timers[timer].in_use = false;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Remote calls - services and actions on other nodes, reached through the transports
+// Sends on every transport that carries service and action traffic, false if none took
+// the message. Runs under the mutex.
+static bool send_remote(esp_dds_domain_t* d, const esp_dds_message_t* m) {
+    bool sent = false;
+    for (esp_dds_transport_t* tr = d->transports; tr; tr = tr->next) {
+        if (!tr->ops->send_message) continue;
+        if (tr->ops->send_message(tr, m)) {
+            tr->sent++;
+            sent = true;
+        } else {
+            tr->dropped++;
+        }
+    }
+    return sent;
+}
+
+// Deadline of a remote async call or goal, a timeout of 0 takes the default
+static uint32_t remote_deadline(uint32_t timeout_ms) {
+    return DDS_MILLIS() + (timeout_ms ? timeout_ms : ESP_DDS_REMOTE_TIMEOUT_MS);
+}
+
+// An unanswered remote async service call past its deadline
+static bool remote_call_expired(const esp_dds_pending_t* p, uint32_t now_ms) {
+    return p->remote && !p->is_action && !p->sync && !p->response_ready && (int32_t)(now_ms - p->deadline_ms) >= 0;
+}
+
+// A remote goal the server has neither accepted nor rejected yet
+static bool remote_goal_unconfirmed(const esp_dds_pending_t* p) {
+    return p->remote && p->is_action && !p->response_ready && p->action_state == ESP_DDS_ACTION_ACCEPTED;
+}
+
+// Remote calls to one service still waiting for their answer
+static uint16_t remote_calls_in_flight(esp_dds_domain_t* d, uint16_t name_id) {
+    uint32_t now_ms = DDS_MILLIS();
+    uint16_t count = 0;
+    for (esp_dds_index_t i = 0; i < d->pending_count; i++) {
+        const esp_dds_pending_t* p = &d->pending[i];
+        if (p->remote && !p->is_action && !p->response_ready && p->target_name_id == name_id &&
+            !remote_call_expired(p, now_ms)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Sends a request or goal and tracks it in a pending entry whose sequence is the
+// message id. Requests stay within the remote window. Runs under the mutex.
+static esp_dds_pending_t* send_remote_call(esp_dds_domain_t* d, const esp_dds_name_t* name, uint8_t kind,
+                                           const void* data, size_t size) {
+    if (d->pending_count >= d->max_pending) return NULL;
+    uint16_t name_id = intern_name(d, name->str, name->length);
+    if (name_id == ESP_DDS_NO_NAME) return NULL;
+    if (kind == ESP_DDS_MESSAGE_REQUEST && remote_calls_in_flight(d, name_id) >= d->remote_window) return NULL;
+    
+    esp_dds_pending_t* p = &d->pending[d->pending_count];
+    p->target_name_id = name_id;
+    p->target_index = ESP_DDS_NO_SLOT;
+    p->target_generation = 0;
+    p->caller_task = xTaskGetCurrentTaskHandle();
+    p->callback.async_cb = NULL;
+    p->feedback_cb = NULL;
+    p->context = NULL;
+    p->response_size = 0;
+    p->action_state = ESP_DDS_ACTION_ACCEPTED;  // Until the server confirms the goal
+    p->sequence = d->next_sequence++;
+    p->response_ready = false;
+    p->is_action = (kind == ESP_DDS_MESSAGE_GOAL);
+    p->remote = true;
+    p->sync = false;
+    p->failed = false;
+    
+    esp_dds_message_t m = { data, size, name->hash, p->sequence, kind, 0 };
+    if (!send_remote(d, &m)) return NULL;
+    d->pending_count++;
+    return p;
+}
+
+static esp_dds_index_t find_remote_pending(esp_dds_domain_t* d, bool is_action, uint32_t id) {
+    for (esp_dds_index_t i = 0; i < d->pending_count; i++) {
+        const esp_dds_pending_t* p = &d->pending[i];
+        if (p->remote && p->is_action == is_action && p->sequence == id) return i;
+    }
+    return ESP_DDS_NO_SLOT;
+}
+
+// Waits for room in the window, then for the response, pumping the transports so a
+// single-threaded node needs no receive task
+static bool call_remote_sync(esp_dds_domain_t* d, const esp_dds_name_t* service, const void* request, size_t req_size,
+                             void* response, size_t* resp_size, uint32_t timeout_ms) {
+    esp_dds_pending_t* p = NULL;
+    uint16_t id = 0;
+    uint32_t start = DDS_MILLIS();
+    while (true) {
+        if (take_mutex(d, 100)) {
+            p = send_remote_call(d, service, ESP_DDS_MESSAGE_REQUEST, request, req_size);
+            if (p) {
+                p->sync = true;
+                id = p->sequence;
+            }
+            give_mutex(d);
+        }
+        if (p) break;
+        if (DDS_MILLIS() - start >= timeout_ms) return false;
+        esp_dds_domain_process_transports(d, 1);
+    }
+    
+    bool done = false;
+    bool ok = false;
+    while (true) {
+        if (take_mutex(d, 100)) {
+            esp_dds_index_t i = find_remote_pending(d, false, id);
+            if (i != ESP_DDS_NO_SLOT && d->pending[i].response_ready) {
+                p = &d->pending[i];
+                ok = !p->failed && p->response_size <= *resp_size;
+                if (ok) {
+                    memcpy(response, p->response_data, p->response_size);
+                    *resp_size = p->response_size;
+                }
+                remove_pending(d, i);
+                done = true;
+            }
+            give_mutex(d);
+        }
+        if (done || DDS_MILLIS() - start >= timeout_ms) break;
+        esp_dds_domain_process_transports(d, 1);
+    }
+    
+    // A response arriving after the timeout finds no entry and is dropped
+    if (!done && take_mutex(d, 100)) {
+        esp_dds_index_t i = find_remote_pending(d, false, id);
+        if (i != ESP_DDS_NO_SLOT) remove_pending(d, i);
+        give_mutex(d);
+    }
+    return ok;
+}
+
+// Service implementation
+bool esp_dds_domain_create_service(esp_dds_domain_t* d, const char* service, esp_dds_service_cb_t callback,
+                           esp_dds_service_mode_t mode, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(service);
+    if (!name.length || !callback) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_index_t index;
+    if (find_service(d, &name) || !alloc_slot(d->service_slots, &d->free_service,
+                                           &d->service_count, d->max_services, &index)) {
+        give_mutex(d);
+        return false;
+    }
+    uint16_t name_id = intern_name(d, name.str, name.length);
+    if (name_id == ESP_DDS_NO_NAME) {
+        free_slot(d->service_slots, &d->free_service, index);
+        give_mutex(d);
+        return false;
+    }
+    
+    esp_dds_service_t* s = &d->services[index];
+    s->name_id = name_id;
+    s->name_hash = name.hash;
+    s->callback = callback;
+    s->mode = mode;
+    s->context = context;
+    s->group = ESP_DDS_NO_GROUP;
+    
+    give_mutex(d);
+    return true;
+}
+
+// A sync call already inside the callback completes; later lookups fail
+bool esp_dds_domain_destroy_service(esp_dds_domain_t* d, const char* service) {
+    esp_dds_name_t name = esp_dds_make_name(service);
+    if (!name.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_service_t* s = find_service(d, &name);
+    if (s) {
+        esp_dds_index_t index = (esp_dds_index_t)(s - d->services);
+        memset(s, 0, sizeof(*s));
+        s->name_id = ESP_DDS_NO_NAME;
+        free_slot(d->service_slots, &d->free_service, index);
+    }
+    
+    give_mutex(d);
+    return s != NULL;
+}
+
+bool esp_dds_domain_call_service_sync(esp_dds_domain_t* d, const char* service, const void* request, size_t req_size,
+                              void* response, size_t* resp_size, uint32_t timeout_ms) {
+    return esp_dds_domain_call_service_sync_name(d, esp_dds_make_name(service), request, req_size,
+                                          response, resp_size, timeout_ms);
+}
+
+bool esp_dds_domain_call_service_sync_name(esp_dds_domain_t* d, esp_dds_name_t service, const void* request, size_t req_size,
+                                   void* response, size_t* resp_size, uint32_t timeout_ms) {
+    if (!service.length || !request || !response || !resp_size || req_size > ESP_DDS_MAX_MESSAGE_SIZE) {
+        return false;
+    }
+    
+    if (!take_mutex(d, 100)) {
+        return false;
+    }
+    
+    esp_dds_service_t* s = find_service(d, &service);
+    
+    if (!s && d->transports) {
+        give_mutex(d);
+        return call_remote_sync(d, &service, request, req_size, response, resp_size, timeout_ms);
+    }
+    if (!s || !s->callback) {
+        give_mutex(d);
+        return false;
+    }
+    
+    // Cache the callback and context while we have the mutex
+    esp_dds_service_cb_t callback = s->callback;
+    void* context = s->context;
+    uint8_t group = s->group;
+    
+    // Release mutex before calling callback (callback might take time)
+    give_mutex(d);
+    
+    // Verify callback is still valid (extra safety check)
+    if (!callback) {
+        return false;
+    }
+    
+    // A grouped service still runs here, but never alongside its group's other callbacks
+    if (group != ESP_DDS_NO_GROUP && !wait_for_group(d, group, timeout_ms)) {
+        return false;
+    }
+    
+    // Execute callback in caller's thread
+    bool result = callback(request, req_size, response, resp_size, context);
+    
+    if (group != ESP_DDS_NO_GROUP) {
+        release_group(d, group);
+    }
+    return result;
+}
+
+bool esp_dds_domain_call_service_async(esp_dds_domain_t* d, const char* service, const void* request, size_t req_size,
+                               esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms) {
+    return esp_dds_domain_call_service_async_name(d, esp_dds_make_name(service), request, req_size,
+                                           callback, context, timeout_ms);
+}
+
+bool esp_dds_domain_call_service_async_name(esp_dds_domain_t* d, esp_dds_name_t service, const void* request, size_t req_size,
+                                    esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms) {
+    if (!service.length || !request || !callback || req_size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_service_t* s = find_service(d, &service);
+    if (!s && d->transports) {
+        esp_dds_pending_t* p = send_remote_call(d, &service, ESP_DDS_MESSAGE_REQUEST, request, req_size);
+        if (p) {
+            p->callback.async_cb = callback;
+            p->context = context;
+            p->deadline_ms = remote_deadline(timeout_ms);
+        }
+        give_mutex(d);
+        return p != NULL;
+    }
+    if (!s || !s->callback || d->pending_count >= d->max_pending) {
+        give_mutex(d);
+        return false;
+    }
+    
+    // Store pending request
+    esp_dds_pending_t* pending = &d->pending[d->pending_count];
+    pending->target_name_id = s->name_id;
+    pending->target_index = (esp_dds_index_t)(s - d->services);
+    pending->target_generation = d->service_slots[pending->target_index].generation;
+    pending->caller_task = xTaskGetCurrentTaskHandle();
+    pending->callback.async_cb = callback;
+    pending->feedback_cb = NULL;
+    pending->context = context;
+    pending->is_action = false;
+    pending->response_ready = false;
+    pending->remote = false;
+    pending->sync = false;
+    pending->failed = false;
+    pending->sequence = d->next_sequence++;
+    
+    // A grouped service answers from its executor, the response arrives via process_pending
+    if (s->group != ESP_DDS_NO_GROUP) {
+        esp_dds_work_item_t* w = enqueue_work(d, s->group, request, req_size);
+        if (w) {
+            w->target = pending->target_index;
+            w->target_generation = pending->target_generation;
+            w->sequence = pending->sequence;
+            w->kind = ESP_DDS_WORK_REQUEST;
+            d->pending_count++;
+        }
+        give_mutex(d);
+        return w != NULL;
+    }
+    
+    // Execute service immediately (in current thread)
+    uint8_t temp_response[ESP_DDS_MAX_MESSAGE_SIZE];
+    size_t temp_size = sizeof(temp_response);
+    bool success = s->callback(request, req_size, temp_response, &temp_size, s->context);
+    
+    if (success) {
+        memcpy(pending->response_data, temp_response, temp_size);
+        pending->response_size = temp_size;
+        pending->response_ready = true;
+        d->pending_count++;
+        notify_waitsets(d, ESP_DDS_CONDITION_RESPONSE, s->name_id);
+    }
+    
+    give_mutex(d);
+    return success;
+}
+
+// Action implementation
+bool esp_dds_domain_create_action(esp_dds_domain_t* d, const char* action, esp_dds_goal_cb_t goal_cb,
+                          esp_dds_execute_cb_t execute_cb, esp_dds_cancel_cb_t cancel_cb,
+                          void* context) {
+    esp_dds_name_t name = esp_dds_make_name(action);
+    if (!name.length || !goal_cb || !execute_cb) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_index_t index;
+    if (find_action(d, &name) || !alloc_slot(d->action_slots, &d->free_action,
+                                          &d->action_count, d->max_actions, &index)) {
+        give_mutex(d);
+        return false;
+    }
+    uint16_t name_id = intern_name(d, name.str, name.length);
+    if (name_id == ESP_DDS_NO_NAME) {
+        free_slot(d->action_slots, &d->free_action, index);
+        give_mutex(d);
+        return false;
+    }
+    
+    esp_dds_action_t* a = &d->actions[index];
+    a->name_id = name_id;
+    a->name_hash = name.hash;
+    a->goal_callback = goal_cb;
+    a->execute_callback = execute_cb;
+    a->cancel_callback = cancel_cb;
+    a->context = context;
+    a->state = ESP_DDS_ACTION_ACCEPTED;
+    a->active = false;
+    a->cancel_requested = false;
+    a->group = ESP_DDS_NO_GROUP;
+    a->executing = false;
+    
+    give_mutex(d);
+    return true;
+}
+
+// Goals still pending on the action are reported as aborted by esp_dds_process_pending
+bool esp_dds_domain_destroy_action(esp_dds_domain_t* d, const char* action) {
+    esp_dds_name_t name = esp_dds_make_name(action);
+    if (!name.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &name);
+    if (a) {
+        esp_dds_index_t index = (esp_dds_index_t)(a - d->actions);
+        if (a->active && a->remote) {
+            esp_dds_message_t m = { NULL, 0, a->name_hash, a->remote_goal, ESP_DDS_MESSAGE_RESULT,
+                                    ESP_DDS_ACTION_ABORTED };
+            a->remote->ops->send_message(a->remote, &m);
+        }
+        notify_waitsets(d, ESP_DDS_CONDITION_RESULT, a->name_id);
+        memset(a, 0, sizeof(*a));
+        a->name_id = ESP_DDS_NO_NAME;
+        free_slot(d->action_slots, &d->free_action, index);
+    }
+    
+    give_mutex(d);
+    return a != NULL;
+}
+
+bool esp_dds_domain_send_goal(esp_dds_domain_t* d, const char* action, const void* goal, size_t goal_size,
+                      esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                      void* context, uint32_t timeout_ms) {
+    return esp_dds_domain_send_goal_name(d, esp_dds_make_name(action), goal, goal_size,
+                                  feedback_cb, result_cb, context, timeout_ms);
+}
+
+bool esp_dds_domain_send_goal_name(esp_dds_domain_t* d, esp_dds_name_t action, const void* goal, size_t goal_size,
+                           esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                           void* context, uint32_t timeout_ms) {
+    if (!action.length || !goal || goal_size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &action);
+    if (!a && d->transports) {
+        // The server's goal callback decides later, a rejection ends the goal as aborted.
+        // The goal waits in response_data in case it has to go out again.
+        esp_dds_pending_t* p = send_remote_call(d, &action, ESP_DDS_MESSAGE_GOAL, goal, goal_size);
+        if (p) {
+            p->callback.result_cb = result_cb;
+            p->feedback_cb = feedback_cb;
+            p->context = context;
+            memcpy(p->response_data, goal, goal_size);
+            p->response_size = goal_size;
+            p->deadline_ms = remote_deadline(timeout_ms);
+            p->retry_ms = DDS_MILLIS() + ESP_DDS_REMOTE_RETRY_MS;
+        }
+        give_mutex(d);
+        return p != NULL;
+    }
+    if (!a || a->active || !a->goal_callback) {
+        give_mutex(d);
+        return false;
+    }
+    
+    // Check if goal is accepted
+    if (!a->goal_callback(goal, goal_size, a->context)) {
+        give_mutex(d);
+        return false;
+    }
+    
+    // Store goal and client info
+    memcpy(a->goal_data, goal, goal_size);
+    a->goal_size = goal_size;
+    a->active = true;
+    a->state = ESP_DDS_ACTION_ACCEPTED;
+    a->cancel_requested = false;
+    a->remote = NULL;
+    
+    // Create pending result tracker
+    if (d->pending_count < d->max_pending) {
+        esp_dds_pending_t* pending = &d->pending[d->pending_count];
+        pending->target_name_id = a->name_id;
+        pending->target_index = (esp_dds_index_t)(a - d->actions);
+        pending->target_generation = d->action_slots[pending->target_index].generation;
+        pending->caller_task = xTaskGetCurrentTaskHandle();
+        pending->callback.result_cb = result_cb;
+        pending->feedback_cb = feedback_cb;
+        pending->context = context;
+        pending->is_action = true;
+        pending->response_ready = false;
+        pending->remote = false;
+        pending->sync = false;
+        pending->failed = false;
+        d->pending_count++;
+    }
+    
+    give_mutex(d);
+    return true;
+}
+
+bool esp_dds_domain_cancel_goal(esp_dds_domain_t* d, const char* action, uint32_t timeout_ms) {
+    return esp_dds_domain_cancel_goal_name(d, esp_dds_make_name(action), timeout_ms);
+}
+
+bool esp_dds_domain_cancel_goal_name(esp_dds_domain_t* d, esp_dds_name_t action, uint32_t timeout_ms) {
+    if (!action.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &action);
+    if (!a && d->transports) {
+        // Cancels this node's open goals on the action, the result reports the outcome
+        bool sent = false;
+        for (esp_dds_index_t i = 0; i < d->pending_count; i++) {
+            const esp_dds_pending_t* p = &d->pending[i];
+            if (p->remote && p->is_action && !p->response_ready &&
+                strcmp(name_str(d, p->target_name_id), action.str) == 0) {
+                esp_dds_message_t m = { NULL, 0, action.hash, p->sequence, ESP_DDS_MESSAGE_CANCEL, 0 };
+                sent |= send_remote(d, &m);
+            }
+        }
+        give_mutex(d);
+        return sent;
+    }
+    if (!a || !a->active) {
+        give_mutex(d);
+        return false;
+    }
+    
+    a->cancel_requested = true;
+    if (a->cancel_callback) {
+        a->cancel_callback(a->context);
+    }
+    
+    give_mutex(d);
+    return true;
+}
+
+bool esp_dds_domain_send_feedback(esp_dds_domain_t* d, const char* action, const void* feedback, size_t size) {
+    return esp_dds_domain_send_feedback_name(d, esp_dds_make_name(action), feedback, size);
+}
+
+bool esp_dds_domain_send_feedback_name(esp_dds_domain_t* d, esp_dds_name_t action, const void* feedback, size_t size) {
+    if (!action.length || !feedback || size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &action);
+    esp_dds_index_t index = a ? (esp_dds_index_t)(a - d->actions) : ESP_DDS_NO_SLOT;
+    
+    // Find pending action and deliver feedback
+    for (esp_dds_index_t i = 0; a && i < d->pending_count; i++) {
+        esp_dds_pending_t* p = &d->pending[i];
+        if (p->is_action && !p->remote && p->target_index == index && pending_target_alive(d, p) &&
+            p->feedback_cb) {
+            // Execute feedback callback in caller's thread context
+            p->feedback_cb(action.str, feedback, size, p->context);
+            break;
+        }
+    }
+    if (a && a->active && a->remote) {
+        esp_dds_message_t m = { feedback, size, a->name_hash, a->remote_goal, ESP_DDS_MESSAGE_FEEDBACK, 0 };
+        a->remote->ops->send_message(a->remote, &m);
+    }
+    
+    give_mutex(d);
+    return true;
+}
+
+// Processing functions
+void esp_dds_domain_process_services(esp_dds_domain_t* d) {
+    // Services are processed immediately in caller's thread
+    // No background processing needed for this simple design
+}
+
+static bool action_runnable(const esp_dds_action_t* a) {
+    return a->active && (a->state == ESP_DDS_ACTION_ACCEPTED || a->state == ESP_DDS_ACTION_EXECUTING);
+}
+
+// Stores the outcome of one execute step, a final state goes to the goal's pending
+// entry for esp_dds_process_pending. Runs under the mutex.
+static void finish_action_step(esp_dds_domain_t* d, esp_dds_index_t index, uint8_t generation,
+                               esp_dds_action_state_t state, const void* result, size_t result_size) {
+    // The action may have been destroyed (and its slot reused) meanwhile
+    esp_dds_action_t* a = &d->actions[index];
+    if (d->action_slots[index].generation != generation || !a->active) return;
+    
+    a->state = state;
+    if (state == ESP_DDS_ACTION_EXECUTING) return;
+    a->active = false;
+    
+    if (a->remote) {
+        esp_dds_message_t m = { result, result_size, a->name_hash, a->remote_goal, ESP_DDS_MESSAGE_RESULT,
+                                (uint8_t)state };
+        a->remote->ops->send_message(a->remote, &m);
+        a->remote = NULL;
+        return;
+    }
+    for (esp_dds_index_t i = 0; i < d->pending_count; i++) {
+        esp_dds_pending_t* p = &d->pending[i];
+        if (p->is_action && !p->response_ready && p->target_index == index &&
+            p->target_generation == generation) {
+            memcpy(p->response_data, result, result_size);
+            p->response_size = result_size;
+            p->action_state = state;
+            p->response_ready = true;
+            notify_waitsets(d, ESP_DDS_CONDITION_RESULT, a->name_id);
+            break;
+        }
+    }
+}
+
+void esp_dds_domain_process_actions(esp_dds_domain_t* d) {
+    if (!take_mutex(d, 10)) return;
+    
+    // Collect active actions quickly (just data copying), at most ESP_DDS_MAX_ACTIONS per call
+    esp_dds_action_t active_actions[ESP_DDS_MAX_ACTIONS];
+    esp_dds_index_t active_index[ESP_DDS_MAX_ACTIONS];
+    uint8_t active_generation[ESP_DDS_MAX_ACTIONS];
+    esp_dds_index_t active_count = 0;
+    
+    for (esp_dds_index_t i = 0; i < d->action_count; i++) {
+        esp_dds_action_t* a = &d->actions[i];
+        if (a->group == ESP_DDS_NO_GROUP && action_runnable(a)) {
+            // Copy only what we need for execution
+            memcpy(&active_actions[active_count], a, sizeof(esp_dds_action_t));
+            active_index[active_count] = i;
+            active_generation[active_count] = d->action_slots[i].generation;
+            active_count++;
+            if (active_count >= ESP_DDS_MAX_ACTIONS) break;
+        }
+    }
+    
+    give_mutex(d);  // RELEASE MUTEX BEFORE CALLBACKS!
+    
+    // Execute callbacks WITHOUT holding mutex
+    for (esp_dds_index_t i = 0; i < active_count; i++) {
+        esp_dds_action_t* a = &active_actions[i];
+        
+        uint8_t result[ESP_DDS_MAX_MESSAGE_SIZE];
+        size_t result_size = sizeof(result);
+        
+        esp_dds_action_state_t state = a->execute_callback(
+            a->goal_data, a->goal_size, result, &result_size, a->context);
+        
+        // Re-acquire mutex briefly to update state
+        if (take_mutex(d, 100)) {
+            finish_action_step(d, active_index[i], active_generation[i], state, result,
+                               result_size <= sizeof(result) ? result_size : 0);
+            give_mutex(d);
+        }
+    }
+}
+
+void esp_dds_domain_process_pending(esp_dds_domain_t* d, uint32_t timeout_ms) {
+    if (!take_mutex(d, 10)) return;
+    
+    TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+    uint32_t now_ms = DDS_MILLIS();
+    
+    for (esp_dds_index_t i = 0; i < d->pending_count; i++) {
+        esp_dds_pending_t* p = &d->pending[i];
+        
+        // Goals of a destroyed action end as aborted instead of waiting forever
+        if (p->is_action && !p->response_ready && !pending_target_alive(d, p)) {
+            p->response_size = 0;
+            p->action_state = ESP_DDS_ACTION_ABORTED;
+            p->response_ready = true;
+        }
+        
+        // Unanswered remote calls give up their window place
+        if (remote_call_expired(p, now_ms)) {
+            p->failed = true;
+            p->response_ready = true;
+        }
+        
+        // Unconfirmed goals go out again until their timeout, then end as aborted
+        if (remote_goal_unconfirmed(p) && (int32_t)(now_ms - p->retry_ms) >= 0) {
+            uint32_t hash = esp_dds_make_name(name_str(d, p->target_name_id)).hash;
+            if ((int32_t)(now_ms - p->deadline_ms) >= 0) {
+                esp_dds_message_t m = { NULL, 0, hash, p->sequence, ESP_DDS_MESSAGE_CANCEL, 0 };
+                send_remote(d, &m);
+                p->response_size = 0;
+                p->action_state = ESP_DDS_ACTION_ABORTED;
+                p->response_ready = true;
+            } else {
+                esp_dds_message_t m = { p->response_data, p->response_size, hash, p->sequence,
+                                        ESP_DDS_MESSAGE_GOAL, 0 };
+                send_remote(d, &m);
+                p->retry_ms = now_ms + ESP_DDS_REMOTE_RETRY_MS;
+            }
+        }
+        
+        if (p->response_ready && !p->sync && p->caller_task == current_task) {
+            // Execute callback in caller's thread context
+            if (p->failed) {
+                // A refused or timed out remote call gets no callback, like a failed local one
+            } else if (p->is_action && p->callback.result_cb) {
+                p->callback.result_cb(name_str(d, p->target_name_id), p->response_data, 
+                                    p->response_size, p->action_state, p->context);
+            } else if (!p->is_action && p->callback.async_cb) {
+                p->callback.async_cb(name_str(d, p->target_name_id), p->response_data,
+                                   p->response_size, p->context);
+            }
+            
+            remove_pending(d, i);
+            i--; // Recheck current position
+        }
+    }
+    
+    give_mutex(d);
+}
+
+// Returns true if an event must be reported, re-arms the node in both cases
+static bool check_deadline(esp_dds_domain_t* d, esp_dds_index_t index, uint16_t id, uint32_t now, uint32_t* count) {
+    const esp_dds_topic_t* t = &d->topics[index];
+    esp_dds_topic_qos_t* q = &d->topic_info[index].qos;
+    
+    // A fresh sample restarts the window. Fresh means published since the last check: a
+    // publish time compared by age would look new again once the 32-bit clock wraps past it.
+    uint32_t published = t->last_publish_us;
+    if (published != q->deadline_seen_us) {
+        q->deadline_seen_us = published;
+        q->deadline_base_us = published;
+    }
+    
+    uint32_t expiry = q->deadline_base_us + q->deadline_us;
+    if ((int32_t)(now - expiry) < 0) {
+        wheel_insert(&d->wheel, id, expiry);
+        return false;
+    }
+    
+    // Every whole period elapsed past the first deadline counts as another miss
+    uint32_t missed = 1 + (now - expiry) / q->period_us;
+    q->deadline_missed += missed;
+    q->deadline_base_us += missed * q->period_us;
+    wheel_insert(&d->wheel, id, q->deadline_base_us + q->deadline_us);
+    *count = missed;
+    return true;
+}
+
+static bool check_liveliness(esp_dds_domain_t* d, esp_dds_index_t index, uint16_t id, uint32_t now,
+                             esp_dds_qos_event_t* event) {
+    const esp_dds_topic_t* t = &d->topics[index];
+    esp_dds_topic_qos_t* q = &d->topic_info[index].qos;
+    
+    uint32_t published = t->last_publish_us;
+    bool fresh = published != q->liveliness_seen_us;
+    if (fresh) {
+        q->liveliness_seen_us = published;
+        q->liveliness_base_us = published;
+    }
+    
+    // Once lost only a sample brings it back, the age of a base left behind would wrap
+    bool alive = (fresh || q->alive) && (now - q->liveliness_base_us) < q->lease_us;
+    bool changed = alive != q->alive;
+    q->alive = alive;
+    
+    if (alive) {
+        wheel_insert(&d->wheel, id, q->liveliness_base_us + q->lease_us);
+        *event = ESP_DDS_QOS_LIVELINESS_RESTORED;
+    } else {
+        // Keep polling once per lease to notice the publisher coming back
+        wheel_insert(&d->wheel, id, now + q->lease_us);
+        *event = ESP_DDS_QOS_LIVELINESS_LOST;
+        if (changed) q->liveliness_lost++;
+    }
+    return changed;
+}
+
+void esp_dds_domain_process_timers(esp_dds_domain_t* d) {
+    typedef struct {
+        esp_dds_qos_cb_t callback;
+        void* context;
+        const char* topic;
+        esp_dds_qos_event_t event;
+        uint32_t count;
+    } qos_report_t;
+    
+    typedef struct {
+        esp_dds_timer_cb_t callback;
+        void* context;
+        uint32_t late_us;
+    } timer_call_t;
+    
+    if (!take_mutex(d, 10)) return;
+    
+    // Unlink everything that expired so re-arming cannot revisit it in this pass
+    esp_dds_timer_wheel_t* w = &d->wheel;
+    uint32_t now = DDS_MICROS();
+    uint16_t expired = wheel_expire(w, now);
+    
+    // Domains may monitor more topics and run more timers than one stack batch holds
+    qos_report_t reports[ESP_DDS_MAX_TOPICS * 2];
+    uint16_t report_count = 0;
+    timer_call_t calls[ESP_DDS_MAX_TIMER_BATCH];
+    uint16_t call_count = 0;
+    
+    while (expired != ESP_DDS_TIMER_NONE) {
+        uint16_t id = expired;
+        expired = w->nodes[id].next;
+        
+        if (id >= TIMER_NODE_BASE(d)) {
+            esp_dds_timer_t* t = &d->timers[id - TIMER_NODE_BASE(d)];
+            if (!t->in_use) continue;
+            if (t->group == ESP_DDS_NO_GROUP && call_count == DDS_ARRAY_SIZE(calls)) {
+                wheel_insert(w, id, w->nodes[id].expiry_us); // Checked again on the next call
+                continue;
+            }
+            
+            // Re-arm from the schedule, not from now, skipping periods that were missed
+            uint32_t expected = t->expected_us;
+            uint32_t late = now - expected;
+            t->expected_us = expected + (late / t->period_us + 1) * t->period_us;
+            wheel_insert(w, id, t->expected_us);
+            
+            if (t->group != ESP_DDS_NO_GROUP) {
+                esp_dds_work_item_t* work = enqueue_work(d, t->group, &expected, sizeof(expected));
+                if (work) { // A full queue drops the tick, the next one reports the lateness
+                    work->callback.timer = t->callback;
+                    work->context = t->context;
+                    work->kind = ESP_DDS_WORK_TIMER;
+                }
+            } else {
+                calls[call_count].callback = t->callback;
+                calls[call_count].context = t->context;
+                calls[call_count].late_us = late;
+                call_count++;
+            }
+            continue;
+        }
+        if (id >= RATE_NODE_BASE(d)) {
+            flush_held_sample(d, (uint8_t)(id - RATE_NODE_BASE(d)), now);
+            continue;
+        }
+        if (report_count == DDS_ARRAY_SIZE(reports)) {
+            wheel_insert(w, id, w->nodes[id].expiry_us); // Checked again on the next call
+            continue;
+        }
+        
+        esp_dds_index_t index = (esp_dds_index_t)(id / 2);
+        const esp_dds_topic_info_t* info = &d->topic_info[index];
+        qos_report_t* r = &reports[report_count];
+        r->count = 1;
+        bool report;
+        if (id % 2 == WHEEL_KIND_DEADLINE) {
+            r->event = ESP_DDS_QOS_DEADLINE_MISSED;
+            report = info->qos.period_us && check_deadline(d, index, id, now, &r->count);
+        } else {
+            report = info->qos.lease_us && check_liveliness(d, index, id, now, &r->event);
+        }
+        
+        if (report && info->qos.callback) {
+            r->callback = info->qos.callback;
+            r->context = info->qos.context;
+            r->topic = name_str(d, info->name_id);
+            report_count++;
+        }
+    }
+    
+    give_mutex(d);  // RELEASE MUTEX BEFORE CALLBACKS!
+    
+    for (uint16_t i = 0; i < report_count; i++) {
+        reports[i].callback(reports[i].topic, reports[i].event, reports[i].count, reports[i].context);
+    }
+    for (uint16_t i = 0; i < call_count; i++) {
+        calls[i].callback(calls[i].late_us, calls[i].context);
+    }
+}
+
+bool esp_dds_domain_is_goal_canceled(esp_dds_domain_t* d, const char* action) {
+    return esp_dds_domain_is_goal_canceled_name(d, esp_dds_make_name(action));
+}
+
+bool esp_dds_domain_is_goal_canceled_name(esp_dds_domain_t* d, esp_dds_name_t action) {
+    if (!action.length || !take_mutex(d, 10)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &action);
+    bool canceled = a ? a->cancel_requested : false;
+    
+    give_mutex(d);
+    return canceled;
+}
+
+// Executor implementation
+uint8_t esp_dds_domain_create_executor(esp_dds_domain_t* d, esp_dds_executor_type_t type, uint8_t threads) {
+    if (type == ESP_DDS_EXECUTOR_SINGLE_THREADED) threads = 1;
+    if (threads == 0 || threads > ESP_DDS_MAX_EXECUTOR_THREADS) return ESP_DDS_NO_EXECUTOR;
+    if (!take_mutex(d, 100)) return ESP_DDS_NO_EXECUTOR;
+    
+    uint8_t id = ESP_DDS_NO_EXECUTOR;
+    for (uint8_t i = 0; i < ESP_DDS_MAX_EXECUTORS; i++) {
+        if (!d->executors[i].in_use) {
+            id = i;
+            break;
+        }
+    }
+    if (id != ESP_DDS_NO_EXECUTOR) {
+        esp_dds_executor_t* e = &d->executors[id];
+        memset(e, 0, sizeof(*e));
+        e->domain = d;
+        e->type = type;
+        e->threads = threads;
+        e->in_use = true;
+    }
+    
+    give_mutex(d);
+    return id;
+}
+
+uint8_t esp_dds_domain_create_callback_group(esp_dds_domain_t* d, uint8_t executor, esp_dds_group_type_t type) {
+    if (executor >= ESP_DDS_MAX_EXECUTORS || !take_mutex(d, 100)) return ESP_DDS_NO_GROUP;
+    
+    uint8_t id = ESP_DDS_NO_GROUP;
+    for (uint8_t i = 0; d->executors[executor].in_use && i < ESP_DDS_MAX_CALLBACK_GROUPS; i++) {
+        if (!d->groups[i].in_use) {
+            id = i;
+            break;
+        }
+    }
+    if (id != ESP_DDS_NO_GROUP) {
+        esp_dds_callback_group_t* g = &d->groups[id];
+        g->executor = executor;
+        g->type = type;
+        g->busy = false;
+        g->in_use = true;
+    }
+    
+    give_mutex(d);
+    return id;
+}
+
+static bool group_valid(esp_dds_domain_t* d, uint8_t group) {
+    return group < ESP_DDS_MAX_CALLBACK_GROUPS && d->groups[group].in_use;
+}
+
+bool esp_dds_domain_subscribe_grouped(esp_dds_domain_t* d, const char* topic, uint8_t group,
+                                      esp_dds_topic_cb_t callback, void* context) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length || !callback) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    bool ok = group_valid(d, group) && add_subscriber(d, &name, callback, context, NULL, 0, false, group);
+    
+    give_mutex(d);
+    return ok;
+}
+
+// ESP_DDS_NO_GROUP hands the service back to the caller's thread
+bool esp_dds_domain_set_service_group(esp_dds_domain_t* d, const char* service, uint8_t group) {
+    esp_dds_name_t name = esp_dds_make_name(service);
+    if (!name.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_service_t* s = find_service(d, &name);
+    bool ok = s && (group == ESP_DDS_NO_GROUP || group_valid(d, group));
+    if (ok) {
+        s->group = group;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// ESP_DDS_NO_GROUP hands the action back to esp_dds_process_actions
+bool esp_dds_domain_set_action_group(esp_dds_domain_t* d, const char* action, uint8_t group) {
+    esp_dds_name_t name = esp_dds_make_name(action);
+    if (!name.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &name);
+    bool ok = a && (group == ESP_DDS_NO_GROUP || group_valid(d, group));
+    if (ok) {
+        a->group = group;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// ESP_DDS_NO_GROUP hands the timer back to esp_dds_process_timers
+bool esp_dds_domain_set_timer_group(esp_dds_domain_t* d, uint16_t timer, uint8_t group) {
+    if (timer >= d->max_timers || !take_mutex(d, 100)) return false;
+    
+    esp_dds_timer_t* t = &d->timers[timer];
+    bool ok = t->in_use && (group == ESP_DDS_NO_GROUP || group_valid(d, group));
+    if (ok) {
+        t->group = group;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Serves a queued peer request and answers on its transport, unless it was detached
+static void run_remote_request(esp_dds_domain_t* d, const esp_dds_work_item_t* w) {
+    if (!take_mutex(d, 100)) return;
+    const esp_dds_slot_t* slot = &d->service_slots[w->target];
+    bool alive = slot->in_use && slot->generation == w->target_generation;
+    esp_dds_service_cb_t callback = alive ? d->services[w->target].callback : NULL;
+    void* context = alive ? d->services[w->target].context : NULL;
+    give_mutex(d);
+    
+    uint8_t response[ESP_DDS_MAX_MESSAGE_SIZE];
+    size_t response_size = sizeof(response);
+    bool ok = callback && callback(w->data, w->size, response, &response_size, context) &&
+              response_size <= sizeof(response);
+    
+    if (!take_mutex(d, 100)) return;
+    if (w->transport->domain == d) {
+        esp_dds_message_t reply = { response, ok ? response_size : 0, w->target_hash, w->remote_id,
+                                    ESP_DDS_MESSAGE_RESPONSE, ok };
+        w->transport->ops->send_message(w->transport, &reply);
+    }
+    give_mutex(d);
+}
+
+// Runs a dequeued sample, service request or timer tick. The group is already claimed.
+static void run_work_item(esp_dds_domain_t* d, const esp_dds_work_item_t* w) {
+    if (w->kind == ESP_DDS_WORK_SAMPLE) {
+        w->callback.sample(name_str(d, w->name_id), w->data, w->size, w->context);
+        return;
+    }
+    if (w->kind == ESP_DDS_WORK_TIMER) {
+        uint32_t expected_us;
+        memcpy(&expected_us, w->data, sizeof(expected_us));
+        w->callback.timer(DDS_MICROS() - expected_us, w->context);
+        return;
+    }
+    if (w->kind == ESP_DDS_WORK_REMOTE_REQUEST) {
+        run_remote_request(d, w);
+        return;
+    }
+    
+    if (!take_mutex(d, 100)) return;
+    const esp_dds_slot_t* slot = &d->service_slots[w->target];
+    bool alive = slot->in_use && slot->generation == w->target_generation;
+    esp_dds_service_cb_t callback = alive ? d->services[w->target].callback : NULL;
+    void* context = alive ? d->services[w->target].context : NULL;
+    give_mutex(d);
+    
+    uint8_t response[ESP_DDS_MAX_MESSAGE_SIZE];
+    size_t response_size = sizeof(response);
+    bool success = callback && callback(w->data, w->size, response, &response_size, context);
+    
+    if (!take_mutex(d, 100)) return;
+    for (esp_dds_index_t i = 0; i < d->pending_count; i++) {
+        esp_dds_pending_t* p = &d->pending[i];
+        if (p->is_action || p->response_ready || p->sequence != w->sequence) continue;
+        
+        // Failed or destroyed services never answer, as with direct async calls
+        if (success) {
+            memcpy(p->response_data, response, response_size);
+            p->response_size = response_size;
+            p->response_ready = true;
+            notify_waitsets(d, ESP_DDS_CONDITION_RESPONSE, p->target_name_id);
+        } else {
+            remove_pending(d, i);
+        }
+        break;
+    }
+    give_mutex(d);
+}
+
+// Runs the oldest queued item whose group is free, otherwise one step of the next
+// runnable grouped action (round robin). Returns false when nothing is ready.
+static bool run_one(esp_dds_domain_t* d, uint8_t executor) {
+    if (!take_mutex(d, 100)) return false;
+    
+    for (uint8_t i = 0; i < d->work_count; i++) {
+        esp_dds_work_item_t* w = &d->work[i];
+        if (d->groups[w->group].executor != executor || !claim_group(d, w->group)) continue;
+        
+        esp_dds_work_item_t item = *w;
+        for (uint8_t j = i; j < d->work_count - 1; j++) {
+            d->work[j] = d->work[j + 1];
+        }
+        d->work_count--;
+        give_mutex(d);
+        
+        run_work_item(d, &item);
+        release_group(d, item.group);
+        return true;
+    }
+    
+    esp_dds_executor_t* e = &d->executors[executor];
+    for (esp_dds_index_t n = 0; n < d->action_count; n++) {
+        esp_dds_index_t index = (esp_dds_index_t)((e->action_cursor + n) % d->action_count);
+        esp_dds_action_t* a = &d->actions[index];
+        if (a->group == ESP_DDS_NO_GROUP || d->groups[a->group].executor != executor ||
+            a->executing || !action_runnable(a) || !claim_group(d, a->group)) {
+            continue;
+        }
+        
+        e->action_cursor = (esp_dds_index_t)(index + 1);
+        a->executing = true;
+        esp_dds_action_t copy = *a;
+        uint8_t generation = d->action_slots[index].generation;
+        give_mutex(d);
+        
+        uint8_t result[ESP_DDS_MAX_MESSAGE_SIZE];
+        size_t result_size = sizeof(result);
+        esp_dds_action_state_t state = copy.execute_callback(copy.goal_data, copy.goal_size,
+                                                             result, &result_size, copy.context);
+        
+        if (take_mutex(d, 100)) {
+            finish_action_step(d, index, generation, state, result,
+                               result_size <= sizeof(result) ? result_size : 0);
+            if (d->action_slots[index].generation == generation) {
+                d->actions[index].executing = false;
+            }
+            give_mutex(d);
+        }
+        release_group(d, copy.group);
+        return true;
+    }
+    
+    give_mutex(d);
+    return false;
+}
+
+uint16_t esp_dds_domain_executor_spin_some(esp_dds_domain_t* d, uint8_t executor) {
+    if (executor >= ESP_DDS_MAX_EXECUTORS || !take_mutex(d, 100)) return 0;
+    
+    esp_dds_executor_t* e = &d->executors[executor];
+    bool single = e->type == ESP_DDS_EXECUTOR_SINGLE_THREADED;
+    if (!e->in_use || (single && e->spinning)) {
+        give_mutex(d);
+        return 0;
+    }
+    if (single) {
+        e->spinning = true;
+    }
+    // One pass - work queued by the callbacks themselves waits for the next call
+    uint16_t budget = (uint16_t)(d->work_count + d->action_count);
+    give_mutex(d);
+    
+    uint16_t executed = 0;
+    while (executed < budget && run_one(d, executor)) {
+        executed++;
+    }
+    
+    if (single) {
+        e->spinning = false;
+    }
+    return executed;
+}
+
+#ifdef ESP_PLATFORM
+static void executor_worker(void* arg) {
+    esp_dds_executor_t* e = (esp_dds_executor_t*)arg;
+    esp_dds_domain_t* d = e->domain;
+    uint8_t id = (uint8_t)(e - d->executors);
+    
+    while (e->running) {
+        if (!esp_dds_domain_executor_spin_some(d, id)) {
+            DDS_TASK_DELAY(1);
+        }
+    }
+    __atomic_sub_fetch(&e->alive, 1, __ATOMIC_RELEASE); // Last touch of the executor
+    vTaskDelete(NULL);
+}
+#endif
+
+bool esp_dds_domain_executor_start(esp_dds_domain_t* d, uint8_t executor) {
+#ifdef ESP_PLATFORM
+    if (executor >= ESP_DDS_MAX_EXECUTORS || !take_mutex(d, 100)) return false;
+    
+    esp_dds_executor_t* e = &d->executors[executor];
+    // Workers of an earlier start still exiting would add to the new ones
+    bool ok = e->in_use && !e->running && !__atomic_load_n(&e->alive, __ATOMIC_ACQUIRE);
+    if (ok) {
+        e->running = true;
+        for (uint8_t i = 0; i < e->threads; i++) {
+            __atomic_add_fetch(&e->alive, 1, __ATOMIC_RELAXED);
+            if (xTaskCreate(executor_worker, "dds_exec", ESP_DDS_EXECUTOR_STACK_SIZE, e,
+                            ESP_DDS_EXECUTOR_PRIORITY, &e->workers[i]) != pdPASS) {
+                __atomic_sub_fetch(&e->alive, 1, __ATOMIC_RELAXED);
+                e->running = false; // Workers already created exit on their own
+                ok = false;
+                break;
+            }
+        }
+    }
+    
+    give_mutex(d);
+    return ok;
+#else
+    return false; // No worker tasks without FreeRTOS, call esp_dds_executor_spin_some
+#endif
+}
+
+// Workers finish the callback they are in and exit; stop waits for that without the
+// mutex, which the workers need to get there. Called from one of its own workers it
+// only signals, the worker exits once its callback returns.
+void esp_dds_domain_executor_stop(esp_dds_domain_t* d, uint8_t executor) {
+    if (executor >= ESP_DDS_MAX_EXECUTORS || !take_mutex(d, 100)) return;
+    
+    esp_dds_executor_t* e = &d->executors[executor];
+    e->running = false;
+    bool own = false;
+#ifdef ESP_PLATFORM
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < e->threads; i++) {
+        own |= e->workers[i] == current;
+    }
+#endif
+    give_mutex(d);
+    
+    if (own) return;
+    while (__atomic_load_n(&e->alive, __ATOMIC_ACQUIRE)) {
+        DDS_TASK_DELAY(1);
+    }
+    
+    if (!take_mutex(d, 100)) return;
+    memset(e->workers, 0, sizeof(e->workers));
+    give_mutex(d);
+}
+
+// WaitSet implementation
+// The storage may hold garbage, only a waitset already in the list is refused
+bool esp_dds_domain_waitset_init(esp_dds_domain_t* d, esp_dds_waitset_t* ws) {
+    if (!ws || !take_mutex(d, 100)) return false;
+    bool linked = false;
+    for (esp_dds_waitset_t* w = d->waitsets; w; w = w->next) {
+        linked |= (w == ws);
+    }
+    give_mutex(d);
+    if (linked) return false;
+    
+    memset(ws, 0, sizeof(*ws));
+#ifdef ESP_PLATFORM
+    ws->events = xEventGroupCreate();
+    if (!ws->events) return false;
+#elif defined(DDS_HOST)
+    pthread_mutex_init(&ws->lock, NULL);
+    pthread_cond_init(&ws->cond, NULL);
+    ws->sync_ready = true;
+#endif
+    ws->domain = d;
+    
+    if (!take_mutex(d, 100)) {
+        esp_dds_waitset_deinit(ws);
+        return false;
+    }
+    ws->next = d->waitsets;
+    d->waitsets = ws;
+    give_mutex(d);
+    return true;
+}
+
+// Removes the subscriber of a read condition. Runs under the mutex.
+static void release_condition(esp_dds_domain_t* d, esp_dds_condition_t* c) {
+    if (c->kind == ESP_DDS_CONDITION_READ) {
+        esp_dds_name_t name = esp_dds_make_name(name_str(d, c->name_id));
+        esp_dds_topic_t* t = find_topic(d, &name);
+        for (uint8_t i = 0; t && i < t->subscriber_count; i++) {
+            if (t->subscribers[i].callback == waitset_sample && t->subscribers[i].context == c) {
+                remove_subscriber(t, i);
+                break;
+            }
+        }
+    }
+    c->in_use = false;
+}
+
+void esp_dds_waitset_deinit(esp_dds_waitset_t* ws) {
+    esp_dds_domain_t* d = ws ? ws->domain : NULL;
+    if (!d) return;
+    
+    if (take_mutex(d, 1000)) {
+        for (esp_dds_waitset_t** link = &d->waitsets; *link; link = &(*link)->next) {
+            if (*link == ws) {
+                *link = ws->next;
+                break;
+            }
+        }
+        for (uint8_t i = 0; i < ESP_DDS_MAX_WAIT_CONDITIONS; i++) {
+            if (ws->conditions[i].in_use) release_condition(d, &ws->conditions[i]);
+        }
+        give_mutex(d);
+    }
+    
+#ifdef ESP_PLATFORM
+    if (ws->events) vEventGroupDelete(ws->events);
+    ws->events = NULL;
+#elif defined(DDS_HOST)
+    if (ws->sync_ready) {
+        pthread_cond_destroy(&ws->cond);
+        pthread_mutex_destroy(&ws->lock);
+        ws->sync_ready = false;
+    }
+#endif
+    ws->domain = NULL;
+}
+
+// Names are interned, so a condition can be attached before its target exists
+static uint8_t attach_condition(esp_dds_waitset_t* ws, esp_dds_condition_kind_t kind, const char* target) {
+    esp_dds_domain_t* d = ws ? ws->domain : NULL;
+    esp_dds_name_t name = { NULL, 0, 0 };
+    if (!d || (target && !(name = esp_dds_make_name(target)).length)) return ESP_DDS_NO_CONDITION;
+    if (!take_mutex(d, 100)) return ESP_DDS_NO_CONDITION;
+    
+    uint8_t id = ESP_DDS_NO_CONDITION;
+    for (uint8_t i = 0; i < ESP_DDS_MAX_WAIT_CONDITIONS; i++) {
+        if (!ws->conditions[i].in_use) {
+            id = i;
+            break;
+        }
+    }
+    
+    if (id != ESP_DDS_NO_CONDITION) {
+        esp_dds_condition_t* c = &ws->conditions[id];
+        uint16_t name_id = target ? intern_name(d, name.str, name.length) : ESP_DDS_NO_NAME;
+        bool ok = !target || name_id != ESP_DDS_NO_NAME;
+        if (ok && kind == ESP_DDS_CONDITION_READ) {
+            ok = add_subscriber(d, &name, waitset_sample, c, NULL, 0, false, ESP_DDS_NO_GROUP);
+        }
+        if (ok) {
+            c->waitset = ws;
+            c->name_id = name_id;
+            c->kind = (uint8_t)kind;
+            c->has_sample = false;
+            c->in_use = true;
+            waitset_clear(ws, 1UL << id);
+        } else {
+            id = ESP_DDS_NO_CONDITION;
+        }
+    }
+    
+    give_mutex(d);
+    return id;
+}
+
+uint8_t esp_dds_waitset_attach_topic(esp_dds_waitset_t* ws, const char* topic) {
+    return topic ? attach_condition(ws, ESP_DDS_CONDITION_READ, topic) : ESP_DDS_NO_CONDITION;
+}
+
+uint8_t esp_dds_waitset_attach_service(esp_dds_waitset_t* ws, const char* service) {
+    return service ? attach_condition(ws, ESP_DDS_CONDITION_RESPONSE, service) : ESP_DDS_NO_CONDITION;
+}
+
+uint8_t esp_dds_waitset_attach_action(esp_dds_waitset_t* ws, const char* action) {
+    return action ? attach_condition(ws, ESP_DDS_CONDITION_RESULT, action) : ESP_DDS_NO_CONDITION;
+}
+
+uint8_t esp_dds_waitset_attach_guard(esp_dds_waitset_t* ws) {
+    return attach_condition(ws, ESP_DDS_CONDITION_GUARD, NULL);
+}
+
+bool esp_dds_waitset_detach(esp_dds_waitset_t* ws, uint8_t condition) {
+    esp_dds_domain_t* d = ws ? ws->domain : NULL;
+    if (!d || condition >= ESP_DDS_MAX_WAIT_CONDITIONS || !take_mutex(d, 100)) return false;
+    
+    bool ok = ws->conditions[condition].in_use;
+    if (ok) {
+        release_condition(d, &ws->conditions[condition]);
+        waitset_clear(ws, 1UL << condition);
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Only touches the waitset, so any task may trigger a guard without the domain lock
+bool esp_dds_waitset_trigger(esp_dds_waitset_t* ws, uint8_t condition) {
+    if (!ws || !ws->domain || condition >= ESP_DDS_MAX_WAIT_CONDITIONS) return false;
+    
+    const esp_dds_condition_t* c = &ws->conditions[condition];
+    if (!c->in_use || c->kind != ESP_DDS_CONDITION_GUARD) return false;
+    
+    waitset_signal(ws, 1UL << condition);
+    return true;
+}
+
+uint32_t esp_dds_wait(esp_dds_waitset_t* ws, uint32_t timeout_ms) {
+    if (!ws || !ws->domain) return 0;
+    
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < ESP_DDS_MAX_WAIT_CONDITIONS; i++) {
+        if (ws->conditions[i].in_use) mask |= 1UL << i;
+    }
+    if (!mask) return 0;
+    
+#ifdef ESP_PLATFORM
+    TickType_t ticks = timeout_ms == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return xEventGroupWaitBits(ws->events, mask, pdTRUE, pdFALSE, ticks) & mask;
+#elif defined(DDS_HOST)
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    
+    pthread_mutex_lock(&ws->lock);
+    while (!(ws->triggered & mask)) {
+        if (pthread_cond_timedwait(&ws->cond, &ws->lock, &deadline) != 0) break;
+    }
+    uint32_t fired = ws->triggered & mask;
+    ws->triggered &= ~fired;
+    pthread_mutex_unlock(&ws->lock);
+    return fired;
+#else
+    uint32_t start = DDS_MILLIS();
+    while (!(ws->triggered & mask) && DDS_MILLIS() - start < timeout_ms) {
+        DDS_TASK_DELAY(1);
+    }
+    return __atomic_fetch_and(&ws->triggered, ~mask, __ATOMIC_SEQ_CST) & mask;
+#endif
+}
+
+// Copies the latest sample of a read condition. *size is the buffer size in, the sample size out.
+bool esp_dds_waitset_take(esp_dds_waitset_t* ws, uint8_t condition, void* data, size_t* size) {
+    esp_dds_domain_t* d = ws ? ws->domain : NULL;
+    if (!d || !data || !size || condition >= ESP_DDS_MAX_WAIT_CONDITIONS) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_condition_t* c = &ws->conditions[condition];
+    bool ok = c->in_use && c->kind == ESP_DDS_CONDITION_READ && c->has_sample && c->size <= *size;
+    if (ok) {
+        memcpy(data, c->data, c->size);
+        *size = c->size;
+        c->has_sample = false;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Transport implementation
+// Transports match by hash alone, so at most one visible topic has a given hash
+static esp_dds_topic_t* find_visible_topic(esp_dds_domain_t* d, uint32_t hash) {
+    for (esp_dds_index_t i = 0; i < d->topic_count; i++) {
+        if (d->topic_hashes[i] == hash && d->topics[i].network && d->topic_slots[i].in_use) {
+            return &d->topics[i];
+        }
+    }
+    return NULL;
+}
+
+bool esp_dds_domain_set_topic_visibility(esp_dds_domain_t* d, const char* topic, esp_dds_visibility_t visibility) {
+    esp_dds_name_t name = esp_dds_make_name(topic);
+    if (!name.length) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_or_create_topic(d, &name);
+    bool visible = (visibility != ESP_DDS_LOCAL_ONLY);
+    bool ok = t && !(visible && !t->network && find_visible_topic(d, name.hash));
+    if (ok) {
+        esp_dds_index_t index = (esp_dds_index_t)(t - d->topics);
+        if (visible && (!t->network || d->topic_info[index].visibility != visibility)) {
+            for (esp_dds_transport_t* tr = d->transports; tr; tr = tr->next) {
+                ok &= tr->ops->open_topic(tr, name_str(d, d->topic_info[index].name_id), name.hash, visibility);
+            }
+        }
+        d->topic_info[index].visibility = visibility;
+        t->network = visible;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Services and actions match by hash as well, one visible entity per hash and kind
+static esp_dds_service_t* find_visible_service(esp_dds_domain_t* d, uint32_t hash) {
+    for (esp_dds_index_t i = 0; i < d->service_count; i++) {
+        const esp_dds_service_t* s = &d->services[i];
+        if (s->name_hash == hash && s->visibility == ESP_DDS_NETWORK_VISIBLE && d->service_slots[i].in_use) {
+            return &d->services[i];
+        }
+    }
+    return NULL;
+}
+
+static esp_dds_action_t* find_visible_action(esp_dds_domain_t* d, uint32_t hash) {
+    for (esp_dds_index_t i = 0; i < d->action_count; i++) {
+        const esp_dds_action_t* a = &d->actions[i];
+        if (a->name_hash == hash && a->visibility == ESP_DDS_NETWORK_VISIBLE && d->action_slots[i].in_use) {
+            return &d->actions[i];
+        }
+    }
+    return NULL;
+}
+
+bool esp_dds_domain_set_service_visibility(esp_dds_domain_t* d, const char* service, esp_dds_visibility_t visibility) {
+    esp_dds_name_t name = esp_dds_make_name(service);
+    if (!name.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_service_t* s = find_service(d, &name);
+    esp_dds_service_t* other = find_visible_service(d, name.hash);
+    bool ok = s && !(visibility == ESP_DDS_NETWORK_VISIBLE && other && other != s);
+    if (ok) s->visibility = visibility;
+    
+    give_mutex(d);
+    return ok;
+}
+
+bool esp_dds_domain_set_action_visibility(esp_dds_domain_t* d, const char* action, esp_dds_visibility_t visibility) {
+    esp_dds_name_t name = esp_dds_make_name(action);
+    if (!name.length || !take_mutex(d, 100)) return false;
+    
+    esp_dds_action_t* a = find_action(d, &name);
+    esp_dds_action_t* other = find_visible_action(d, name.hash);
+    bool ok = a && !(visibility == ESP_DDS_NETWORK_VISIBLE && other && other != a);
+    if (ok) a->visibility = visibility;
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Calls already in flight stay, a smaller window only holds back new ones
+bool esp_dds_domain_set_remote_window(esp_dds_domain_t* d, uint8_t window) {
+    if (!window || !take_mutex(d, 100)) return false;
+    d->remote_window = window;
+    give_mutex(d);
+    return true;
+}
+
+// Opens the topics made visible before the transport was attached
+bool esp_dds_domain_attach_transport(esp_dds_domain_t* d, esp_dds_transport_t* tr) {
+    if (!tr || !tr->ops || !take_mutex(d, 100)) return false;
+    bool ok = true;
+    for (esp_dds_transport_t* t = d->transports; t; t = t->next) {
+        ok &= (t != tr);
+    }
+    if (ok) {
+        tr->domain = d;
+        tr->next = d->transports;
+        d->transports = tr;
+        for (esp_dds_index_t i = 0; i < d->topic_count; i++) {
+            if (d->topics[i].network && d->topic_slots[i].in_use) {
+                ok &= tr->ops->open_topic(tr, name_str(d, d->topic_info[i].name_id), d->topic_hashes[i],
+                                          d->topic_info[i].visibility);
+            }
+        }
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+void esp_dds_detach_transport(esp_dds_transport_t* tr) {
+    esp_dds_domain_t* d = tr ? tr->domain : NULL;
+    if (!d || !take_mutex(d, 1000)) return;
+    
+    for (esp_dds_transport_t** link = &d->transports; *link; link = &(*link)->next) {
+        if (*link == tr) {
+            *link = tr->next;
+            break;
+        }
+    }
+    tr->domain = NULL;
+    tr->next = NULL;
+    
+    // Remote goals keep running, their results have nowhere to go
+    for (esp_dds_index_t i = 0; i < d->action_count; i++) {
+        if (d->actions[i].remote == tr) d->actions[i].remote = NULL;
+    }
+    
+    give_mutex(d);
+}
+
+// Received samples reach subscribers exactly like local ones and continue to the
+// domain's other transports, so a node bridges its links
+bool esp_dds_transport_deliver(esp_dds_transport_t* tr, uint32_t topic_hash, const void* data, size_t size) {
+    esp_dds_domain_t* d = tr ? tr->domain : NULL;
+    if (!d || !data || size > ESP_DDS_MAX_SAMPLE_SIZE) return false;
+    if (!take_mutex(d, 100)) return false;
+    
+    esp_dds_topic_t* t = find_visible_topic(d, topic_hash);
+    bool ok = false;
+    if (t) {
+        tr->received++;
+        esp_dds_index_t index = (esp_dds_index_t)(t - d->topics);
+        ok = publish_topic(d, t, name_str(d, d->topic_info[index].name_id), data, size, DDS_MICROS(), tr);
+        flush_transports(d);
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// Server side: runs a network-visible service for a peer in the receiving thread, or
+// queues it for the executor of its group, and answers on the transport the request
+// came from
+static bool serve_remote_request(esp_dds_domain_t* d, esp_dds_transport_t* tr, const esp_dds_message_t* m) {
+    if (!take_mutex(d, 100)) return false;
+    tr->received++;
+    esp_dds_service_t* s = find_visible_service(d, m->target_hash);
+    esp_dds_service_cb_t callback = s ? s->callback : NULL;
+    void* context = s ? s->context : NULL;
+    if (callback && s->group != ESP_DDS_NO_GROUP) {
+        esp_dds_work_item_t* w = enqueue_work(d, s->group, m->data, m->size);
+        if (w) {
+            w->target = (esp_dds_index_t)(s - d->services);
+            w->target_generation = d->service_slots[w->target].generation;
+            w->transport = tr;
+            w->remote_id = m->id;
+            w->target_hash = m->target_hash;
+            w->kind = ESP_DDS_WORK_REMOTE_REQUEST;
+        } else {
+            esp_dds_message_t busy = { NULL, 0, m->target_hash, m->id, ESP_DDS_MESSAGE_RESPONSE, 0 };
+            tr->ops->send_message(tr, &busy);
+        }
+        give_mutex(d);
+        return w != NULL;
+    }
+    give_mutex(d);
+    if (!callback) return false;  // Another node may have it
+    
+    uint8_t response[ESP_DDS_MAX_MESSAGE_SIZE];
+    size_t response_size = sizeof(response);
+    bool ok = callback(m->data, m->size, response, &response_size, context) && response_size <= sizeof(response);
+    
+    if (!take_mutex(d, 100)) return false;
+    esp_dds_message_t reply = { response, ok ? response_size : 0, m->target_hash, m->id,
+                                ESP_DDS_MESSAGE_RESPONSE, ok };
+    bool sent = tr->ops->send_message(tr, &reply);
+    give_mutex(d);
+    return ok && sent;
+}
+
+// Server side: the goal callback decides as for a local goal, the answer goes back
+// at once. Runs under the mutex.
+static bool accept_remote_goal(esp_dds_domain_t* d, esp_dds_transport_t* tr, const esp_dds_message_t* m) {
+    esp_dds_action_t* a = find_visible_action(d, m->target_hash);
+    if (!a) return false;
+    if (a->active && a->remote == tr && a->remote_goal == m->id) {
+        // The client sent it again, the accept must have got lost
+        esp_dds_message_t reply = { NULL, 0, m->target_hash, m->id, ESP_DDS_MESSAGE_ACCEPT, 1 };
+        tr->ops->send_message(tr, &reply);
+        return true;
+    }
+    bool accepted = !a->active && a->goal_callback(m->data, m->size, a->context);
+    if (accepted) {
+        memcpy(a->goal_data, m->data, m->size);
+        a->goal_size = m->size;
+        a->active = true;
+        a->state = ESP_DDS_ACTION_ACCEPTED;
+        a->cancel_requested = false;
+        a->remote = tr;
+        a->remote_goal = m->id;
+    }
+    esp_dds_message_t reply = { NULL, 0, m->target_hash, m->id, ESP_DDS_MESSAGE_ACCEPT, accepted };
+    tr->ops->send_message(tr, &reply);
+    return accepted;
+}
+
+static bool cancel_remote_goal(esp_dds_domain_t* d, esp_dds_transport_t* tr, const esp_dds_message_t* m) {
+    for (esp_dds_index_t i = 0; i < d->action_count; i++) {
+        esp_dds_action_t* a = &d->actions[i];
+        if (a->active && a->remote == tr && a->remote_goal == m->id && a->name_hash == m->target_hash) {
+            a->cancel_requested = true;
+            if (a->cancel_callback) a->cancel_callback(a->context);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Client side: answers to this node's remote calls and goals. Late and duplicate
+// answers find no open entry and are dropped. Runs under the mutex.
+static bool complete_remote_call(esp_dds_domain_t* d, const esp_dds_message_t* m) {
+    bool is_action = (m->kind != ESP_DDS_MESSAGE_RESPONSE);
+    esp_dds_index_t i = find_remote_pending(d, is_action, m->id);
+    if (i == ESP_DDS_NO_SLOT || d->pending[i].response_ready || remote_call_expired(&d->pending[i], DDS_MILLIS())) {
+        return false;
+    }
+    
+    esp_dds_pending_t* p = &d->pending[i];
+    switch (m->kind) {
+    case ESP_DDS_MESSAGE_ACCEPT:
+        // The first answer wins, a rejection after acceptance came from another server
+        if (m->status || p->action_state != ESP_DDS_ACTION_ACCEPTED) {
+            p->action_state = ESP_DDS_ACTION_EXECUTING;
+            return true;
+        }
+        p->response_size = 0;
+        p->action_state = ESP_DDS_ACTION_ABORTED;
+        break;
+    case ESP_DDS_MESSAGE_FEEDBACK:
+        p->action_state = ESP_DDS_ACTION_EXECUTING;  // Confirms the goal if the accept got lost
+        if (p->feedback_cb) p->feedback_cb(name_str(d, p->target_name_id), m->data, m->size, p->context);
+        return true;
+    default:
+        memcpy(p->response_data, m->data, m->size);
+        p->response_size = m->size;
+        p->action_state = (esp_dds_action_state_t)m->status;
+        p->failed = (m->kind == ESP_DDS_MESSAGE_RESPONSE && !m->status);
+        break;
+    }
+    p->response_ready = true;
+    notify_waitsets(d, is_action ? ESP_DDS_CONDITION_RESULT : ESP_DDS_CONDITION_RESPONSE, p->target_name_id);
+    return true;
+}
+
+// Requests run their service unlocked, everything else is bookkeeping under the mutex
+bool esp_dds_transport_receive(esp_dds_transport_t* tr, const esp_dds_message_t* m) {
+    esp_dds_domain_t* d = tr ? tr->domain : NULL;
+    if (!d || !m || (m->size && !m->data) || m->size > ESP_DDS_MAX_MESSAGE_SIZE) return false;
+    if (m->kind == ESP_DDS_MESSAGE_REQUEST) return serve_remote_request(d, tr, m);
+    if (!take_mutex(d, 100)) return false;
+    
+    tr->received++;
+    bool ok;
+    switch (m->kind) {
+    case ESP_DDS_MESSAGE_GOAL:
+        ok = accept_remote_goal(d, tr, m);
+        break;
+    case ESP_DDS_MESSAGE_CANCEL:
+        ok = cancel_remote_goal(d, tr, m);
+        break;
+    case ESP_DDS_MESSAGE_RESPONSE:
+    case ESP_DDS_MESSAGE_ACCEPT:
+    case ESP_DDS_MESSAGE_FEEDBACK:
+    case ESP_DDS_MESSAGE_RESULT:
+        ok = complete_remote_call(d, m);
+        break;
+    default:
+        ok = false;
+        break;
+    }
+    
+    give_mutex(d);
+    return ok;
+}
+
+// A single transport blocks in its own wait, several are polled in turn. Flushing first
+// sends what a transport holds back for batching once its window has passed.
+uint16_t esp_dds_domain_process_transports(esp_dds_domain_t* d, uint32_t timeout_ms) {
+    esp_dds_transport_t* single = d->transports;
+    if (!single) return 0;
+    if (take_mutex(d, 100)) {
+        flush_transports(d);
+        give_mutex(d);
+    }
+    if (!single->next) return single->ops->poll(single, timeout_ms);
+    
+    uint16_t received = 0;
+    uint32_t start = DDS_MILLIS();
+    while (true) {
+        if (take_mutex(d, 100)) {
+            flush_transports(d);
+            give_mutex(d);
+        }
+        for (esp_dds_transport_t* tr = d->transports; tr; tr = tr->next) {
+            received += tr->ops->poll(tr, 0);
+        }
+        if (received || DDS_MILLIS() - start >= timeout_ms) break;
+        DDS_DELAY(1);
+    }
+    return received;
+}
+
+// Default domain API
+void esp_dds_init(void) {
+    esp_dds_domain_init(&default_domain);
+}
+
+void esp_dds_reset(void) {
+    esp_dds_domain_reset(&default_domain);
+}
+
+bool esp_dds_publish(const char* topic, const void* data, size_t size) {
+    return esp_dds_domain_publish(&default_domain, topic, data, size);
+}
+
+bool esp_dds_subscribe(const char* topic, esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe(&default_domain, topic, callback, context);
+}
+
+void esp_dds_unsubscribe(const char* topic, esp_dds_topic_cb_t callback) {
+    esp_dds_domain_unsubscribe(&default_domain, topic, callback);
+}
+
+bool esp_dds_publish_name(esp_dds_name_t topic, const void* data, size_t size) {
+    return esp_dds_domain_publish_name(&default_domain, topic, data, size);
+}
+
+bool esp_dds_publish_batch(const esp_dds_batch_entry_t* entries, size_t count) {
+    return esp_dds_domain_publish_batch(&default_domain, entries, count);
+}
+
+bool esp_dds_subscribe_name(esp_dds_name_t topic, esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_name(&default_domain, topic, callback, context);
+}
+
+void esp_dds_unsubscribe_name(esp_dds_name_t topic, esp_dds_topic_cb_t callback) {
+    esp_dds_domain_unsubscribe_name(&default_domain, topic, callback);
+}
+
+bool esp_dds_publish_typed(esp_dds_name_t topic, uint32_t type_hash, const void* data, size_t size) {
+    return esp_dds_domain_publish_typed(&default_domain, topic, type_hash, data, size);
+}
+
+bool esp_dds_subscribe_typed(esp_dds_name_t topic, uint32_t type_hash, esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_typed(&default_domain, topic, type_hash, callback, context);
+}
+
+bool esp_dds_subscribe_filtered(const char* topic, const esp_dds_filter_t* filter,
+                               esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_filtered(&default_domain, topic, filter, callback, context);
+}
+
+bool esp_dds_subscribe_pattern(const char* pattern, esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_pattern(&default_domain, pattern, callback, context);
+}
+
+void esp_dds_unsubscribe_pattern(const char* pattern, esp_dds_topic_cb_t callback) {
+    esp_dds_domain_unsubscribe_pattern(&default_domain, pattern, callback);
+}
+
+bool esp_dds_subscribe_rate_limited(const char* topic, uint32_t min_separation_us, bool keep_latest,
+                                   esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_rate_limited(&default_domain, topic, min_separation_us,
+                                                 keep_latest, callback, context);
+}
+
+bool esp_dds_set_topic_key(const char* topic, uint16_t key_offset, uint8_t key_width) {
+    return esp_dds_domain_set_topic_key(&default_domain, topic, key_offset, key_width);
+}
+
+bool esp_dds_read_instance(const char* topic, uint32_t key, void* data, size_t* size) {
+    return esp_dds_domain_read_instance(&default_domain, topic, key, data, size);
+}
+
+bool esp_dds_read_instance_name(esp_dds_name_t topic, uint32_t key, void* data, size_t* size) {
+    return esp_dds_domain_read_instance_name(&default_domain, topic, key, data, size);
+}
+
+bool esp_dds_subscribe_instances(const char* topic, const uint32_t* keys, uint8_t key_count,
+                                esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_instances(&default_domain, topic, keys, key_count, callback, context);
+}
+
+bool esp_dds_set_deadline(const char* topic, uint32_t period_us, uint8_t tolerance_percent,
+                         esp_dds_qos_cb_t callback, void* context) {
+    return esp_dds_domain_set_deadline(&default_domain, topic, period_us, tolerance_percent,
+                                       callback, context);
+}
+
+bool esp_dds_set_liveliness(const char* topic, uint32_t lease_us,
+                           esp_dds_qos_cb_t callback, void* context) {
+    return esp_dds_domain_set_liveliness(&default_domain, topic, lease_us, callback, context);
+}
+
+bool esp_dds_get_topic_status(const char* topic, esp_dds_topic_status_t* status) {
+    return esp_dds_domain_get_topic_status(&default_domain, topic, status);
+}
+
+esp_dds_index_t esp_dds_collect_topics(void) {
+    return esp_dds_domain_collect_topics(&default_domain);
+}
+
+uint16_t esp_dds_create_timer(uint32_t period_us, esp_dds_timer_cb_t callback, void* context) {
+    return esp_dds_domain_create_timer(&default_domain, period_us, callback, context);
+}
+
+bool esp_dds_destroy_timer(uint16_t timer) {
+    return esp_dds_domain_destroy_timer(&default_domain, timer);
+}
+
+bool esp_dds_create_service(const char* service, esp_dds_service_cb_t callback, 
+                           esp_dds_service_mode_t mode, void* context) {
+    return esp_dds_domain_create_service(&default_domain, service, callback, mode, context);
+}
+
+bool esp_dds_call_service_sync(const char* service, const void* request, size_t req_size,
+                              void* response, size_t* resp_size, uint32_t timeout_ms) {
+    return esp_dds_domain_call_service_sync(&default_domain, service, request, req_size, response,
+                                            resp_size, timeout_ms);
+}
+
+bool esp_dds_call_service_async(const char* service, const void* request, size_t req_size,
+                               esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms) {
+    return esp_dds_domain_call_service_async(&default_domain, service, request, req_size, callback,
+                                             context, timeout_ms);
+}
+
+bool esp_dds_call_service_sync_name(esp_dds_name_t service, const void* request, size_t req_size,
+                                   void* response, size_t* resp_size, uint32_t timeout_ms) {
+    return esp_dds_domain_call_service_sync_name(&default_domain, service, request, req_size,
+                                                 response, resp_size, timeout_ms);
+}
+
+bool esp_dds_call_service_async_name(esp_dds_name_t service, const void* request, size_t req_size,
+                                    esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms) {
+    return esp_dds_domain_call_service_async_name(&default_domain, service, request, req_size,
+                                                  callback, context, timeout_ms);
+}
+
+bool esp_dds_destroy_service(const char* service) {
+    return esp_dds_domain_destroy_service(&default_domain, service);
+}
+
+bool esp_dds_create_action(const char* action, esp_dds_goal_cb_t goal_cb,
+                          esp_dds_execute_cb_t execute_cb, esp_dds_cancel_cb_t cancel_cb,
+                          void* context) {
+    return esp_dds_domain_create_action(&default_domain, action, goal_cb, execute_cb, cancel_cb,
+                                        context);
+}
+
+bool esp_dds_send_goal(const char* action, const void* goal, size_t goal_size,
+                      esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                      void* context, uint32_t timeout_ms) {
+    return esp_dds_domain_send_goal(&default_domain, action, goal, goal_size, feedback_cb,
+                                    result_cb, context, timeout_ms);
+}
+
+bool esp_dds_cancel_goal(const char* action, uint32_t timeout_ms) {
+    return esp_dds_domain_cancel_goal(&default_domain, action, timeout_ms);
+}
+
+bool esp_dds_send_feedback(const char* action, const void* feedback, size_t size) {
+    return esp_dds_domain_send_feedback(&default_domain, action, feedback, size);
+}
+
+bool esp_dds_send_goal_name(esp_dds_name_t action, const void* goal, size_t goal_size,
+                           esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                           void* context, uint32_t timeout_ms) {
+    return esp_dds_domain_send_goal_name(&default_domain, action, goal, goal_size, feedback_cb,
+                                         result_cb, context, timeout_ms);
+}
+
+bool esp_dds_cancel_goal_name(esp_dds_name_t action, uint32_t timeout_ms) {
+    return esp_dds_domain_cancel_goal_name(&default_domain, action, timeout_ms);
+}
+
+bool esp_dds_send_feedback_name(esp_dds_name_t action, const void* feedback, size_t size) {
+    return esp_dds_domain_send_feedback_name(&default_domain, action, feedback, size);
+}
+
+bool esp_dds_destroy_action(const char* action) {
+    return esp_dds_domain_destroy_action(&default_domain, action);
+}
+
+void esp_dds_process_services(void) {
+    esp_dds_domain_process_services(&default_domain);
+}
+
+void esp_dds_process_actions(void) {
+    esp_dds_domain_process_actions(&default_domain);
+}
+
+void esp_dds_process_pending(uint32_t timeout_ms) {
+    esp_dds_domain_process_pending(&default_domain, timeout_ms);
+}
+
+void esp_dds_process_timers(void) {
+    esp_dds_domain_process_timers(&default_domain);
+}
+
+bool esp_dds_is_goal_canceled(const char* action) {
+    return esp_dds_domain_is_goal_canceled(&default_domain, action);
+}
+
+bool esp_dds_is_goal_canceled_name(esp_dds_name_t action) {
+    return esp_dds_domain_is_goal_canceled_name(&default_domain, action);
+}
+
+uint8_t esp_dds_create_executor(esp_dds_executor_type_t type, uint8_t threads) {
+    return esp_dds_domain_create_executor(&default_domain, type, threads);
+}
+
+uint8_t esp_dds_create_callback_group(uint8_t executor, esp_dds_group_type_t type) {
+    return esp_dds_domain_create_callback_group(&default_domain, executor, type);
+}
+
+bool esp_dds_subscribe_grouped(const char* topic, uint8_t group, esp_dds_topic_cb_t callback, void* context) {
+    return esp_dds_domain_subscribe_grouped(&default_domain, topic, group, callback, context);
+}
+
+bool esp_dds_set_service_group(const char* service, uint8_t group) {
+    return esp_dds_domain_set_service_group(&default_domain, service, group);
+}
+
+bool esp_dds_set_action_group(const char* action, uint8_t group) {
+    return esp_dds_domain_set_action_group(&default_domain, action, group);
+}
+
+bool esp_dds_set_timer_group(uint16_t timer, uint8_t group) {
+    return esp_dds_domain_set_timer_group(&default_domain, timer, group);
+}
+
+uint16_t esp_dds_executor_spin_some(uint8_t executor) {
+    return esp_dds_domain_executor_spin_some(&default_domain, executor);
+}
+
+bool esp_dds_executor_start(uint8_t executor) {
+    return esp_dds_domain_executor_start(&default_domain, executor);
+}
+
+void esp_dds_executor_stop(uint8_t executor) {
+    esp_dds_domain_executor_stop(&default_domain, executor);
+}
+
+bool esp_dds_waitset_init(esp_dds_waitset_t* waitset) {
+    return esp_dds_domain_waitset_init(&default_domain, waitset);
+}
+
+bool esp_dds_set_topic_visibility(const char* topic, esp_dds_visibility_t visibility) {
+    return esp_dds_domain_set_topic_visibility(&default_domain, topic, visibility);
+}
+
+bool esp_dds_set_service_visibility(const char* service, esp_dds_visibility_t visibility) {
+    return esp_dds_domain_set_service_visibility(&default_domain, service, visibility);
+}
+
+bool esp_dds_set_action_visibility(const char* action, esp_dds_visibility_t visibility) {
+    return esp_dds_domain_set_action_visibility(&default_domain, action, visibility);
+}
+
+bool esp_dds_set_remote_window(uint8_t window) {
+    return esp_dds_domain_set_remote_window(&default_domain, window);
+}
+
+bool esp_dds_attach_transport(esp_dds_transport_t* transport) {
+    return esp_dds_domain_attach_transport(&default_domain, transport);
+}
+
+uint16_t esp_dds_process_transports(uint32_t timeout_ms) {
+    return esp_dds_domain_process_transports(&default_domain, timeout_ms);
+}
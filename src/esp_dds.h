@@ -13,27 +13,150 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "freertos/queue.h"
+#include "freertos/event_groups.h"
 #else
 // Minimal FreeRTOS stubs for platform independence
 typedef void* TaskHandle_t;
 typedef void* SemaphoreHandle_t;
 typedef void* QueueHandle_t;
 #define portMAX_DELAY 0xFFFFFFFF
+#ifdef DDS_HOST
+#include <pthread.h>
+
+// Host builds run every caller on a single task
+static inline TaskHandle_t xTaskGetCurrentTaskHandle(void) { return NULL; }
+#endif
 #endif
 
-// Configuration - completely static allocation
+// Configuration - completely static allocation. Every limit can be overridden from
+// the build flags (e.g. -DESP_DDS_MAX_TOPICS=512) and must be the same in every file.
+#ifndef ESP_DDS_MAX_TOPICS
 #define ESP_DDS_MAX_TOPICS 32
-#define ESP_DDS_MAX_SERVICES 24  
+#endif
+#ifndef ESP_DDS_MAX_SERVICES
+#define ESP_DDS_MAX_SERVICES 24
+#endif
+#ifndef ESP_DDS_MAX_ACTIONS
 #define ESP_DDS_MAX_ACTIONS 16
-#define ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC 8
+#endif
+#ifndef ESP_DDS_MAX_PENDING
+#define ESP_DDS_MAX_PENDING ESP_DDS_MAX_ACTIONS  // Outstanding async calls and goals
+#endif
+#ifndef ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC
+#define ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC 8      // Max 255
+#endif
+#ifndef ESP_DDS_MAX_MESSAGE_SIZE
 #define ESP_DDS_MAX_MESSAGE_SIZE 256
+#endif
+// Topic samples may be larger than messages (map tiles, calibration blobs). Those reach
+// subscribers called in the publishing thread and transports only, executor queues,
+// keep-latest holds and read conditions copy at most ESP_DDS_MAX_MESSAGE_SIZE.
+#ifndef ESP_DDS_MAX_SAMPLE_SIZE
+#define ESP_DDS_MAX_SAMPLE_SIZE ESP_DDS_MAX_MESSAGE_SIZE
+#endif
 #define ESP_DDS_MAX_NAME_LENGTH 48
 #define ESP_DDS_MIN_NAME_LENGTH 2
+#ifndef ESP_DDS_NAME_ARENA_SIZE
+#define ESP_DDS_NAME_ARENA_SIZE 1536      // Interned entity and pattern names, max 65535
+#endif
+#define ESP_DDS_NO_NAME 0xFFFF
+#ifndef ESP_DDS_MAX_FILTERS
+#define ESP_DDS_MAX_FILTERS 16            // Unique content filters, max 32
+#endif
+#define ESP_DDS_MAX_FILTER_CONDITIONS 4
+#define ESP_DDS_NO_FILTER 0xFF
+#ifndef ESP_DDS_MAX_RATE_LIMITS
+#define ESP_DDS_MAX_RATE_LIMITS 8         // Rate-limited subscriptions
+#endif
+#ifndef ESP_DDS_MAX_HELD_SAMPLES
+#define ESP_DDS_MAX_HELD_SAMPLES 4        // Keep-latest buffers for rate-limited subscriptions
+#endif
+#define ESP_DDS_NO_RATE_LIMIT 0xFF
+#ifndef ESP_DDS_MAX_WILDCARD_SUBS
+#define ESP_DDS_MAX_WILDCARD_SUBS 8       // Pattern subscriptions, max 32
+#endif
+#define ESP_DDS_NO_WILDCARD 0xFF
+#ifndef ESP_DDS_MAX_TRIE_NODES
+#define ESP_DDS_MAX_TRIE_NODES 32         // Pattern segments shared between patterns
+#endif
+#define ESP_DDS_TRIE_NONE 0xFF
+#ifndef ESP_DDS_MAX_INSTANCES
+#define ESP_DDS_MAX_INSTANCES 24          // Cached instances of all keyed topics, max 254
+#endif
+#ifndef ESP_DDS_MAX_INSTANCE_SIZE
+#define ESP_DDS_MAX_INSTANCE_SIZE 64      // Largest sample of a keyed topic
+#endif
+#define ESP_DDS_NO_INSTANCE 0xFF
+#ifndef ESP_DDS_MAX_KEY_SETS
+#define ESP_DDS_MAX_KEY_SETS 8            // Subscriptions restricted to some instances
+#endif
+#define ESP_DDS_MAX_SET_KEYS 8            // Keys per restricted subscription
+#define ESP_DDS_NO_KEY_SET 0xFF
+#ifndef ESP_DDS_MAX_EXECUTORS
+#define ESP_DDS_MAX_EXECUTORS 2
+#endif
+#ifndef ESP_DDS_MAX_CALLBACK_GROUPS
+#define ESP_DDS_MAX_CALLBACK_GROUPS 8
+#endif
+#ifndef ESP_DDS_MAX_EXECUTOR_THREADS
+#define ESP_DDS_MAX_EXECUTOR_THREADS 4    // Worker tasks of one multi-threaded executor
+#endif
+#ifndef ESP_DDS_MAX_QUEUED_WORK
+#define ESP_DDS_MAX_QUEUED_WORK 8         // Samples and requests waiting for an executor
+#endif
+#ifndef ESP_DDS_REMOTE_WINDOW
+#define ESP_DDS_REMOTE_WINDOW 8           // Remote calls in flight per service, changeable per domain
+#endif
+#ifndef ESP_DDS_REMOTE_TIMEOUT_MS
+#define ESP_DDS_REMOTE_TIMEOUT_MS 1000    // Remote async calls and goals sent with a timeout of 0
+#endif
+#ifndef ESP_DDS_REMOTE_RETRY_MS
+#define ESP_DDS_REMOTE_RETRY_MS 20        // An unconfirmed remote goal goes out again this often
+#endif
+#ifndef ESP_DDS_EXECUTOR_STACK_SIZE
+#define ESP_DDS_EXECUTOR_STACK_SIZE 4096
+#endif
+#ifndef ESP_DDS_EXECUTOR_PRIORITY
+#define ESP_DDS_EXECUTOR_PRIORITY 5
+#endif
+#define ESP_DDS_NO_EXECUTOR 0xFF
+#define ESP_DDS_NO_GROUP 0xFF
+
+// Topic, service, action and pending indices - 8-bit unless a limit above 254 (or
+// ESP_DDS_WIDE_INDEX, for domains larger than the default one) needs 16-bit
+#if defined(ESP_DDS_WIDE_INDEX) || ESP_DDS_MAX_TOPICS > 254 || ESP_DDS_MAX_SERVICES > 254 || \
+    ESP_DDS_MAX_ACTIONS > 254 || ESP_DDS_MAX_PENDING > 254
+typedef uint16_t esp_dds_index_t;
+#define ESP_DDS_NO_SLOT 0xFFFF
+#else
+typedef uint8_t esp_dds_index_t;
+#define ESP_DDS_NO_SLOT 0xFF
+#endif
+
+// Hierarchical timer wheel for QoS monitoring (deadline, liveliness) and timers.
+// Level n slots span 64^n ticks: 65 ms, 4.2 s and 268 s with 1024 us ticks.
+#define ESP_DDS_TIMER_WHEEL_BITS 6
+#define ESP_DDS_TIMER_WHEEL_SLOTS (1 << ESP_DDS_TIMER_WHEEL_BITS)  // Per level
+#define ESP_DDS_TIMER_WHEEL_LEVELS 3
+#define ESP_DDS_TIMER_TICK_SHIFT 10      // 1 tick = 1024 us
+#define ESP_DDS_TIMER_NONE 0xFFFF
+#ifndef ESP_DDS_MAX_TIMERS
+#define ESP_DDS_MAX_TIMERS 16             // Library timers per domain
+#endif
+#ifndef ESP_DDS_MAX_TIMER_BATCH
+#define ESP_DDS_MAX_TIMER_BATCH 16        // Timer callbacks per esp_dds_process_timers call
+#endif
+#define ESP_DDS_NO_TIMER 0xFFFF
+#ifndef ESP_DDS_MAX_WAIT_CONDITIONS
+#define ESP_DDS_MAX_WAIT_CONDITIONS 8     // Per waitset, max 24 (event group bits)
+#endif
+#define ESP_DDS_NO_CONDITION 0xFF
 
 // Communication visibility
 typedef enum {
     ESP_DDS_LOCAL_ONLY,
-    ESP_DDS_NETWORK_VISIBLE
+    ESP_DDS_NETWORK_VISIBLE,
+    ESP_DDS_NETWORK_RELIABLE       // Topics: visible, lost samples resent where the transport can
 } esp_dds_visibility_t;
 
 // Service modes
@@ -51,6 +174,47 @@ typedef enum {
     ESP_DDS_ACTION_ABORTED
 } esp_dds_action_state_t;
 
+// QoS events reported by the timer wheel check
+typedef enum {
+    ESP_DDS_QOS_DEADLINE_MISSED,
+    ESP_DDS_QOS_LIVELINESS_LOST,
+    ESP_DDS_QOS_LIVELINESS_RESTORED
+} esp_dds_qos_event_t;
+
+// Content filter comparisons (field OP value)
+typedef enum {
+    ESP_DDS_FILTER_EQ,
+    ESP_DDS_FILTER_NE,
+    ESP_DDS_FILTER_LT,
+    ESP_DDS_FILTER_LE,
+    ESP_DDS_FILTER_GT,
+    ESP_DDS_FILTER_GE,
+    ESP_DDS_FILTER_MASK_ANY,   // (field & value) != 0
+    ESP_DDS_FILTER_CHANGED     // field differs from the previous sample, value unused
+} esp_dds_filter_op_t;
+
+// WaitSet conditions
+typedef enum {
+    ESP_DDS_CONDITION_READ,       // A sample arrived on a topic, esp_dds_waitset_take reads it
+    ESP_DDS_CONDITION_RESPONSE,   // An async call to a service has its response ready
+    ESP_DDS_CONDITION_RESULT,     // A goal sent to an action has its result ready
+    ESP_DDS_CONDITION_GUARD       // Triggered by esp_dds_waitset_trigger from any task
+} esp_dds_condition_kind_t;
+
+// Executor threading (like ROS2 SingleThreadedExecutor / MultiThreadedExecutor)
+typedef enum {
+    ESP_DDS_EXECUTOR_SINGLE_THREADED,  // One callback at a time
+    ESP_DDS_EXECUTOR_MULTI_THREADED    // Worker pool, concurrency limited by callback groups
+} esp_dds_executor_type_t;
+
+// Callback groups (like ROS2) - which callbacks of an executor may overlap
+typedef enum {
+    ESP_DDS_GROUP_MUTUALLY_EXCLUSIVE,  // Never two callbacks of the group at once
+    ESP_DDS_GROUP_REENTRANT            // Any callbacks in parallel, even the same one
+} esp_dds_group_type_t;
+
+#define ESP_DDS_FILTER_SIGNED 0x80  // OR into op to compare as signed integers
+
 // Callback types
 typedef void (*esp_dds_topic_cb_t)(const char* topic, const void* data, size_t size, void* context);
 typedef bool (*esp_dds_service_cb_t)(const void* request, size_t req_size, void* response, size_t* resp_size, void* context);
@@ -60,26 +224,184 @@ typedef esp_dds_action_state_t (*esp_dds_execute_cb_t)(const void* goal, size_t
 typedef void (*esp_dds_cancel_cb_t)(void* context);
 typedef void (*esp_dds_feedback_cb_t)(const char* action, const void* feedback, size_t size, void* context);
 typedef void (*esp_dds_result_cb_t)(const char* action, const void* result, size_t size, esp_dds_action_state_t state, void* context);
+typedef void (*esp_dds_qos_cb_t)(const char* topic, esp_dds_qos_event_t event, uint32_t count, void* context);
+typedef bool (*esp_dds_filter_cb_t)(const void* data, size_t size, void* context);
+typedef void (*esp_dds_timer_cb_t)(uint32_t late_us, void* context);  // late_us >= period: ticks were skipped
+
+// Content filter - all conditions must pass, then the optional predicate
+typedef struct {
+    uint16_t offset;   // Byte offset of the field in the sample
+    uint8_t width;     // 1, 2 or 4 bytes
+    uint8_t op;        // esp_dds_filter_op_t, optionally | ESP_DDS_FILTER_SIGNED
+    uint32_t value;
+} esp_dds_filter_cond_t;
+
+typedef struct {
+    esp_dds_filter_cond_t conditions[ESP_DDS_MAX_FILTER_CONDITIONS];
+    uint8_t condition_count;
+    esp_dds_filter_cb_t predicate;
+    void* predicate_context;
+} esp_dds_filter_t;
+
+#define ESP_DDS_FILTER_FIELD(type, field, op, value) \
+    { (uint16_t)offsetof(type, field), (uint8_t)sizeof(((type*)0)->field), (uint8_t)(op), (uint32_t)(value) }
+
+// Validated entity name with its precomputed hash, length 0 = invalid
+typedef struct {
+    const char* str;
+    uint32_t hash;
+    uint8_t length;
+} esp_dds_name_t;
+
+#define ESP_DDS_NAME_HASH_SEED 2166136261UL   // FNV-1a
+#define ESP_DDS_NAME_HASH_PRIME 16777619UL
 
 // Core structures
 typedef struct {
-    char name[ESP_DDS_MAX_NAME_LENGTH];
-    esp_dds_topic_cb_t callbacks[ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC];
-    void* contexts[ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC];
+    uint32_t period_us;            // Expected publish period, 0 = deadline disabled
+    uint32_t deadline_us;          // Period plus tolerance
+    uint32_t deadline_base_us;     // Start of the window currently being monitored
+    uint32_t deadline_seen_us;     // last_publish_us at the previous check, a change is a new sample
+    uint32_t lease_us;             // Liveliness lease, 0 = liveliness disabled
+    uint32_t liveliness_base_us;
+    uint32_t liveliness_seen_us;
+    uint32_t deadline_missed;
+    uint32_t liveliness_lost;
+    esp_dds_qos_cb_t callback;
+    void* context;
+    bool alive;
+} esp_dds_topic_qos_t;
+
+// Subscriber entry - callback, context and slots packed so delivery reads one record
+typedef struct {
+    esp_dds_topic_cb_t callback;
+    void* context;
+    uint8_t filter;                // Filter slot, ESP_DDS_NO_FILTER if none
+    uint8_t rate_limit;            // Rate limit slot, ESP_DDS_NO_RATE_LIMIT if none
+    uint8_t group;                 // Callback group, ESP_DDS_NO_GROUP = deliver in publish
+    uint8_t key_set;               // Key set slot, ESP_DDS_NO_KEY_SET = every instance
+    uint8_t wildcard;              // Pattern subscription it came from, ESP_DDS_NO_WILDCARD if explicit
+} esp_dds_subscriber_t;
+
+// Slot bookkeeping for entity tables that support removal. References held across
+// unlocked sections (pending calls, running goals) store index plus generation.
+typedef struct {
+    uint8_t generation;    // Bumped on every destroy, stale references compare unequal
+    esp_dds_index_t next_free; // Free list link, ESP_DDS_NO_SLOT at the tail
+    bool in_use;
+} esp_dds_slot_t;
+
+// Hot topic state - all that publish touches after the hash lookup. Names and
+// QoS live in esp_dds_topic_info_t, the hashes in their own dense array.
+typedef struct {
     uint8_t subscriber_count;
-    esp_dds_visibility_t visibility;
+    uint8_t key_width;             // Keyed topic: 1, 2 or 4 byte key, 0 = not keyed
+    bool network;                  // Network visible: samples also go to the transports
+    volatile uint32_t last_publish_us; // Only QoS-related work done by publish
+    esp_dds_subscriber_t* subscribers; // max_subscribers entries in the domain's pool
 } esp_dds_topic_t;
 
+// Cold topic state - setup, QoS timers and diagnostics
 typedef struct {
-    char name[ESP_DDS_MAX_NAME_LENGTH];
+    uint16_t name_id;              // Offset of the interned name in the name arena
+    uint16_t key_offset;           // Byte offset of the key in a sample of a keyed topic
+    uint8_t first_instance;        // Instance list of a keyed topic, ESP_DDS_NO_INSTANCE if empty
+    uint32_t type_hash;            // Message type of a typed topic, 0 = not bound
+    esp_dds_visibility_t visibility;
+    esp_dds_topic_qos_t qos;
+} esp_dds_topic_info_t;
+
+// Last sample of one key of a keyed topic
+typedef struct {
+    uint32_t key;
+    uint32_t publish_us;
+    size_t size;
+    esp_dds_index_t topic_index;
+    uint8_t next;                  // Next instance of the same topic
+    bool in_use;
+    uint8_t data[ESP_DDS_MAX_INSTANCE_SIZE];
+} esp_dds_instance_t;
+
+// Keys a restricted subscriber receives
+typedef struct {
+    uint32_t keys[ESP_DDS_MAX_SET_KEYS];
+    uint8_t count;
+    bool in_use;
+} esp_dds_key_set_t;
+
+// Shared content filter, deduplicated across subscribers of the same topic
+typedef struct {
+    esp_dds_filter_t filter;
+    uint32_t last_values[ESP_DDS_MAX_FILTER_CONDITIONS]; // State for ESP_DDS_FILTER_CHANGED
+    esp_dds_index_t topic_index;
+    uint8_t refs;
+    bool primed;
+} esp_dds_filter_slot_t;
+
+// Time-based filter (minimum separation) of one subscriber
+typedef struct {
+    uint32_t min_separation_us;
+    uint32_t last_delivery_us;
+    esp_dds_index_t topic_index;
+    uint8_t held;        // Held sample slot for keep-latest, ESP_DDS_NO_RATE_LIMIT if none
+    bool in_use;
+} esp_dds_rate_limit_t;
+
+// Most recent sample suppressed by a keep-latest rate limit
+typedef struct {
+    uint8_t data[ESP_DDS_MAX_MESSAGE_SIZE];
+    size_t size;
+    bool pending;
+    bool in_use;
+} esp_dds_held_sample_t;
+
+// Segment trie over wildcard patterns ("*" = one segment, "#" = any remaining segments)
+typedef struct {
+    uint32_t hash;          // FNV-1a of the segment text
+    uint8_t length;
+    uint8_t first_child;
+    uint8_t next_sibling;
+    uint8_t refs;           // Patterns passing through this node, 0 = free
+} esp_dds_trie_node_t;
+
+typedef struct {
+    uint16_t pattern_id;    // Interned pattern text
+    esp_dds_topic_cb_t callback;
+    void* context;
+    uint8_t node;           // Terminal trie node
+    bool in_use;
+} esp_dds_wildcard_sub_t;
+
+// One sample of a batch publish - build with ESP_DDS_BATCH_ENTRY so names hash at compile time
+typedef struct {
+    esp_dds_name_t topic;
+    const void* data;
+    size_t size;
+} esp_dds_batch_entry_t;
+
+// Topic QoS status snapshot
+typedef struct {
+    uint32_t last_publish_us;
+    uint32_t deadline_missed;
+    uint32_t liveliness_lost;
+    bool alive;
+} esp_dds_topic_status_t;
+
+typedef struct esp_dds_transport_s esp_dds_transport_t;
+
+typedef struct {
+    uint16_t name_id;
+    uint32_t name_hash;
     esp_dds_service_cb_t callback;
     esp_dds_service_mode_t mode;
     void* context;
     esp_dds_visibility_t visibility;
+    uint8_t group;                 // Callback group, ESP_DDS_NO_GROUP = caller's thread
 } esp_dds_service_t;
 
 typedef struct {
-    char name[ESP_DDS_MAX_NAME_LENGTH];
+    uint16_t name_id;
+    uint32_t name_hash;
     esp_dds_goal_cb_t goal_callback;
     esp_dds_execute_cb_t execute_callback;
     esp_dds_cancel_cb_t cancel_callback;
@@ -90,46 +412,379 @@ typedef struct {
     uint8_t goal_data[ESP_DDS_MAX_MESSAGE_SIZE];
     size_t goal_size;
     esp_dds_visibility_t visibility;
+    uint8_t group;                 // Callback group, ESP_DDS_NO_GROUP = esp_dds_process_actions
+    bool executing;                // An executor worker is inside execute_callback
+    esp_dds_transport_t* remote;   // Transport the active goal came from, NULL if local
+    uint32_t remote_goal;          // Client's goal id of a remote goal
 } esp_dds_action_t;
 
 // Pending requests for async operations
 typedef struct {
-    char target_name[ESP_DDS_MAX_NAME_LENGTH];
+    uint16_t target_name_id;       // Interned target name, outlives the target
+    esp_dds_index_t target_index;  // Service or action slot, by is_action
+    uint8_t target_generation;     // Slot generation when the call was made
     TaskHandle_t caller_task;
     union {
         esp_dds_async_cb_t async_cb;
-        esp_dds_feedback_cb_t feedback_cb;
         esp_dds_result_cb_t result_cb;
     } callback;
+    esp_dds_feedback_cb_t feedback_cb;
     void* context;
     uint8_t response_data[ESP_DDS_MAX_MESSAGE_SIZE];
     size_t response_size;
     esp_dds_action_state_t action_state;
+    uint16_t sequence;             // Matches a queued or remote request to its pending entry
+    uint32_t deadline_ms;          // Remote async service call or unconfirmed goal gives up here
+    uint32_t retry_ms;             // Unconfirmed remote goal goes out again here
     bool response_ready;
     bool is_action;
+    bool remote;                   // Target lives on another node, target_index is unused
+    bool sync;                     // A blocked caller collects it, esp_dds_process_pending skips it
+    bool failed;                   // Remote service refused or missing, no callback runs
 } esp_dds_pending_t;
 
-// Main DDS context
+// Interned names - NUL-terminated strings appended once and shared by every
+// entity with the same name. Storage is never reclaimed until reset.
+typedef struct {
+    char* data;
+    uint16_t size;
+    uint16_t used;
+} esp_dds_name_arena_t;
+
+// Timer wheel nodes - one per monitored QoS (deadline, liveliness) per topic, then one
+// per rate limit for flushing keep-latest samples, then one per library timer
+typedef struct {
+    uint32_t expiry_us;
+    uint16_t next;
+    uint16_t prev;                 // ESP_DDS_TIMER_NONE at the head of the slot list
+    uint8_t slot;                  // level * ESP_DDS_TIMER_WHEEL_SLOTS + slot
+    bool armed;
+} esp_dds_timer_node_t;
+
+typedef struct {
+    uint16_t slots[ESP_DDS_TIMER_WHEEL_LEVELS * ESP_DDS_TIMER_WHEEL_SLOTS];
+    esp_dds_timer_node_t* nodes;   // max_topics * 2 + ESP_DDS_MAX_RATE_LIMITS + max_timers entries
+    uint32_t last_tick;            // Tick being processed, earlier ticks are done; wraps with the clock
+} esp_dds_timer_wheel_t;
+
+// Periodic library timer, re-armed from its schedule so it never drifts
 typedef struct {
-    esp_dds_topic_t topics[ESP_DDS_MAX_TOPICS];
-    esp_dds_service_t services[ESP_DDS_MAX_SERVICES];
-    esp_dds_action_t actions[ESP_DDS_MAX_ACTIONS];
-    esp_dds_pending_t pending[ESP_DDS_MAX_ACTIONS]; // Reuse for both services and actions
+    esp_dds_timer_cb_t callback;
+    void* context;
+    uint32_t period_us;
+    uint32_t expected_us;          // Scheduled time of the next callback
+    uint8_t group;                 // Callback group, ESP_DDS_NO_GROUP = esp_dds_process_timers
+    bool in_use;
+} esp_dds_timer_t;
+
+typedef struct esp_dds_domain_s esp_dds_domain_t;
+
+typedef enum {
+    ESP_DDS_WORK_SAMPLE,
+    ESP_DDS_WORK_REQUEST,
+    ESP_DDS_WORK_TIMER,           // data holds the scheduled time
+    ESP_DDS_WORK_REMOTE_REQUEST   // A peer's request, answered on its transport
+} esp_dds_work_kind_t;
+
+// Sample, service request or timer tick queued for an executor. Samples and ticks carry
+// their callback, requests the service slot so a destroyed service is detected.
+typedef struct {
+    union {
+        esp_dds_topic_cb_t sample;
+        esp_dds_timer_cb_t timer;
+    } callback;
+    void* context;
+    size_t size;
+    uint16_t name_id;              // Topic name of a sample
+    uint16_t sequence;             // Pending entry of a service request
+    esp_dds_index_t target;        // Service slot of a request
+    uint8_t target_generation;
+    uint8_t group;
+    uint8_t kind;                  // esp_dds_work_kind_t
+    esp_dds_transport_t* transport;  // Peer of a remote request
+    uint32_t remote_id;
+    uint32_t target_hash;
+    uint8_t data[ESP_DDS_MAX_MESSAGE_SIZE];
+} esp_dds_work_item_t;
+
+typedef struct {
+    esp_dds_domain_t* domain;      // For worker tasks
+    esp_dds_executor_type_t type;
+    uint8_t threads;
+    esp_dds_index_t action_cursor; // Round-robin start of the action scan
+    TaskHandle_t workers[ESP_DDS_MAX_EXECUTOR_THREADS];
+    volatile bool spinning;        // Single-threaded: some thread is inside spin_some
+    volatile bool running;         // Worker tasks keep spinning
+    uint8_t alive;                 // Worker tasks not yet exited, stop waits for zero
+    bool in_use;
+} esp_dds_executor_t;
+
+typedef struct {
+    uint8_t executor;
+    esp_dds_group_type_t type;
+    volatile bool busy;            // Mutually exclusive group has a callback running
+    bool in_use;
+} esp_dds_callback_group_t;
+
+typedef struct esp_dds_waitset_s esp_dds_waitset_t;
+
+// One attached condition. A read condition is a subscriber of its topic that keeps
+// the latest sample (depth 1), responses and results are matched by target name.
+typedef struct {
+    esp_dds_waitset_t* waitset;    // Subscriber context of a read condition
+    uint16_t name_id;              // Topic, service or action, ESP_DDS_NO_NAME for guards
+    uint8_t kind;                  // esp_dds_condition_kind_t
+    bool has_sample;
+    bool in_use;
+    size_t size;
+    uint8_t data[ESP_DDS_MAX_MESSAGE_SIZE];
+} esp_dds_condition_t;
+
+// Set of conditions one task blocks on. Condition n fires bit n, so a wait reports
+// exactly which conditions became ready. Lives in caller storage, linked into its
+// domain from esp_dds_waitset_init until esp_dds_waitset_deinit.
+struct esp_dds_waitset_s {
+    esp_dds_domain_t* domain;
+    esp_dds_waitset_t* next;       // Domain's waitset list
+    esp_dds_condition_t conditions[ESP_DDS_MAX_WAIT_CONDITIONS];
+#ifdef ESP_PLATFORM
+    EventGroupHandle_t events;
+#else
+    volatile uint32_t triggered;
+#ifdef DDS_HOST
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool sync_ready;
+#endif
+#endif
+};
+
+// Service and action traffic between nodes. The id is chosen by the client and ties a
+// request to its response, and a goal to its acceptance, feedback, result and cancel.
+// A transport on a shared medium may widen the ids of incoming requests, goals and
+// cancels with the sender's address; servers echo them unchanged in their answers.
+typedef enum {
+    ESP_DDS_MESSAGE_REQUEST,
+    ESP_DDS_MESSAGE_RESPONSE,      // status 1 = served, 0 = failed
+    ESP_DDS_MESSAGE_GOAL,
+    ESP_DDS_MESSAGE_ACCEPT,        // status 1 = goal accepted, 0 = rejected
+    ESP_DDS_MESSAGE_FEEDBACK,
+    ESP_DDS_MESSAGE_RESULT,        // status = esp_dds_action_state_t
+    ESP_DDS_MESSAGE_CANCEL
+} esp_dds_message_kind_t;
+
+typedef struct {
+    const void* data;
+    size_t size;
+    uint32_t target_hash;          // Service or action name hash
+    uint32_t id;
+    uint8_t kind;                  // esp_dds_message_kind_t
+    uint8_t status;
+} esp_dds_message_t;
+
+// Transport hooks. open_topic, send, flush and send_message run under the domain mutex
+// and must not block: open_topic when a topic becomes network visible or changes between
+// visible and reliable, send for every sample
+// of such a topic, flush after each publish call so a transport can batch the samples
+// of one call, send_message for service and action traffic. flush and send_message may
+// be NULL, a transport without send_message carries topics only. poll runs unlocked
+// from esp_dds_process_transports, hands what arrived to esp_dds_transport_deliver and
+// esp_dds_transport_receive and returns the number of samples and messages handled.
+typedef struct {
+    bool (*open_topic)(esp_dds_transport_t* transport, const char* topic, uint32_t hash,
+                       esp_dds_visibility_t visibility);
+    bool (*send)(esp_dds_transport_t* transport, const char* topic, uint32_t hash,
+                 const void* data, size_t size, uint32_t publish_us);
+    void (*flush)(esp_dds_transport_t* transport);
+    bool (*send_message)(esp_dds_transport_t* transport, const esp_dds_message_t* message);
+    uint16_t (*poll)(esp_dds_transport_t* transport, uint32_t timeout_ms);
+} esp_dds_transport_ops_t;
+
+// Common part of every transport, the first member of its state. Lives in caller
+// storage, linked into its domain by esp_dds_attach_transport.
+struct esp_dds_transport_s {
+    const esp_dds_transport_ops_t* ops;
+    esp_dds_domain_t* domain;
+    esp_dds_transport_t* next;     // Domain's transport list
+    uint32_t sent;
+    uint32_t received;
+    uint32_t dropped;              // Samples send refused
+};
+
+// DDS domain - an independent instance with its own tables, lock and limits.
+// Sized tables live in static storage declared by ESP_DDS_DOMAIN_DEFINE.
+struct esp_dds_domain_s {
+    uint32_t* topic_hashes;             // Hot: scanned by every lookup
+    esp_dds_topic_t* topics;            // Hot: subscriber lists
+    esp_dds_subscriber_t* subscribers;  // max_topics * max_subscribers entries
+    esp_dds_topic_info_t* topic_info;   // Cold: names, visibility, QoS
+    esp_dds_slot_t* topic_slots;
+    esp_dds_service_t* services;
+    esp_dds_slot_t* service_slots;
+    esp_dds_action_t* actions;
+    esp_dds_slot_t* action_slots;
+    esp_dds_pending_t* pending;         // Reuse for both services and actions
+    esp_dds_timer_t* timers;
+    esp_dds_name_arena_t names;
+    esp_dds_timer_wheel_t wheel;
+    esp_dds_index_t max_topics;
+    esp_dds_index_t max_services;
+    esp_dds_index_t max_actions;
+    esp_dds_index_t max_pending;
+    uint8_t max_subscribers;
+    uint16_t max_timers;
+    
+    esp_dds_filter_slot_t filters[ESP_DDS_MAX_FILTERS];
+    esp_dds_rate_limit_t rate_limits[ESP_DDS_MAX_RATE_LIMITS];
+    esp_dds_held_sample_t held_samples[ESP_DDS_MAX_HELD_SAMPLES];
+    esp_dds_trie_node_t trie_nodes[ESP_DDS_MAX_TRIE_NODES];
+    esp_dds_wildcard_sub_t wildcard_subs[ESP_DDS_MAX_WILDCARD_SUBS];
+    uint8_t trie_root;
+    esp_dds_instance_t instances[ESP_DDS_MAX_INSTANCES];
+    esp_dds_key_set_t key_sets[ESP_DDS_MAX_KEY_SETS];
+    
+    esp_dds_executor_t executors[ESP_DDS_MAX_EXECUTORS];
+    esp_dds_callback_group_t groups[ESP_DDS_MAX_CALLBACK_GROUPS];
+    esp_dds_work_item_t work[ESP_DDS_MAX_QUEUED_WORK];  // FIFO shared by all executors
+    uint8_t work_count;
+    uint8_t remote_window;              // Remote calls in flight per service
+    uint16_t next_sequence;
+    esp_dds_waitset_t* waitsets;        // Notified when responses and results are ready
+    esp_dds_transport_t* transports;    // Carry network-visible topics
+    
+    // Counts are high-water marks, destroyed slots go to the free lists
+    esp_dds_index_t free_topic;
+    esp_dds_index_t free_service;
+    esp_dds_index_t free_action;
     
-    uint8_t topic_count;
-    uint8_t service_count;
-    uint8_t action_count;
-    uint8_t pending_count;
+    esp_dds_index_t topic_count;
+    esp_dds_index_t service_count;
+    esp_dds_index_t action_count;
+    esp_dds_index_t pending_count;
     
     SemaphoreHandle_t mutex;
     TaskHandle_t processor_task;
     bool running;
-} esp_dds_context_t;
+};
+
+typedef esp_dds_domain_t esp_dds_context_t;
+
+// Wheel nodes of a domain, ids must stay below ESP_DDS_TIMER_NONE
+#define ESP_DDS_TIMER_NODES(topics, timers) ((topics) * 2 + ESP_DDS_MAX_RATE_LIMITS + (timers))
+
+// Entity tables stay below ESP_DDS_NO_SLOT entries
+#define ESP_DDS_DOMAIN_LIMITS_VALID(topics, services, actions, pending, subscribers, timers, name_bytes) \
+    ((topics) >= 1 && (topics) < ESP_DDS_NO_SLOT && \
+     (timers) >= 1 && ESP_DDS_TIMER_NODES(topics, timers) < ESP_DDS_TIMER_NONE && \
+     (services) >= 1 && (services) < ESP_DDS_NO_SLOT && \
+     (actions) >= 1 && (actions) < ESP_DDS_NO_SLOT && \
+     (pending) >= 1 && (pending) < ESP_DDS_NO_SLOT && \
+     (subscribers) >= 1 && (subscribers) <= 255 && \
+     (name_bytes) >= 1 && (name_bytes) < ESP_DDS_NO_NAME)
+
+// Declares a domain and its static tables with ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC
+// subscribers per topic, ESP_DDS_MAX_TIMERS timers and one pending entry per action. Entity limits are 1..254
+// each (more with 16-bit indices), name_bytes up to 65535. Call
+// ESP_DDS_DOMAIN_INIT(&name) before use. C++ code can size every table with
+// esp_dds::Context<Config> from esp_dds_context.h instead.
+#define ESP_DDS_DOMAIN_DEFINE(name, topics, services, actions, name_bytes) \
+    typedef char name##_limits_check[ESP_DDS_DOMAIN_LIMITS_VALID(topics, services, actions, \
+        actions, ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC, ESP_DDS_MAX_TIMERS, name_bytes) ? 1 : -1]; \
+    static uint32_t name##_topic_hashes[topics]; \
+    static esp_dds_topic_t name##_topics[topics]; \
+    static esp_dds_subscriber_t name##_subscribers[(topics) * ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC]; \
+    static esp_dds_topic_info_t name##_topic_info[topics]; \
+    static esp_dds_slot_t name##_topic_slots[topics]; \
+    static esp_dds_service_t name##_services[services]; \
+    static esp_dds_slot_t name##_service_slots[services]; \
+    static esp_dds_action_t name##_actions[actions]; \
+    static esp_dds_slot_t name##_action_slots[actions]; \
+    static esp_dds_pending_t name##_pending[actions]; \
+    static esp_dds_timer_t name##_timers[ESP_DDS_MAX_TIMERS]; \
+    static char name##_names[name_bytes]; \
+    static esp_dds_timer_node_t name##_timer_nodes[ESP_DDS_TIMER_NODES(topics, ESP_DDS_MAX_TIMERS)]; \
+    static esp_dds_domain_t name = { \
+        name##_topic_hashes, name##_topics, name##_subscribers, name##_topic_info, name##_topic_slots, \
+        name##_services, name##_service_slots, name##_actions, name##_action_slots, \
+        name##_pending, name##_timers, { name##_names, (name_bytes), 0 }, { {0}, name##_timer_nodes, 0 }, \
+        (topics), (services), (actions), (actions), ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC, ESP_DDS_MAX_TIMERS \
+    }
 
 // ============================================================================
 // PUBLIC API - ALL FUNCTIONS HAVE MACRO WRAPPERS FOR CONSISTENCY
 // ============================================================================
 
+// Name API - validates a name and computes its hash in a single pass
+esp_dds_name_t esp_dds_make_name(const char* name);
+
+#ifdef __cplusplus
+// Compile-time names: string literals passed to the ESP_DDS_* macros are validated and
+// hashed by the compiler. An invalid literal is a build error when optimizing (GCC/Clang);
+// runtime buffers and pointers fall back to esp_dds_make_name.
+namespace esp_dds {
+
+constexpr size_t name_length(const char* s, size_t max) {
+    return (max == 0 || *s == '\0') ? 0 : 1 + name_length(s + 1, max - 1);
+}
+
+constexpr uint32_t name_hash(const char* s, size_t n, uint32_t h = ESP_DDS_NAME_HASH_SEED) {
+    return n == 0 ? h : name_hash(s + 1, n - 1, (h ^ (uint8_t)s[0]) * ESP_DDS_NAME_HASH_PRIME);
+}
+
+constexpr bool name_valid(const char* s, size_t length) {
+    return length >= ESP_DDS_MIN_NAME_LENGTH && length < ESP_DDS_MAX_NAME_LENGTH && s[0] == '/';
+}
+
+#if defined(__GNUC__)
+void invalid_name_literal(void) __attribute__((error("ESP-DDS: invalid name literal (must start with '/', length 2..47)")));
+#define ESP_DDS_NAME_INLINE inline __attribute__((always_inline))
+#else
+#define ESP_DDS_NAME_INLINE inline
+#endif
+
+constexpr esp_dds_name_t literal_name(const char* s, size_t length) {
+    return esp_dds_name_t{ s, name_hash(s, length), (uint8_t)(name_valid(s, length) ? length : 0) };
+}
+
+// Fully constexpr so the front end folds hash and length for string literals
+template <size_t N>
+constexpr esp_dds_name_t make_name(const char (&s)[N]) {
+    return literal_name(s, name_length(s, N));
+}
+
+// Writable buffers (snprintf'd names) are never compile-time constants
+template <size_t N>
+inline esp_dds_name_t make_name(char (&s)[N]) {
+    return esp_dds_make_name(s);
+}
+
+struct runtime_name {
+    const char* str;
+    runtime_name(const char* s) : str(s) {}
+};
+
+inline esp_dds_name_t make_name(runtime_name s) {
+    return esp_dds_make_name(s.str);
+}
+
+// A folded zero length means an invalid literal - fail the build instead of the call
+ESP_DDS_NAME_INLINE esp_dds_name_t check_name(esp_dds_name_t name) {
+#if defined(__GNUC__)
+    if (__builtin_constant_p(name.length) && name.length == 0) invalid_name_literal();
+#endif
+    return name;
+}
+
+} // namespace esp_dds
+
+#define ESP_DDS_NAME(name) ::esp_dds::check_name(::esp_dds::make_name(name))
+#else
+#define ESP_DDS_NAME(name) esp_dds_make_name(name)
+#endif
+
+// Validates a literal at build time in setup-only APIs that take plain strings
+#define ESP_DDS_CHECKED_NAME(name) (ESP_DDS_NAME(name).str)
+
 // Core System API
 void esp_dds_init(void);
 void esp_dds_reset(void);
@@ -141,37 +796,145 @@ void esp_dds_reset(void);
 bool esp_dds_publish(const char* topic, const void* data, size_t size);
 bool esp_dds_subscribe(const char* topic, esp_dds_topic_cb_t callback, void* context);
 void esp_dds_unsubscribe(const char* topic, esp_dds_topic_cb_t callback);
+bool esp_dds_publish_name(esp_dds_name_t topic, const void* data, size_t size);
+bool esp_dds_subscribe_name(esp_dds_name_t topic, esp_dds_topic_cb_t callback, void* context);
+void esp_dds_unsubscribe_name(esp_dds_name_t topic, esp_dds_topic_cb_t callback);
 
 #define ESP_DDS_PUBLISH(topic, data) \
-    esp_dds_publish(topic, &(data), sizeof(data))
+    esp_dds_publish_name(ESP_DDS_NAME(topic), &(data), sizeof(data))
 
 #define ESP_DDS_SUBSCRIBE(topic, callback, context) \
-    esp_dds_subscribe(topic, callback, context)
+    esp_dds_subscribe_name(ESP_DDS_NAME(topic), callback, context)
 
 #define ESP_DDS_UNSUBSCRIBE(topic, callback) \
-    esp_dds_unsubscribe(topic, callback)
+    esp_dds_unsubscribe_name(ESP_DDS_NAME(topic), callback)
+
+// Batch publish - one lock and one timestamp for all samples, delivered in order.
+// Returns false if an entry is invalid (nothing published) or a delivery failed.
+bool esp_dds_publish_batch(const esp_dds_batch_entry_t* entries, size_t count);
+
+#define ESP_DDS_BATCH_ENTRY(topic, data) { ESP_DDS_NAME(topic), &(data), sizeof(data) }
+
+#define ESP_DDS_PUBLISH_BATCH(entries) esp_dds_publish_batch(entries, DDS_ARRAY_SIZE(entries))
+
+// Typed topics - samples in the wire format of a generated message type (see
+// tools/esp_dds_gen.py, typed wrappers in esp_dds_msg.h). The first typed publish or
+// subscribe binds the topic to the type hash, a later one with another hash is refused.
+// Untyped calls are not checked.
+bool esp_dds_publish_typed(esp_dds_name_t topic, uint32_t type_hash, const void* data, size_t size);
+bool esp_dds_subscribe_typed(esp_dds_name_t topic, uint32_t type_hash, esp_dds_topic_cb_t callback, void* context);
+
+// Content-filtered subscription - rejected samples never reach the callback
+bool esp_dds_subscribe_filtered(const char* topic, const esp_dds_filter_t* filter,
+                               esp_dds_topic_cb_t callback, void* context);
+
+#define ESP_DDS_SUBSCRIBE_FILTERED(topic, filter, callback, context) \
+    esp_dds_subscribe_filtered(ESP_DDS_CHECKED_NAME(topic), &(filter), callback, context)
+
+// Wildcard subscription, e.g. "/motor/*/current" or "/sensors/#". Patterns are resolved
+// into concrete subscriber lists when topics are created, publish never matches patterns.
+bool esp_dds_subscribe_pattern(const char* pattern, esp_dds_topic_cb_t callback, void* context);
+void esp_dds_unsubscribe_pattern(const char* pattern, esp_dds_topic_cb_t callback);
+
+#define ESP_DDS_SUBSCRIBE_PATTERN(pattern, callback, context) \
+    esp_dds_subscribe_pattern(ESP_DDS_CHECKED_NAME(pattern), callback, context)
+
+#define ESP_DDS_UNSUBSCRIBE_PATTERN(pattern, callback) \
+    esp_dds_unsubscribe_pattern(ESP_DDS_CHECKED_NAME(pattern), callback)
+
+// Time-based filter - at most one sample per min_separation_us. With keep_latest the
+// newest suppressed sample is delivered by esp_dds_process_timers when the window opens.
+bool esp_dds_subscribe_rate_limited(const char* topic, uint32_t min_separation_us, bool keep_latest,
+                                   esp_dds_topic_cb_t callback, void* context);
+
+#define ESP_DDS_SUBSCRIBE_RATE_LIMITED(topic, min_separation_us, keep_latest, callback, context) \
+    esp_dds_subscribe_rate_limited(ESP_DDS_CHECKED_NAME(topic), min_separation_us, keep_latest, callback, context)
+
+// Keyed topics (like DDS instances) - the key field splits a topic into instances and
+// the latest sample of each is kept for esp_dds_read_instance. Samples of a keyed topic
+// must contain the key and fit ESP_DDS_MAX_INSTANCE_SIZE, otherwise publish rejects them.
+bool esp_dds_set_topic_key(const char* topic, uint16_t key_offset, uint8_t key_width);
+bool esp_dds_read_instance(const char* topic, uint32_t key, void* data, size_t* size);
+bool esp_dds_read_instance_name(esp_dds_name_t topic, uint32_t key, void* data, size_t* size);
+bool esp_dds_subscribe_instances(const char* topic, const uint32_t* keys, uint8_t key_count,
+                                esp_dds_topic_cb_t callback, void* context);
+
+#define ESP_DDS_SET_TOPIC_KEY(topic, type, field) \
+    esp_dds_set_topic_key(ESP_DDS_CHECKED_NAME(topic), (uint16_t)offsetof(type, field), \
+                          (uint8_t)sizeof(((type*)0)->field))
+
+#define ESP_DDS_READ_INSTANCE(topic, key, sample) \
+    ({ \
+        size_t _size = sizeof(sample); \
+        bool _result = esp_dds_read_instance_name(ESP_DDS_NAME(topic), key, &(sample), &_size); \
+        _result; \
+    })
+
+// Delivers only samples whose key is in keys (at most ESP_DDS_MAX_SET_KEYS), after esp_dds_set_topic_key
+#define ESP_DDS_SUBSCRIBE_INSTANCES(topic, keys, callback, context) \
+    esp_dds_subscribe_instances(ESP_DDS_CHECKED_NAME(topic), keys, (uint8_t)DDS_ARRAY_SIZE(keys), callback, context)
+
+// Topic QoS API (checked by esp_dds_process_timers)
+bool esp_dds_set_deadline(const char* topic, uint32_t period_us, uint8_t tolerance_percent,
+                         esp_dds_qos_cb_t callback, void* context);
+bool esp_dds_set_liveliness(const char* topic, uint32_t lease_us,
+                           esp_dds_qos_cb_t callback, void* context);
+bool esp_dds_get_topic_status(const char* topic, esp_dds_topic_status_t* status);
+
+#define ESP_DDS_SET_DEADLINE(topic, period_us, tolerance_percent, callback, context) \
+    esp_dds_set_deadline(ESP_DDS_CHECKED_NAME(topic), period_us, tolerance_percent, callback, context)
+
+#define ESP_DDS_SET_LIVELINESS(topic, lease_us, callback, context) \
+    esp_dds_set_liveliness(ESP_DDS_CHECKED_NAME(topic), lease_us, callback, context)
+
+#define ESP_DDS_GET_TOPIC_STATUS(topic, status) \
+    esp_dds_get_topic_status(ESP_DDS_CHECKED_NAME(topic), &(status))
+
+// Frees topics without subscribers or QoS monitoring, returns the number freed.
+// Publishing to a collected topic simply creates it again.
+esp_dds_index_t esp_dds_collect_topics(void);
+
+#define ESP_DDS_COLLECT_TOPICS() esp_dds_collect_topics()
+
+// Timer API - periodic callbacks dispatched by esp_dds_process_timers, or by an executor
+// after esp_dds_set_timer_group. Returns the timer id or ESP_DDS_NO_TIMER.
+uint16_t esp_dds_create_timer(uint32_t period_us, esp_dds_timer_cb_t callback, void* context);
+bool esp_dds_destroy_timer(uint16_t timer);
+
+#define ESP_DDS_CREATE_TIMER(period_us, callback, context) esp_dds_create_timer(period_us, callback, context)
+#define ESP_DDS_DESTROY_TIMER(timer) esp_dds_destroy_timer(timer)
 
 // Service API  
 bool esp_dds_create_service(const char* service, esp_dds_service_cb_t callback, 
                            esp_dds_service_mode_t mode, void* context);
 bool esp_dds_call_service_sync(const char* service, const void* request, size_t req_size,
                               void* response, size_t* resp_size, uint32_t timeout_ms);
+// A local service answers without a timeout. A remote one not answered within timeout_ms
+// ends without a callback; 0 means ESP_DDS_REMOTE_TIMEOUT_MS, and so for remote goals.
 bool esp_dds_call_service_async(const char* service, const void* request, size_t req_size,
                                esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms);
+bool esp_dds_call_service_sync_name(esp_dds_name_t service, const void* request, size_t req_size,
+                                   void* response, size_t* resp_size, uint32_t timeout_ms);
+bool esp_dds_call_service_async_name(esp_dds_name_t service, const void* request, size_t req_size,
+                                    esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms);
+bool esp_dds_destroy_service(const char* service);
 
 #define ESP_DDS_CREATE_SERVICE(service, callback, mode, context) \
-    esp_dds_create_service(service, callback, mode, context)
+    esp_dds_create_service(ESP_DDS_CHECKED_NAME(service), callback, mode, context)
+
+#define ESP_DDS_DESTROY_SERVICE(service) \
+    esp_dds_destroy_service(ESP_DDS_CHECKED_NAME(service))
 
 #define ESP_DDS_CALL_SERVICE_SYNC(service, request, response, timeout) \
     ({ \
         size_t _resp_size = sizeof(response); \
-        bool _result = esp_dds_call_service_sync(service, &(request), sizeof(request), \
+        bool _result = esp_dds_call_service_sync_name(ESP_DDS_NAME(service), &(request), sizeof(request), \
                                  (void*)&(response), &_resp_size, timeout); \
         _result; \
     })
 
 #define ESP_DDS_CALL_SERVICE_ASYNC(service, request, callback, context, timeout) \
-    esp_dds_call_service_async(service, &(request), sizeof(request), callback, context, timeout)
+    esp_dds_call_service_async_name(ESP_DDS_NAME(service), &(request), sizeof(request), callback, context, timeout)
 
 // Action API
 bool esp_dds_create_action(const char* action, esp_dds_goal_cb_t goal_cb,
@@ -182,31 +945,427 @@ bool esp_dds_send_goal(const char* action, const void* goal, size_t goal_size,
                       void* context, uint32_t timeout_ms);
 bool esp_dds_cancel_goal(const char* action, uint32_t timeout_ms);
 bool esp_dds_send_feedback(const char* action, const void* feedback, size_t size);
+bool esp_dds_send_goal_name(esp_dds_name_t action, const void* goal, size_t goal_size,
+                           esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                           void* context, uint32_t timeout_ms);
+bool esp_dds_cancel_goal_name(esp_dds_name_t action, uint32_t timeout_ms);
+bool esp_dds_send_feedback_name(esp_dds_name_t action, const void* feedback, size_t size);
+bool esp_dds_destroy_action(const char* action);
 
 #define ESP_DDS_CREATE_ACTION(action, goal_cb, execute_cb, cancel_cb, context) \
-    esp_dds_create_action(action, goal_cb, execute_cb, cancel_cb, context)
+    esp_dds_create_action(ESP_DDS_CHECKED_NAME(action), goal_cb, execute_cb, cancel_cb, context)
+
+#define ESP_DDS_DESTROY_ACTION(action) \
+    esp_dds_destroy_action(ESP_DDS_CHECKED_NAME(action))
 
 #define ESP_DDS_SEND_GOAL(action, goal, feedback_cb, result_cb, context, timeout) \
-    esp_dds_send_goal(action, &(goal), sizeof(goal), feedback_cb, result_cb, context, timeout)
+    esp_dds_send_goal_name(ESP_DDS_NAME(action), &(goal), sizeof(goal), feedback_cb, result_cb, context, timeout)
 
 #define ESP_DDS_CANCEL_GOAL(action, timeout) \
-    esp_dds_cancel_goal(action, timeout)
+    esp_dds_cancel_goal_name(ESP_DDS_NAME(action), timeout)
 
 #define ESP_DDS_SEND_FEEDBACK(action, feedback) \
-    esp_dds_send_feedback(action, &(feedback), sizeof(feedback))
+    esp_dds_send_feedback_name(ESP_DDS_NAME(action), &(feedback), sizeof(feedback))
 
 // Processing API (call this periodically from main loop)
 void esp_dds_process_services(void);
 void esp_dds_process_actions(void);
 void esp_dds_process_pending(uint32_t timeout_ms);
+void esp_dds_process_timers(void);
 
 #define ESP_DDS_PROCESS_SERVICES() esp_dds_process_services()
 #define ESP_DDS_PROCESS_ACTIONS() esp_dds_process_actions()
 #define ESP_DDS_PROCESS_PENDING(timeout) esp_dds_process_pending(timeout)
+#define ESP_DDS_PROCESS_TIMERS() esp_dds_process_timers()
+
+// Executor API - grouped subscriptions, services and actions run in the executor
+// that owns their callback group instead of the publishing or processing thread.
+// Async and remote calls to a grouped service are queued, sync calls run in the
+// caller's thread but respect the group's mutual exclusion. Executors and groups live
+// until reset.
+uint8_t esp_dds_create_executor(esp_dds_executor_type_t type, uint8_t threads);
+uint8_t esp_dds_create_callback_group(uint8_t executor, esp_dds_group_type_t type);
+bool esp_dds_subscribe_grouped(const char* topic, uint8_t group, esp_dds_topic_cb_t callback, void* context);
+bool esp_dds_set_service_group(const char* service, uint8_t group);
+bool esp_dds_set_action_group(const char* action, uint8_t group);
+bool esp_dds_set_timer_group(uint16_t timer, uint8_t group);
+uint16_t esp_dds_executor_spin_some(uint8_t executor);  // Runs ready work, returns callbacks run
+bool esp_dds_executor_start(uint8_t executor);          // Worker tasks (FreeRTOS only)
+void esp_dds_executor_stop(uint8_t executor);           // Returns once the workers exited
+
+#define ESP_DDS_CREATE_EXECUTOR(type, threads) esp_dds_create_executor(type, threads)
+
+#define ESP_DDS_CREATE_CALLBACK_GROUP(executor, type) esp_dds_create_callback_group(executor, type)
+
+#define ESP_DDS_SUBSCRIBE_GROUPED(topic, group, callback, context) \
+    esp_dds_subscribe_grouped(ESP_DDS_CHECKED_NAME(topic), group, callback, context)
+
+#define ESP_DDS_SET_SERVICE_GROUP(service, group) \
+    esp_dds_set_service_group(ESP_DDS_CHECKED_NAME(service), group)
+
+#define ESP_DDS_SET_ACTION_GROUP(action, group) \
+    esp_dds_set_action_group(ESP_DDS_CHECKED_NAME(action), group)
+
+#define ESP_DDS_SET_TIMER_GROUP(timer, group) esp_dds_set_timer_group(timer, group)
+
+#define ESP_DDS_EXECUTOR_SPIN_SOME(executor) esp_dds_executor_spin_some(executor)
+#define ESP_DDS_EXECUTOR_START(executor) esp_dds_executor_start(executor)
+#define ESP_DDS_EXECUTOR_STOP(executor) esp_dds_executor_stop(executor)
+
+// WaitSet API - one task blocks on several topics, responses, results and guard
+// conditions at once. Attach returns the condition (fires bit 1 << condition) or
+// ESP_DDS_NO_CONDITION. Wait returns the fired bits and clears them, 0 on timeout.
+// Responses and results are still delivered by esp_dds_process_pending in the
+// calling task; the wait only says when that is worth calling.
+bool esp_dds_waitset_init(esp_dds_waitset_t* waitset);  // On the default domain
+void esp_dds_waitset_deinit(esp_dds_waitset_t* waitset);
+uint8_t esp_dds_waitset_attach_topic(esp_dds_waitset_t* waitset, const char* topic);
+uint8_t esp_dds_waitset_attach_service(esp_dds_waitset_t* waitset, const char* service);
+uint8_t esp_dds_waitset_attach_action(esp_dds_waitset_t* waitset, const char* action);
+uint8_t esp_dds_waitset_attach_guard(esp_dds_waitset_t* waitset);
+bool esp_dds_waitset_detach(esp_dds_waitset_t* waitset, uint8_t condition);
+bool esp_dds_waitset_trigger(esp_dds_waitset_t* waitset, uint8_t condition);
+uint32_t esp_dds_wait(esp_dds_waitset_t* waitset, uint32_t timeout_ms);
+bool esp_dds_waitset_take(esp_dds_waitset_t* waitset, uint8_t condition, void* data, size_t* size);
+
+#define ESP_DDS_CONDITION_BIT(condition) (1UL << (condition))
+
+#define ESP_DDS_WAITSET_INIT(waitset) esp_dds_waitset_init(waitset)
+#define ESP_DDS_WAITSET_DEINIT(waitset) esp_dds_waitset_deinit(waitset)
+
+#define ESP_DDS_WAITSET_ATTACH_TOPIC(waitset, topic) \
+    esp_dds_waitset_attach_topic(waitset, ESP_DDS_CHECKED_NAME(topic))
+
+#define ESP_DDS_WAITSET_ATTACH_SERVICE(waitset, service) \
+    esp_dds_waitset_attach_service(waitset, ESP_DDS_CHECKED_NAME(service))
+
+#define ESP_DDS_WAITSET_ATTACH_ACTION(waitset, action) \
+    esp_dds_waitset_attach_action(waitset, ESP_DDS_CHECKED_NAME(action))
+
+#define ESP_DDS_WAITSET_ATTACH_GUARD(waitset) esp_dds_waitset_attach_guard(waitset)
+#define ESP_DDS_WAITSET_DETACH(waitset, condition) esp_dds_waitset_detach(waitset, condition)
+#define ESP_DDS_WAITSET_TRIGGER(waitset, condition) esp_dds_waitset_trigger(waitset, condition)
+#define ESP_DDS_WAIT(waitset, timeout) esp_dds_wait(waitset, timeout)
+
+#define ESP_DDS_WAITSET_TAKE(waitset, condition, sample) \
+    ({ \
+        size_t _size = sizeof(sample); \
+        bool _result = esp_dds_waitset_take(waitset, condition, &(sample), &_size); \
+        _result; \
+    })
+
+// Transport API - samples of network-visible topics are handed to every attached
+// transport, samples a transport receives are delivered like local ones and forwarded
+// to the other transports. Both sides make a topic visible; it is matched by name hash.
+// Attach and detach transports during setup, they stay attached across reset. Visibility
+// and attach return false if a transport cannot carry one of the topics.
+bool esp_dds_set_topic_visibility(const char* topic, esp_dds_visibility_t visibility);
+bool esp_dds_attach_transport(esp_dds_transport_t* transport);
+void esp_dds_detach_transport(esp_dds_transport_t* transport);
+bool esp_dds_transport_deliver(esp_dds_transport_t* transport, uint32_t topic_hash,
+                               const void* data, size_t size);
+uint16_t esp_dds_process_transports(uint32_t timeout_ms);  // Returns samples and messages handled
+
+// Network-visible services and actions answer peers on every transport with
+// send_message. Calls and goals for a service or action this domain does not have go
+// out on those transports, the first answer wins. Nodes without them stay silent. A
+// remote sync call pumps the transports while it waits unless another task is already
+// receiving on them.
+//
+// At most the remote window of calls to one service are in flight, a sync call waits
+// for room within its timeout and an async call beyond it returns false. A remote async
+// call not answered within timeout_ms ends like a refused one at the next
+// esp_dds_process_pending. A visible service without a callback group runs in the
+// receiving task; with one its executor serves peers, so a slow call holds up neither
+// the transport nor other calls, and a full work queue answers at once with a failure.
+//
+// A remote goal keeps its id end to end and esp_dds_process_pending sends it again every
+// ESP_DDS_REMOTE_RETRY_MS until the server accepts or rejects it; the server answers a
+// repeat without asking its goal callback again. A goal not confirmed within timeout_ms
+// is canceled on the server in case only the answer got lost, and ends as aborted.
+bool esp_dds_set_service_visibility(const char* service, esp_dds_visibility_t visibility);
+bool esp_dds_set_action_visibility(const char* action, esp_dds_visibility_t visibility);
+bool esp_dds_set_remote_window(uint8_t window);  // 1..255, reset restores ESP_DDS_REMOTE_WINDOW
+bool esp_dds_transport_receive(esp_dds_transport_t* transport, const esp_dds_message_t* message);
+
+#define ESP_DDS_SET_TOPIC_VISIBILITY(topic, visibility) \
+    esp_dds_set_topic_visibility(ESP_DDS_CHECKED_NAME(topic), visibility)
+
+#define ESP_DDS_SET_SERVICE_VISIBILITY(service, visibility) \
+    esp_dds_set_service_visibility(ESP_DDS_CHECKED_NAME(service), visibility)
+
+#define ESP_DDS_SET_ACTION_VISIBILITY(action, visibility) \
+    esp_dds_set_action_visibility(ESP_DDS_CHECKED_NAME(action), visibility)
+
+#define ESP_DDS_SET_REMOTE_WINDOW(window) esp_dds_set_remote_window(window)
+
+#define ESP_DDS_ATTACH_TRANSPORT(transport) esp_dds_attach_transport(transport)
+#define ESP_DDS_DETACH_TRANSPORT(transport) esp_dds_detach_transport(transport)
+#define ESP_DDS_PROCESS_TRANSPORTS(timeout) esp_dds_process_transports(timeout)
 
 // Utility
 bool esp_dds_is_goal_canceled(const char* action);
+bool esp_dds_is_goal_canceled_name(esp_dds_name_t action);
+
+#define ESP_DDS_IS_GOAL_CANCELED(action) esp_dds_is_goal_canceled_name(ESP_DDS_NAME(action))
+
+// Domain API - the functions above act on esp_dds_default_domain(). A domain declared
+// with ESP_DDS_DOMAIN_DEFINE has its own tables and lock, so domains never contend.
+esp_dds_domain_t* esp_dds_default_domain(void);
+
+#define ESP_DDS_DEFAULT_DOMAIN() esp_dds_default_domain()
+
+void esp_dds_domain_init(esp_dds_domain_t* domain);
+void esp_dds_domain_reset(esp_dds_domain_t* domain);
+bool esp_dds_domain_publish(esp_dds_domain_t* domain,
+                            const char* topic, const void* data, size_t size);
+bool esp_dds_domain_subscribe(esp_dds_domain_t* domain,
+                              const char* topic, esp_dds_topic_cb_t callback, void* context);
+void esp_dds_domain_unsubscribe(esp_dds_domain_t* domain,
+                                const char* topic, esp_dds_topic_cb_t callback);
+bool esp_dds_domain_publish_name(esp_dds_domain_t* domain,
+                                 esp_dds_name_t topic, const void* data, size_t size);
+bool esp_dds_domain_publish_batch(esp_dds_domain_t* domain,
+                                  const esp_dds_batch_entry_t* entries, size_t count);
+bool esp_dds_domain_subscribe_name(esp_dds_domain_t* domain,
+                                   esp_dds_name_t topic, esp_dds_topic_cb_t callback, void* context);
+void esp_dds_domain_unsubscribe_name(esp_dds_domain_t* domain,
+                                     esp_dds_name_t topic, esp_dds_topic_cb_t callback);
+bool esp_dds_domain_publish_typed(esp_dds_domain_t* domain,
+                                  esp_dds_name_t topic, uint32_t type_hash, const void* data, size_t size);
+bool esp_dds_domain_subscribe_typed(esp_dds_domain_t* domain, esp_dds_name_t topic, uint32_t type_hash,
+                                    esp_dds_topic_cb_t callback, void* context);
+bool esp_dds_domain_subscribe_filtered(esp_dds_domain_t* domain,
+                                       const char* topic, const esp_dds_filter_t* filter,
+                                       esp_dds_topic_cb_t callback, void* context);
+bool esp_dds_domain_subscribe_pattern(esp_dds_domain_t* domain,
+                                      const char* pattern, esp_dds_topic_cb_t callback, void* context);
+void esp_dds_domain_unsubscribe_pattern(esp_dds_domain_t* domain,
+                                        const char* pattern, esp_dds_topic_cb_t callback);
+bool esp_dds_domain_subscribe_rate_limited(esp_dds_domain_t* domain,
+                                           const char* topic, uint32_t min_separation_us, bool keep_latest,
+                                           esp_dds_topic_cb_t callback, void* context);
+bool esp_dds_domain_set_topic_key(esp_dds_domain_t* domain,
+                                  const char* topic, uint16_t key_offset, uint8_t key_width);
+bool esp_dds_domain_read_instance(esp_dds_domain_t* domain,
+                                  const char* topic, uint32_t key, void* data, size_t* size);
+bool esp_dds_domain_read_instance_name(esp_dds_domain_t* domain,
+                                       esp_dds_name_t topic, uint32_t key, void* data, size_t* size);
+bool esp_dds_domain_subscribe_instances(esp_dds_domain_t* domain,
+                                        const char* topic, const uint32_t* keys, uint8_t key_count,
+                                        esp_dds_topic_cb_t callback, void* context);
+bool esp_dds_domain_set_deadline(esp_dds_domain_t* domain,
+                                 const char* topic, uint32_t period_us, uint8_t tolerance_percent,
+                                 esp_dds_qos_cb_t callback, void* context);
+bool esp_dds_domain_set_liveliness(esp_dds_domain_t* domain, const char* topic, uint32_t lease_us,
+                                   esp_dds_qos_cb_t callback, void* context);
+bool esp_dds_domain_get_topic_status(esp_dds_domain_t* domain,
+                                     const char* topic, esp_dds_topic_status_t* status);
+esp_dds_index_t esp_dds_domain_collect_topics(esp_dds_domain_t* domain);
+uint16_t esp_dds_domain_create_timer(esp_dds_domain_t* domain, uint32_t period_us,
+                                     esp_dds_timer_cb_t callback, void* context);
+bool esp_dds_domain_destroy_timer(esp_dds_domain_t* domain, uint16_t timer);
+bool esp_dds_domain_create_service(esp_dds_domain_t* domain,
+                                   const char* service, esp_dds_service_cb_t callback,
+                                   esp_dds_service_mode_t mode, void* context);
+bool esp_dds_domain_call_service_sync(esp_dds_domain_t* domain,
+                                      const char* service, const void* request, size_t req_size,
+                                      void* response, size_t* resp_size, uint32_t timeout_ms);
+bool esp_dds_domain_call_service_async(esp_dds_domain_t* domain,
+                                       const char* service, const void* request, size_t req_size,
+                                       esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms);
+bool esp_dds_domain_call_service_sync_name(esp_dds_domain_t* domain,
+                                           esp_dds_name_t service, const void* request, size_t req_size,
+                                           void* response, size_t* resp_size, uint32_t timeout_ms);
+bool esp_dds_domain_call_service_async_name(esp_dds_domain_t* domain,
+                                            esp_dds_name_t service, const void* request, size_t req_size,
+                                            esp_dds_async_cb_t callback, void* context, uint32_t timeout_ms);
+bool esp_dds_domain_destroy_service(esp_dds_domain_t* domain, const char* service);
+bool esp_dds_domain_create_action(esp_dds_domain_t* domain,
+                                  const char* action, esp_dds_goal_cb_t goal_cb,
+                                  esp_dds_execute_cb_t execute_cb, esp_dds_cancel_cb_t cancel_cb,
+                                  void* context);
+bool esp_dds_domain_send_goal(esp_dds_domain_t* domain,
+                              const char* action, const void* goal, size_t goal_size,
+                              esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                              void* context, uint32_t timeout_ms);
+bool esp_dds_domain_cancel_goal(esp_dds_domain_t* domain, const char* action, uint32_t timeout_ms);
+bool esp_dds_domain_send_feedback(esp_dds_domain_t* domain,
+                                  const char* action, const void* feedback, size_t size);
+bool esp_dds_domain_send_goal_name(esp_dds_domain_t* domain,
+                                   esp_dds_name_t action, const void* goal, size_t goal_size,
+                                   esp_dds_feedback_cb_t feedback_cb, esp_dds_result_cb_t result_cb,
+                                   void* context, uint32_t timeout_ms);
+bool esp_dds_domain_cancel_goal_name(esp_dds_domain_t* domain,
+                                     esp_dds_name_t action, uint32_t timeout_ms);
+bool esp_dds_domain_send_feedback_name(esp_dds_domain_t* domain,
+                                       esp_dds_name_t action, const void* feedback, size_t size);
+bool esp_dds_domain_destroy_action(esp_dds_domain_t* domain, const char* action);
+void esp_dds_domain_process_services(esp_dds_domain_t* domain);
+void esp_dds_domain_process_actions(esp_dds_domain_t* domain);
+void esp_dds_domain_process_pending(esp_dds_domain_t* domain, uint32_t timeout_ms);
+void esp_dds_domain_process_timers(esp_dds_domain_t* domain);
+uint8_t esp_dds_domain_create_executor(esp_dds_domain_t* domain, esp_dds_executor_type_t type, uint8_t threads);
+uint8_t esp_dds_domain_create_callback_group(esp_dds_domain_t* domain, uint8_t executor, esp_dds_group_type_t type);
+bool esp_dds_domain_subscribe_grouped(esp_dds_domain_t* domain, const char* topic, uint8_t group,
+                                      esp_dds_topic_cb_t callback, void* context);
+bool esp_dds_domain_set_service_group(esp_dds_domain_t* domain, const char* service, uint8_t group);
+bool esp_dds_domain_set_action_group(esp_dds_domain_t* domain, const char* action, uint8_t group);
+bool esp_dds_domain_set_timer_group(esp_dds_domain_t* domain, uint16_t timer, uint8_t group);
+uint16_t esp_dds_domain_executor_spin_some(esp_dds_domain_t* domain, uint8_t executor);
+bool esp_dds_domain_executor_start(esp_dds_domain_t* domain, uint8_t executor);
+void esp_dds_domain_executor_stop(esp_dds_domain_t* domain, uint8_t executor);
+bool esp_dds_domain_waitset_init(esp_dds_domain_t* domain, esp_dds_waitset_t* waitset);
+bool esp_dds_domain_set_topic_visibility(esp_dds_domain_t* domain,
+                                         const char* topic, esp_dds_visibility_t visibility);
+bool esp_dds_domain_set_service_visibility(esp_dds_domain_t* domain,
+                                           const char* service, esp_dds_visibility_t visibility);
+bool esp_dds_domain_set_action_visibility(esp_dds_domain_t* domain,
+                                          const char* action, esp_dds_visibility_t visibility);
+bool esp_dds_domain_set_remote_window(esp_dds_domain_t* domain, uint8_t window);
+bool esp_dds_domain_attach_transport(esp_dds_domain_t* domain, esp_dds_transport_t* transport);
+uint16_t esp_dds_domain_process_transports(esp_dds_domain_t* domain, uint32_t timeout_ms);
+bool esp_dds_domain_is_goal_canceled(esp_dds_domain_t* domain, const char* action);
+bool esp_dds_domain_is_goal_canceled_name(esp_dds_domain_t* domain, esp_dds_name_t action);
+
+#define ESP_DDS_DOMAIN_INIT(domain) esp_dds_domain_init(domain)
+
+#define ESP_DDS_DOMAIN_RESET(domain) esp_dds_domain_reset(domain)
+
+#define ESP_DDS_DOMAIN_PUBLISH(domain, topic, data) \
+    esp_dds_domain_publish_name(domain, ESP_DDS_NAME(topic), &(data), sizeof(data))
+
+#define ESP_DDS_DOMAIN_PUBLISH_BATCH(domain, entries) \
+    esp_dds_domain_publish_batch(domain, entries, DDS_ARRAY_SIZE(entries))
+
+#define ESP_DDS_DOMAIN_SUBSCRIBE(domain, topic, callback, context) \
+    esp_dds_domain_subscribe_name(domain, ESP_DDS_NAME(topic), callback, context)
+
+#define ESP_DDS_DOMAIN_UNSUBSCRIBE(domain, topic, callback) \
+    esp_dds_domain_unsubscribe_name(domain, ESP_DDS_NAME(topic), callback)
+
+#define ESP_DDS_DOMAIN_SUBSCRIBE_FILTERED(domain, topic, filter, callback, context) \
+    esp_dds_domain_subscribe_filtered(domain, ESP_DDS_CHECKED_NAME(topic), &(filter), callback, context)
+
+#define ESP_DDS_DOMAIN_SUBSCRIBE_PATTERN(domain, pattern, callback, context) \
+    esp_dds_domain_subscribe_pattern(domain, ESP_DDS_CHECKED_NAME(pattern), callback, context)
+
+#define ESP_DDS_DOMAIN_UNSUBSCRIBE_PATTERN(domain, pattern, callback) \
+    esp_dds_domain_unsubscribe_pattern(domain, ESP_DDS_CHECKED_NAME(pattern), callback)
+
+#define ESP_DDS_DOMAIN_SUBSCRIBE_RATE_LIMITED(domain, topic, min_separation_us, keep_latest, callback, context) \
+    esp_dds_domain_subscribe_rate_limited(domain, ESP_DDS_CHECKED_NAME(topic), min_separation_us, keep_latest, callback, context)
+
+#define ESP_DDS_DOMAIN_SET_TOPIC_KEY(domain, topic, type, field) \
+    esp_dds_domain_set_topic_key(domain, ESP_DDS_CHECKED_NAME(topic), (uint16_t)offsetof(type, field), \
+                                 (uint8_t)sizeof(((type*)0)->field))
+
+#define ESP_DDS_DOMAIN_READ_INSTANCE(domain, topic, key, sample) \
+    ({ \
+        size_t _size = sizeof(sample); \
+        bool _result = esp_dds_domain_read_instance_name(domain, ESP_DDS_NAME(topic), key, &(sample), &_size); \
+        _result; \
+    })
+
+#define ESP_DDS_DOMAIN_SUBSCRIBE_INSTANCES(domain, topic, keys, callback, context) \
+    esp_dds_domain_subscribe_instances(domain, ESP_DDS_CHECKED_NAME(topic), keys, (uint8_t)DDS_ARRAY_SIZE(keys), \
+                                       callback, context)
+
+#define ESP_DDS_DOMAIN_SET_DEADLINE(domain, topic, period_us, tolerance_percent, callback, context) \
+    esp_dds_domain_set_deadline(domain, ESP_DDS_CHECKED_NAME(topic), period_us, tolerance_percent, callback, context)
+
+#define ESP_DDS_DOMAIN_SET_LIVELINESS(domain, topic, lease_us, callback, context) \
+    esp_dds_domain_set_liveliness(domain, ESP_DDS_CHECKED_NAME(topic), lease_us, callback, context)
+
+#define ESP_DDS_DOMAIN_GET_TOPIC_STATUS(domain, topic, status) \
+    esp_dds_domain_get_topic_status(domain, ESP_DDS_CHECKED_NAME(topic), &(status))
+
+#define ESP_DDS_DOMAIN_COLLECT_TOPICS(domain) esp_dds_domain_collect_topics(domain)
+
+#define ESP_DDS_DOMAIN_CREATE_TIMER(domain, period_us, callback, context) \
+    esp_dds_domain_create_timer(domain, period_us, callback, context)
+
+#define ESP_DDS_DOMAIN_DESTROY_TIMER(domain, timer) esp_dds_domain_destroy_timer(domain, timer)
+
+#define ESP_DDS_DOMAIN_CREATE_SERVICE(domain, service, callback, mode, context) \
+    esp_dds_domain_create_service(domain, ESP_DDS_CHECKED_NAME(service), callback, mode, context)
+
+#define ESP_DDS_DOMAIN_DESTROY_SERVICE(domain, service) \
+    esp_dds_domain_destroy_service(domain, ESP_DDS_CHECKED_NAME(service))
+
+#define ESP_DDS_DOMAIN_CALL_SERVICE_SYNC(domain, service, request, response, timeout) \
+    ({ \
+        size_t _resp_size = sizeof(response); \
+        bool _result = esp_dds_domain_call_service_sync_name(domain, ESP_DDS_NAME(service), &(request), sizeof(request), \
+                                 (void*)&(response), &_resp_size, timeout); \
+        _result; \
+    })
+
+#define ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(domain, service, request, callback, context, timeout) \
+    esp_dds_domain_call_service_async_name(domain, ESP_DDS_NAME(service), &(request), sizeof(request), callback, context, timeout)
+
+#define ESP_DDS_DOMAIN_CREATE_ACTION(domain, action, goal_cb, execute_cb, cancel_cb, context) \
+    esp_dds_domain_create_action(domain, ESP_DDS_CHECKED_NAME(action), goal_cb, execute_cb, cancel_cb, context)
+
+#define ESP_DDS_DOMAIN_DESTROY_ACTION(domain, action) \
+    esp_dds_domain_destroy_action(domain, ESP_DDS_CHECKED_NAME(action))
+
+#define ESP_DDS_DOMAIN_SEND_GOAL(domain, action, goal, feedback_cb, result_cb, context, timeout) \
+    esp_dds_domain_send_goal_name(domain, ESP_DDS_NAME(action), &(goal), sizeof(goal), feedback_cb, result_cb, context, timeout)
+
+#define ESP_DDS_DOMAIN_CANCEL_GOAL(domain, action, timeout) \
+    esp_dds_domain_cancel_goal_name(domain, ESP_DDS_NAME(action), timeout)
+
+#define ESP_DDS_DOMAIN_SEND_FEEDBACK(domain, action, feedback) \
+    esp_dds_domain_send_feedback_name(domain, ESP_DDS_NAME(action), &(feedback), sizeof(feedback))
+
+#define ESP_DDS_DOMAIN_PROCESS_SERVICES(domain) esp_dds_domain_process_services(domain)
+
+#define ESP_DDS_DOMAIN_PROCESS_ACTIONS(domain) esp_dds_domain_process_actions(domain)
+
+#define ESP_DDS_DOMAIN_PROCESS_PENDING(domain, timeout) esp_dds_domain_process_pending(domain, timeout)
+
+#define ESP_DDS_DOMAIN_PROCESS_TIMERS(domain) esp_dds_domain_process_timers(domain)
+
+#define ESP_DDS_DOMAIN_CREATE_EXECUTOR(domain, type, threads) esp_dds_domain_create_executor(domain, type, threads)
+
+#define ESP_DDS_DOMAIN_CREATE_CALLBACK_GROUP(domain, executor, type) \
+    esp_dds_domain_create_callback_group(domain, executor, type)
+
+#define ESP_DDS_DOMAIN_SUBSCRIBE_GROUPED(domain, topic, group, callback, context) \
+    esp_dds_domain_subscribe_grouped(domain, ESP_DDS_CHECKED_NAME(topic), group, callback, context)
+
+#define ESP_DDS_DOMAIN_SET_SERVICE_GROUP(domain, service, group) \
+    esp_dds_domain_set_service_group(domain, ESP_DDS_CHECKED_NAME(service), group)
+
+#define ESP_DDS_DOMAIN_SET_ACTION_GROUP(domain, action, group) \
+    esp_dds_domain_set_action_group(domain, ESP_DDS_CHECKED_NAME(action), group)
+
+#define ESP_DDS_DOMAIN_SET_TIMER_GROUP(domain, timer, group) esp_dds_domain_set_timer_group(domain, timer, group)
+
+#define ESP_DDS_DOMAIN_EXECUTOR_SPIN_SOME(domain, executor) esp_dds_domain_executor_spin_some(domain, executor)
+
+#define ESP_DDS_DOMAIN_EXECUTOR_START(domain, executor) esp_dds_domain_executor_start(domain, executor)
+
+#define ESP_DDS_DOMAIN_EXECUTOR_STOP(domain, executor) esp_dds_domain_executor_stop(domain, executor)
+
+#define ESP_DDS_DOMAIN_WAITSET_INIT(domain, waitset) esp_dds_domain_waitset_init(domain, waitset)
+
+#define ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(domain, topic, visibility) \
+    esp_dds_domain_set_topic_visibility(domain, ESP_DDS_CHECKED_NAME(topic), visibility)
+
+#define ESP_DDS_DOMAIN_SET_SERVICE_VISIBILITY(domain, service, visibility) \
+    esp_dds_domain_set_service_visibility(domain, ESP_DDS_CHECKED_NAME(service), visibility)
+
+#define ESP_DDS_DOMAIN_SET_ACTION_VISIBILITY(domain, action, visibility) \
+    esp_dds_domain_set_action_visibility(domain, ESP_DDS_CHECKED_NAME(action), visibility)
+
+#define ESP_DDS_DOMAIN_SET_REMOTE_WINDOW(domain, window) esp_dds_domain_set_remote_window(domain, window)
+
+#define ESP_DDS_DOMAIN_ATTACH_TRANSPORT(domain, transport) esp_dds_domain_attach_transport(domain, transport)
+
+#define ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(domain, timeout) esp_dds_domain_process_transports(domain, timeout)
 
-#define ESP_DDS_IS_GOAL_CANCELED(action) esp_dds_is_goal_canceled(action)
+#define ESP_DDS_DOMAIN_IS_GOAL_CANCELED(domain, action) esp_dds_domain_is_goal_canceled_name(domain, ESP_DDS_NAME(action))
 
 #endif // ESP_DDS_H
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef ESP_DDS_CONTEXT_H
+#define ESP_DDS_CONTEXT_H
+
+#include "esp_dds.h"
+
+#ifdef __cplusplus
+// Compile-time configured DDS domain. Every table is sized by a Config type, so a
+// node pays exactly for what it uses and a gateway can scale to thousands of topics:
+//
+//   struct NodeConfig : esp_dds::DefaultConfig {
+//       static constexpr size_t topics = 6;
+//       static constexpr size_t subscribers_per_topic = 2;
+//   };
+//   static esp_dds::Context<NodeConfig> node;
+//   static_assert(esp_dds::Context<NodeConfig>::footprint <= 4096, "RAM budget");
+//
+// A Context is a domain - call node.init(), then use node.domain() with the
+// ESP_DDS_DOMAIN_* macros.
+namespace esp_dds {
+
+// Library defaults, derive and override only the limits that differ
+struct DefaultConfig {
+    static constexpr size_t topics = ESP_DDS_MAX_TOPICS;
+    static constexpr size_t services = ESP_DDS_MAX_SERVICES;
+    static constexpr size_t actions = ESP_DDS_MAX_ACTIONS;
+    static constexpr size_t pending = ESP_DDS_MAX_PENDING;
+    static constexpr size_t subscribers_per_topic = ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC;
+    static constexpr size_t timers = ESP_DDS_MAX_TIMERS;
+    static constexpr size_t name_bytes = ESP_DDS_NAME_ARENA_SIZE;
+};
+
+template <bool Narrow> struct index_select { typedef uint8_t type; };
+template <> struct index_select<false> { typedef uint16_t type; };
+
+constexpr size_t max_of(size_t a, size_t b) { return a > b ? a : b; }
+
+// Narrowest index that addresses max entries and still has a free "none" value
+template <size_t Max>
+struct index_for {
+    typedef typename index_select<(Max < 0xFF)>::type type;
+};
+
+// Static tables of one context, in the layout ESP_DDS_DOMAIN_DEFINE uses
+template <typename Config>
+struct ContextTables {
+    uint32_t topic_hashes[Config::topics];
+    esp_dds_topic_t topics[Config::topics];
+    esp_dds_subscriber_t subscribers[Config::topics * Config::subscribers_per_topic];
+    esp_dds_topic_info_t topic_info[Config::topics];
+    esp_dds_slot_t topic_slots[Config::topics];
+    esp_dds_service_t services[Config::services];
+    esp_dds_slot_t service_slots[Config::services];
+    esp_dds_action_t actions[Config::actions];
+    esp_dds_slot_t action_slots[Config::actions];
+    esp_dds_pending_t pending[Config::pending];
+    esp_dds_timer_t timers[Config::timers];
+    char names[Config::name_bytes];
+    esp_dds_timer_node_t timer_nodes[ESP_DDS_TIMER_NODES(Config::topics, Config::timers)];
+};
+
+template <typename Config = DefaultConfig>
+class Context {
+public:
+    typedef typename index_for<max_of(max_of(Config::topics, Config::services),
+                                      max_of(Config::actions, Config::pending))>::type index_type;
+
+    static_assert(sizeof(index_type) <= sizeof(esp_dds_index_t),
+                  "ESP-DDS: limits above 254 need 16-bit indices, build with -DESP_DDS_WIDE_INDEX");
+    static_assert(ESP_DDS_DOMAIN_LIMITS_VALID(Config::topics, Config::services, Config::actions,
+                                              Config::pending, Config::subscribers_per_topic,
+                                              Config::timers, Config::name_bytes),
+                  "ESP-DDS: context limits out of range");
+
+    // Static RAM of the context in bytes, equal to sizeof(Context<Config>)
+    static constexpr size_t footprint = sizeof(ContextTables<Config>) + sizeof(esp_dds_domain_t);
+
+    constexpr Context() : tables_(), domain_() {}
+
+    // Wires the tables into the domain here rather than in the constructor, so the
+    // context stays all-zero and a static one costs .bss only, no flash image
+    void init() {
+        static_assert(sizeof(Context) == footprint, "ESP-DDS: context has unexpected padding");
+        if (!domain_.topics) {
+            esp_dds_domain_t d = {
+                tables_.topic_hashes, tables_.topics, tables_.subscribers, tables_.topic_info,
+                tables_.topic_slots, tables_.services, tables_.service_slots, tables_.actions,
+                tables_.action_slots, tables_.pending, tables_.timers,
+                { tables_.names, (uint16_t)Config::name_bytes, 0 }, { {0}, tables_.timer_nodes, 0 },
+                (esp_dds_index_t)Config::topics, (esp_dds_index_t)Config::services,
+                (esp_dds_index_t)Config::actions, (esp_dds_index_t)Config::pending,
+                (uint8_t)Config::subscribers_per_topic, (uint16_t)Config::timers
+            };
+            domain_ = d;
+        }
+        esp_dds_domain_init(&domain_);
+    }
+
+    // Tables point into the object itself
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    esp_dds_domain_t* domain() { return &domain_; }
+    void reset() { esp_dds_domain_reset(&domain_); }
+
+private:
+    ContextTables<Config> tables_;
+    esp_dds_domain_t domain_;
+};
+
+} // namespace esp_dds
+#endif
+
+#endif // ESP_DDS_CONTEXT_H
@@ -0,0 +1,978 @@
+#include "esp_dds_link.h"
+
+#define LINK_DATA_HEADER 4
+#define LINK_MESSAGE_HEADER 8
+#define LINK_RDATA_HEADER 12
+#define LINK_HEARTBEAT_BODY 12
+#define LINK_NACK_BODY 12
+#define LINK_FRAGMENT_HEADER 16
+#define LINK_TIME_BODY 16
+#define LINK_TDATA_HEADER 8
+#define LINK_KEYFRAME_HEADER 8
+#define LINK_DELTA_HEADER 8
+#define LINK_KEYACK_BODY 8
+#define LINK_PAD(n) (((n) + 3u) & ~3u)
+
+static inline void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint32_t link_now(esp_dds_link_t* link) {
+    return link->port->clock ? link->port->clock(link) : DDS_MICROS();
+}
+
+static inline bool clock_due(const esp_dds_link_t* link, uint32_t now) {
+    return link->clock.period_us && !link->address && now - link->clock.sent_us >= link->clock.period_us;
+}
+
+static bool append_clock(esp_dds_link_t* link, uint32_t now);
+
+// A due time submessage rides along if it fits
+static bool write_frame(esp_dds_link_t* link) {
+    if (!link->tx_used) return true;
+    if (link->clock.period_us && link->tx_used + ESP_DDS_LINK_SUB_HEADER + LINK_TIME_BODY <= ESP_DDS_LINK_MTU) {
+        uint32_t now = link_now(link);
+        if (clock_due(link, now)) append_clock(link, now);
+    }
+    bool ok = link->port->write(link, link->tx, link->tx_used);
+    if (ok) {
+        link->frames_sent++;
+    } else {
+        link->write_failures++;
+    }
+    link->tx_used = 0;
+    return ok;
+}
+
+// Queues one submessage, sending the queued frame first if it would not fit
+static bool append(esp_dds_link_t* link, uint8_t kind, uint8_t status, const uint8_t* header, size_t header_size,
+                   const void* payload, size_t size) {
+    size_t body = header_size + size;
+    size_t need = ESP_DDS_LINK_SUB_HEADER + LINK_PAD(body);
+    if (link->tx_used + need > ESP_DDS_LINK_MTU && !write_frame(link)) return false;
+    
+    uint8_t* p = link->tx;
+    if (!link->tx_used) {
+        p[0] = ESP_DDS_LINK_VERSION;
+        p[1] = 0;
+        put_u16(&p[2], link->tx_sequence++);
+        link->tx_used = ESP_DDS_LINK_FRAME_HEADER;
+        link->batch_start_us = link_now(link);
+    }
+    p += link->tx_used;
+    p[0] = kind;
+    p[1] = status;
+    put_u16(&p[2], (uint16_t)body);
+    memcpy(&p[ESP_DDS_LINK_SUB_HEADER], header, header_size);
+    if (size) memcpy(&p[ESP_DDS_LINK_SUB_HEADER + header_size], payload, size);
+    memset(&p[ESP_DDS_LINK_SUB_HEADER + body], 0, LINK_PAD(body) - body);
+    link->tx_used += (uint16_t)need;
+    return true;
+}
+
+// Clock sync. The echoed pair is written by the receiving task; a torn read makes one
+// exchange look slow, and slow exchanges are skipped.
+static bool append_clock(esp_dds_link_t* link, uint32_t now) {
+    esp_dds_link_clock_t* c = &link->clock;
+    uint8_t body[LINK_TIME_BODY];
+    put_u32(body, now);
+    put_u32(&body[4], c->peer_sent);
+    put_u32(&body[8], c->peer_received_us);
+    put_u32(&body[12], c->heard ? 1 : 0);
+    c->sent_us = now;
+    return append(link, ESP_DDS_LINK_TIME, 0, body, sizeof(body), NULL, 0);
+}
+
+static uint32_t predicted_offset(const esp_dds_link_clock_t* c, uint32_t now) {
+    int64_t elapsed = (int32_t)(now - c->offset_at_us);
+    return c->offset_us + (uint32_t)(int32_t)(elapsed * c->drift_ppb / 1000000000LL);
+}
+
+// Closes the exchange our echoed time submessage opened: t1 we sent, t2 the peer got
+// it, t3 the peer sent this one, t4 now
+static void clock_exchange(esp_dds_link_t* link, const uint8_t* b, uint32_t t4) {
+    esp_dds_link_clock_t* c = &link->clock;
+    if (!c->period_us || link->address) return;
+    uint32_t t3 = get_u32(b);
+    uint32_t t1 = get_u32(&b[4]);
+    uint32_t t2 = get_u32(&b[8]);
+    bool echoed = get_u32(&b[12]) & 1;
+    c->peer_sent = t3;
+    c->peer_received_us = t4;
+    c->heard = true;
+    if (!echoed || (int32_t)(t4 - t1) < 0) return;
+    
+    int32_t round_trip = (int32_t)((t4 - t1) - (t3 - t2));
+    if (round_trip < 0) round_trip = 0;
+    c->best_round_trip_us += c->best_round_trip_us / 64 + 1;
+    if (!c->synced || (uint32_t)round_trip < c->best_round_trip_us) c->best_round_trip_us = (uint32_t)round_trip;
+    if ((uint32_t)round_trip > c->best_round_trip_us + c->best_round_trip_us / 2 + 20) {
+        c->skipped++;
+        return;
+    }
+    
+    // Each difference holds the offset plus one direction's delay, their mean cancels
+    // the delays as far as both directions take as long
+    uint32_t there = t2 - t1;
+    uint32_t back = t3 - t4;
+    uint32_t offset = there + (uint32_t)((int32_t)(back - there) / 2);
+    c->round_trip_us = (uint32_t)round_trip;
+    c->exchanges++;
+    if (!c->synced) {
+        c->offset_us = offset;
+        c->drift_offset_us = offset;
+        c->drift_at_us = t4;
+        c->drift_ppb = 0;
+    } else {
+        uint32_t predicted = predicted_offset(c, t4);
+        c->offset_us = predicted + (uint32_t)((int32_t)(offset - predicted) / 4);
+        uint32_t span = t4 - c->drift_at_us;
+        if (span >= ESP_DDS_LINK_DRIFT_US) {
+            int64_t change = (int32_t)(offset - c->drift_offset_us);
+            int32_t measured = (int32_t)(change * 1000000000LL / span);
+            c->drift_ppb = c->drift_ppb ? c->drift_ppb + (measured - c->drift_ppb) / 2 : measured;
+            c->drift_offset_us = offset;
+            c->drift_at_us = t4;
+        }
+    }
+    c->offset_at_us = t4;
+    c->synced = true;
+}
+
+// Publish time of a sample in the port's clock
+static inline uint32_t publish_stamp(esp_dds_link_t* link, uint32_t publish_us) {
+    return link->port->clock ? link->port->clock(link) - (DDS_MICROS() - publish_us) : publish_us;
+}
+
+static void record_latency(esp_dds_link_t* link, uint32_t published, uint32_t now) {
+    uint32_t local;
+    if (!esp_dds_link_to_local_time(link, published, &local)) return;
+    esp_dds_link_latency_t* h = &link->latency;
+    int32_t latency = (int32_t)(now - local);
+    if (latency < 0) {
+        h->early++;
+        latency = 0;
+    }
+    uint32_t us = (uint32_t)latency;
+    uint8_t bucket = 0;
+    while (bucket < ESP_DDS_LINK_LATENCY_BUCKETS - 1 && us >= (1u << bucket)) bucket++;
+    h->buckets[bucket]++;
+    if (!h->count || us < h->min_us) h->min_us = us;
+    if (us > h->max_us) h->max_us = us;
+    h->sum_us += us;
+    h->count++;
+}
+
+// Reliable writers
+static esp_dds_link_writer_t* find_writer(esp_dds_link_t* link, uint32_t hash) {
+    for (uint8_t i = 0; i < ESP_DDS_LINK_WRITERS; i++) {
+        if (link->writers[i].in_use && link->writers[i].hash == hash) return &link->writers[i];
+    }
+    return NULL;
+}
+
+static inline uint16_t writer_first(const esp_dds_link_writer_t* w) {
+    return (uint16_t)(w->next_sequence - w->count);
+}
+
+static bool append_rdata(esp_dds_link_t* link, const esp_dds_link_writer_t* w, const esp_dds_link_sample_t* sample) {
+    uint8_t header[LINK_RDATA_HEADER];
+    put_u32(header, w->hash);
+    put_u16(&header[4], link->address);
+    put_u16(&header[6], sample->sequence);
+    put_u16(&header[8], writer_first(w));
+    put_u16(&header[10], 0);
+    return append(link, ESP_DDS_LINK_RDATA, 0, header, sizeof(header), sample->data, sample->size);
+}
+
+// Resends what readers asked for and lets quiet writers announce their last sample.
+// Returns true if anything went into the frame.
+static bool send_writer_control(esp_dds_link_t* link, esp_dds_link_writer_t* w, uint32_t now) {
+    bool sent = false;
+    uint32_t resend = __atomic_exchange_n(&w->resend, 0, __ATOMIC_ACQ_REL);
+    for (uint8_t slot = 0; resend; slot++, resend >>= 1) {
+        const esp_dds_link_sample_t* sample = &w->history[slot];
+        uint16_t age = (uint16_t)(w->next_sequence - sample->sequence);
+        if (!(resend & 1) || age == 0 || age > w->count) continue;
+        if (append_rdata(link, w, sample)) {
+            link->resent++;
+            sent = true;
+        }
+        w->heartbeats = ESP_DDS_LINK_HEARTBEATS;
+        w->heartbeat_us = now;
+    }
+    if (w->heartbeats && now - w->heartbeat_us >= ESP_DDS_LINK_HEARTBEAT_US) {
+        uint8_t body[LINK_HEARTBEAT_BODY];
+        put_u32(body, w->hash);
+        put_u16(&body[4], link->address);
+        put_u16(&body[6], writer_first(w));
+        put_u16(&body[8], (uint16_t)(w->next_sequence - 1));
+        put_u16(&body[10], 0);
+        if (append(link, ESP_DDS_LINK_HEARTBEAT, 0, body, sizeof(body), NULL, 0)) {
+            link->heartbeats++;
+            sent = true;
+        }
+        w->heartbeats--;
+        w->heartbeat_us = now;
+    }
+    return sent;
+}
+
+// Asks for every sequence between base and the newest announced one that has not arrived
+static bool send_nack(esp_dds_link_t* link, esp_dds_link_reader_t* r) {
+    uint16_t span = (uint16_t)(r->last - r->base + 1);
+    if (span > 0x8000) return false;  // last is behind base, nothing missing
+    if (span > 32) span = 32;
+    uint32_t missing = 0;
+    for (uint8_t i = 0; i < span; i++) {
+        if (!(r->received & (1u << i))) missing |= 1u << i;
+    }
+    if (!missing) return false;
+    
+    uint8_t body[LINK_NACK_BODY];
+    put_u32(body, r->hash);
+    put_u16(&body[4], r->writer);
+    put_u16(&body[6], r->base);
+    put_u32(&body[8], missing);
+    if (!append(link, ESP_DDS_LINK_NACK, 0, body, sizeof(body), NULL, 0)) return false;
+    r->nacked_at = r->last;
+    link->nacks++;
+    return true;
+}
+
+// Large samples. Returns true if anything went into the frame; a fragment that could not
+// be sent stays for the next try.
+static bool send_fragments(esp_dds_link_t* link, esp_dds_link_outgoing_t* o, uint32_t budget) {
+    bool sent = false;
+    for (; budget && o->sent < o->size; budget--) {
+        uint32_t size = DDS_MIN(o->size - o->sent, (uint32_t)ESP_DDS_LINK_FRAGMENT_SIZE);
+        uint8_t header[LINK_FRAGMENT_HEADER];
+        put_u32(header, o->hash);
+        put_u16(&header[4], link->address);
+        put_u16(&header[6], o->sample);
+        put_u32(&header[8], o->size);
+        put_u32(&header[12], o->sent);
+        if (!append(link, ESP_DDS_LINK_FRAGMENT, 0, header, sizeof(header), &o->data[o->sent], size)) break;
+        o->sent += size;
+        link->fragments_sent++;
+        sent = true;
+    }
+    if (o->sent >= o->size) o->in_use = false;
+    return sent;
+}
+
+// Takes a free slot, or the oldest after sending the rest of its sample
+static bool send_large(esp_dds_link_t* link, uint32_t hash, const void* data, size_t size) {
+    esp_dds_link_outgoing_t* o = NULL;
+    for (uint8_t i = 0; i < ESP_DDS_LINK_OUTGOING; i++) {
+        esp_dds_link_outgoing_t* slot = &link->outgoing[i];
+        if (!slot->in_use) {
+            o = slot;
+            break;
+        }
+        if (!o || (uint16_t)(link->next_sample - slot->sample) > (uint16_t)(link->next_sample - o->sample)) o = slot;
+    }
+    while (o->in_use) {
+        if (!send_fragments(link, o, ESP_DDS_LINK_FRAGMENT_BURST)) o->in_use = false;  // Port refuses, give up
+    }
+    
+    o->hash = hash;
+    o->size = (uint32_t)size;
+    o->sent = 0;
+    o->sample = link->next_sample++;
+    memcpy(o->data, data, size);
+    o->in_use = true;
+    return true;
+}
+
+static bool is_answer(uint8_t kind) {
+    return kind != ESP_DDS_MESSAGE_REQUEST && kind != ESP_DDS_MESSAGE_GOAL && kind != ESP_DDS_MESSAGE_CANCEL;
+}
+
+// Answers go to the node in the upper half of the id, which the receiving side put there
+static bool append_message(esp_dds_link_t* link, uint8_t kind, uint8_t status, uint32_t hash, uint32_t id,
+                           const void* data, size_t size) {
+    uint8_t header[LINK_MESSAGE_HEADER];
+    put_u32(header, hash);
+    put_u16(&header[4], (uint16_t)id);
+    put_u16(&header[6], is_answer(kind) ? (uint16_t)(id >> 16) : link->address);
+    return append(link, (uint8_t)(ESP_DDS_LINK_MESSAGE + kind), status, header, sizeof(header), data, size);
+}
+
+// Action feedback
+static esp_dds_link_feedback_t* find_feedback(esp_dds_link_t* link, uint32_t hash, uint32_t id) {
+    for (uint8_t i = 0; i < ESP_DDS_LINK_FEEDBACK; i++) {
+        esp_dds_link_feedback_t* f = &link->feedback[i];
+        if (f->in_use && f->hash == hash && f->id == id) return f;
+    }
+    return NULL;
+}
+
+static bool send_feedback(esp_dds_link_t* link, esp_dds_link_feedback_t* f, uint32_t now) {
+    if (!append_message(link, ESP_DDS_MESSAGE_FEEDBACK, 0, f->hash, f->id, f->data, f->size)) return false;
+    f->waiting = false;
+    f->sent_us = now;
+    return true;
+}
+
+// Within the goal's period the value waits for flush, replacing an older one. A new goal
+// takes a free slot or one whose goal's period is over - taking a slot still inside its
+// period would let that goal's next feedback out early. Without one it goes out uncoalesced.
+static bool coalesce_feedback(esp_dds_link_t* link, const esp_dds_message_t* m) {
+    uint32_t now = link_now(link);
+    esp_dds_link_feedback_t* f = find_feedback(link, m->target_hash, m->id);
+    if (!f) {
+        for (uint8_t i = 0; i < ESP_DDS_LINK_FEEDBACK && !f; i++) {
+            esp_dds_link_feedback_t* slot = &link->feedback[i];
+            if (!slot->in_use || (!slot->waiting && now - slot->sent_us >= ESP_DDS_LINK_FEEDBACK_US)) f = slot;
+        }
+        if (!f) {
+            return append_message(link, ESP_DDS_MESSAGE_FEEDBACK, 0, m->target_hash, m->id, m->data, m->size) &&
+                   write_frame(link);
+        }
+        f->hash = m->target_hash;
+        f->id = m->id;
+        f->waiting = false;
+        f->sent_us = now - ESP_DDS_LINK_FEEDBACK_US;
+        f->in_use = true;
+    }
+    if (f->waiting) link->feedback_coalesced++;
+    memcpy(f->data, m->data, m->size);
+    f->size = (uint16_t)m->size;
+    f->waiting = true;
+    if (now - f->sent_us < ESP_DDS_LINK_FEEDBACK_US) return true;
+    return send_feedback(link, f, now) && write_frame(link);
+}
+
+static bool append_data(esp_dds_link_t* link, uint32_t hash, const void* data, size_t size) {
+    uint8_t header[LINK_DATA_HEADER];
+    put_u32(header, hash);
+    return append(link, ESP_DDS_LINK_DATA, 0, header, sizeof(header), data, size);
+}
+
+// Delta topics
+static esp_dds_link_delta_tx_t* find_delta_tx(esp_dds_link_t* link, uint32_t hash) {
+    for (uint8_t i = 0; i < ESP_DDS_LINK_DELTAS; i++) {
+        if (link->delta_tx[i].in_use && link->delta_tx[i].hash == hash) return &link->delta_tx[i];
+    }
+    return NULL;
+}
+
+static inline uint32_t delta_word(const uint8_t* sample, const uint32_t* key, size_t full, uint32_t tail, size_t i) {
+    uint32_t w = tail;
+    if (i < full) memcpy(&w, &sample[i * 4], 4);
+    return w ^ key[i];
+}
+
+// XORs the sample against the keyframe a word at a time, writing runs of unchanged and
+// changed words. False if the result would not be smaller than the sample.
+static bool delta_encode(const uint8_t* sample, const uint32_t* key, size_t size, uint8_t* out, size_t* used) {
+    size_t full = size / 4;
+    size_t words = (size + 3) / 4;
+    uint32_t tail = 0;
+    memcpy(&tail, &sample[full * 4], size % 4);
+    size_t n = 0;
+    size_t i = 0;
+    while (i < words) {
+        uint8_t unchanged = 0;
+        while (i < words && unchanged < 255 && !delta_word(sample, key, full, tail, i)) {
+            unchanged++;
+            i++;
+        }
+        if (i == words) break;  // Unchanged to the end, nothing to say
+        if (n + 2 > size) return false;
+        uint8_t* run = &out[n];
+        n += 2;
+        uint8_t changed = 0;
+        for (uint32_t w; i < words && changed < 255 && (w = delta_word(sample, key, full, tail, i)); i++) {
+            if (n + 4 > size) return false;
+            memcpy(&out[n], &w, 4);
+            n += 4;
+            changed++;
+        }
+        run[0] = unchanged;
+        run[1] = changed;
+    }
+    *used = n;
+    return n < size;
+}
+
+// Applies the runs to a copy of the keyframe, false if they run past its size
+static bool delta_decode(const uint32_t* key, size_t size, const uint8_t* runs, size_t length, uint32_t* sample) {
+    size_t words = (size + 3) / 4;
+    memcpy(sample, key, words * 4);
+    size_t i = 0;
+    size_t pos = 0;
+    while (pos < length) {
+        if (pos + 2 > length) return false;
+        i += runs[pos];
+        uint8_t changed = runs[pos + 1];
+        pos += 2;
+        if (i + changed > words || pos + changed * 4u > length) return false;
+        for (uint8_t k = 0; k < changed; k++, i++, pos += 4) {
+            uint32_t w;
+            memcpy(&w, &runs[pos], 4);
+            sample[i] ^= w;
+        }
+    }
+    return true;
+}
+
+static inline void keep_keyframe(uint32_t* words, const void* data, size_t size) {
+    if (size) words[(size - 1) / 4] = 0;  // Padding XORs to zero on both ends
+    memcpy(words, data, size);
+}
+
+// A keyframe when one is due or the receiver has none of this size, else a delta
+// against the acknowledged one. The ack of a pending keyframe makes it the new base.
+static bool send_delta(esp_dds_link_t* link, esp_dds_link_delta_tx_t* d, const void* data, size_t size) {
+    if (d->pending && __atomic_load_n(&d->ack, __ATOMIC_ACQUIRE) == (0x10000u | d->pending_key)) {
+        memcpy(d->base, d->next, sizeof(d->base));
+        d->base_key = d->pending_key;
+        d->base_size = d->pending_size;
+        d->acked = true;
+        d->pending = false;
+    }
+    bool usable = d->acked && d->base_size == size;
+    if (++d->since_keyframe >= d->keyframe_every || (!usable && !d->pending)) {
+        keep_keyframe(d->next, data, size);
+        d->pending_key = d->next_key++;
+        d->pending_size = (uint16_t)size;
+        d->pending = true;
+        d->since_keyframe = 0;
+        uint8_t header[LINK_KEYFRAME_HEADER];
+        put_u32(header, d->hash);
+        put_u16(&header[4], d->pending_key);
+        put_u16(&header[6], 0);
+        link->keyframes_sent++;
+        return append(link, ESP_DDS_LINK_KEYFRAME, 0, header, sizeof(header), data, size);
+    }
+    size_t used;
+    if (!usable || !delta_encode((const uint8_t*)data, d->base, size, d->encoded, &used)) {
+        return append_data(link, d->hash, data, size);
+    }
+    uint8_t header[LINK_DELTA_HEADER];
+    put_u32(header, d->hash);
+    put_u16(&header[4], d->base_key);
+    put_u16(&header[6], (uint16_t)size);
+    link->deltas_sent++;
+    return append(link, ESP_DDS_LINK_DELTA, 0, header, sizeof(header), d->encoded, used);
+}
+
+// Transport ops
+static bool link_open_topic(esp_dds_transport_t* tr, const char* topic, uint32_t hash,
+                            esp_dds_visibility_t visibility) {
+    esp_dds_link_t* link = (esp_dds_link_t*)tr;
+    esp_dds_link_writer_t* w = find_writer(link, hash);
+    if (visibility != ESP_DDS_NETWORK_RELIABLE) {
+        if (w) w->in_use = false;
+        return true;  // Samples carry the hash, nothing to set up per topic
+    }
+    if (w) return true;
+    for (uint8_t i = 0; i < ESP_DDS_LINK_WRITERS; i++) {
+        w = &link->writers[i];
+        if (w->in_use) continue;
+        w->hash = hash;
+        w->heartbeats = 0;
+        w->next_sequence = 1;
+        w->count = 0;
+        w->resend = 0;
+        w->in_use = true;
+        return true;
+    }
+    return false;
+}
+
+static bool link_send(esp_dds_transport_t* tr, const char* topic, uint32_t hash,
+                      const void* data, size_t size, uint32_t publish_us) {
+    esp_dds_link_t* link = (esp_dds_link_t*)tr;
+    if (size > ESP_DDS_MAX_MESSAGE_SIZE) return send_large(link, hash, data, size);
+    esp_dds_link_writer_t* w = find_writer(link, hash);
+    esp_dds_link_delta_tx_t* delta = w ? NULL : find_delta_tx(link, hash);
+    if (delta) return send_delta(link, delta, data, size);
+    if (!w && link->clock.period_us && !link->address) {
+        uint8_t header[LINK_TDATA_HEADER];
+        put_u32(header, hash);
+        put_u32(&header[4], publish_stamp(link, publish_us));
+        return append(link, ESP_DDS_LINK_TDATA, 0, header, sizeof(header), data, size);
+    }
+    if (!w) return append_data(link, hash, data, size);
+    
+    // Kept even if this frame fails, a reader asks for it once the next one arrives
+    uint16_t sequence = w->next_sequence++;
+    esp_dds_link_sample_t* sample = &w->history[sequence % ESP_DDS_LINK_HISTORY];
+    sample->sequence = sequence;
+    sample->size = (uint16_t)size;
+    memcpy(sample->data, data, size);
+    if (w->count < ESP_DDS_LINK_HISTORY) w->count++;
+    w->heartbeats = ESP_DDS_LINK_HEARTBEATS;
+    w->heartbeat_us = link_now(link);
+    return append_rdata(link, w, sample);
+}
+
+// Feedback whose period is up, resends, heartbeats, nacks, keyacks and fragments leave at once,
+// joining samples waiting for the window. A due time submessage goes alone only on an
+// idle link, a waiting frame takes it along when it leaves.
+static void link_flush(esp_dds_transport_t* tr) {
+    esp_dds_link_t* link = (esp_dds_link_t*)tr;
+    uint32_t now = link_now(link);
+    bool control = false;
+    if (!link->tx_used && clock_due(link, now)) control |= append_clock(link, now);
+    for (uint8_t i = 0; i < ESP_DDS_LINK_FEEDBACK; i++) {
+        esp_dds_link_feedback_t* f = &link->feedback[i];
+        if (f->in_use && f->waiting && now - f->sent_us >= ESP_DDS_LINK_FEEDBACK_US) {
+            control |= send_feedback(link, f, now);
+        }
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_OUTGOING; i++) {
+        esp_dds_link_outgoing_t* o = &link->outgoing[i];
+        if (o->in_use) control |= send_fragments(link, o, ESP_DDS_LINK_FRAGMENT_BURST);
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_WRITERS; i++) {
+        if (link->writers[i].in_use) control |= send_writer_control(link, &link->writers[i], now);
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_READERS; i++) {
+        esp_dds_link_reader_t* r = &link->readers[i];
+        if (r->in_use && r->nack_due) {
+            r->nack_due = false;
+            control |= send_nack(link, r);
+        }
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_DELTAS; i++) {
+        esp_dds_link_delta_rx_t* r = &link->delta_rx[i];
+        if (r->in_use && r->ack_due) {
+            r->ack_due = false;
+            uint8_t body[LINK_KEYACK_BODY];
+            put_u32(body, r->hash);
+            put_u16(&body[4], r->ack_key);
+            put_u16(&body[6], 0);
+            control |= append(link, ESP_DDS_LINK_KEYACK, 0, body, sizeof(body), NULL, 0);
+        }
+    }
+    if (link->tx_used && (control || !link->batch_us || now - link->batch_start_us >= link->batch_us)) {
+        write_frame(link);
+    }
+}
+
+// Feedback is coalesced, all other service and action traffic leaves at once, taking
+// queued samples along. A result ends its goal's feedback, sending what still waits.
+static bool link_send_message(esp_dds_transport_t* tr, const esp_dds_message_t* m) {
+    esp_dds_link_t* link = (esp_dds_link_t*)tr;
+    if (m->kind == ESP_DDS_MESSAGE_FEEDBACK) return coalesce_feedback(link, m);
+    if (m->kind == ESP_DDS_MESSAGE_RESULT) {
+        esp_dds_link_feedback_t* f = find_feedback(link, m->target_hash, m->id);
+        if (f && f->waiting) send_feedback(link, f, link_now(link));
+        if (f) f->in_use = false;
+    }
+    return append_message(link, m->kind, m->status, m->target_hash, m->id, m->data, m->size) && write_frame(link);
+}
+
+// Another task already receiving means this one has nothing to do but wait its turn
+static uint16_t link_poll(esp_dds_transport_t* tr, uint32_t timeout_ms) {
+    esp_dds_link_t* link = (esp_dds_link_t*)tr;
+    if (__atomic_exchange_n(&link->receiving, 1, __ATOMIC_ACQUIRE)) {
+        if (timeout_ms) DDS_DELAY(1);
+        return 0;
+    }
+    
+    // Wake up in time to send a queued frame when its window passes, a heartbeat, the
+    // next fragments, waiting feedback or the next time submessage
+    if (link->tx_used && link->batch_us) {
+        uint32_t waited_us = link_now(link) - link->batch_start_us;
+        uint32_t left_ms = waited_us < link->batch_us ? (link->batch_us - waited_us) / 1000 + 1 : 0;
+        if (left_ms < timeout_ms) timeout_ms = left_ms;
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_WRITERS; i++) {
+        if (link->writers[i].in_use && link->writers[i].heartbeats) {
+            timeout_ms = DDS_MIN(timeout_ms, ESP_DDS_LINK_HEARTBEAT_US / 1000);
+        }
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_OUTGOING; i++) {
+        if (link->outgoing[i].in_use) timeout_ms = 0;
+    }
+    if (link->clock.period_us && !link->address) {
+        uint32_t waited_us = link_now(link) - link->clock.sent_us;
+        uint32_t left_us = waited_us < link->clock.period_us ? link->clock.period_us - waited_us : 0;
+        timeout_ms = DDS_MIN(timeout_ms, left_us ? left_us / 1000 + 1 : 0);
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_FEEDBACK; i++) {
+        const esp_dds_link_feedback_t* f = &link->feedback[i];
+        if (f->in_use && f->waiting) {
+            uint32_t waited_us = link_now(link) - f->sent_us;
+            uint32_t left_us = waited_us < ESP_DDS_LINK_FEEDBACK_US ? ESP_DDS_LINK_FEEDBACK_US - waited_us : 0;
+            timeout_ms = DDS_MIN(timeout_ms, left_us ? left_us / 1000 + 1 : 0);
+        }
+    }
+    uint16_t handled = link->port->read(link, timeout_ms);
+    
+    __atomic_store_n(&link->receiving, 0, __ATOMIC_RELEASE);
+    return handled;
+}
+
+static const esp_dds_transport_ops_t link_ops = { link_open_topic, link_send, link_flush, link_send_message, link_poll };
+
+void esp_dds_link_init(esp_dds_link_t* link, const esp_dds_link_port_t* port) {
+    memset(link, 0, offsetof(esp_dds_link_t, tx));
+    link->base.ops = &link_ops;
+    link->port = port;
+    for (uint8_t i = 0; i < ESP_DDS_LINK_OUTGOING; i++) {
+        link->outgoing[i].in_use = false;
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_REASSEMBLY; i++) {
+        link->reassembly[i].in_use = false;
+    }
+    for (uint8_t i = 0; i < ESP_DDS_LINK_DELTAS; i++) {
+        link->delta_tx[i].in_use = false;
+        link->delta_tx[i].next_key = 0;
+        link->delta_rx[i].in_use = false;
+    }
+}
+
+void esp_dds_link_set_batching(esp_dds_link_t* link, uint32_t batch_us) {
+    link->batch_us = batch_us;
+}
+
+// Keyframe numbers carry on from an earlier use of the slot, so the receiver cannot
+// confuse an old keyframe with a new one
+bool esp_dds_link_set_delta(esp_dds_link_t* link, esp_dds_name_t topic, uint16_t keyframe_every) {
+    esp_dds_link_delta_tx_t* d = find_delta_tx(link, topic.hash);
+    if (!keyframe_every) {
+        if (d) d->in_use = false;
+        return true;
+    }
+    if (link->address) return false;
+    for (uint8_t i = 0; i < ESP_DDS_LINK_DELTAS && !d; i++) {
+        if (!link->delta_tx[i].in_use) d = &link->delta_tx[i];
+    }
+    if (!d) return false;
+    d->hash = topic.hash;
+    d->keyframe_every = keyframe_every;
+    d->since_keyframe = 0;
+    d->acked = false;
+    d->pending = false;
+    d->ack = 0;
+    d->in_use = true;
+    return true;
+}
+
+void esp_dds_link_set_clock_sync(esp_dds_link_t* link, uint32_t period_us) {
+    memset(&link->clock, 0, sizeof(link->clock));
+    link->clock.sent_us = link_now(link) - period_us;  // First one with the next flush
+    link->clock.period_us = period_us;
+}
+
+bool esp_dds_link_to_local_time(const esp_dds_link_t* link, uint32_t remote_us, uint32_t* local_us) {
+    const esp_dds_link_clock_t* c = &link->clock;
+    if (!c->synced) return false;
+    *local_us = remote_us - predicted_offset(c, remote_us - c->offset_us);
+    return true;
+}
+
+void esp_dds_link_get_latency(esp_dds_link_t* link, esp_dds_link_latency_t* latency, bool reset) {
+    *latency = link->latency;
+    if (reset) memset(&link->latency, 0, sizeof(link->latency));
+}
+
+uint32_t esp_dds_link_latency_percentile(const esp_dds_link_latency_t* latency, uint8_t percent) {
+    uint64_t wanted = ((uint64_t)latency->count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (uint8_t i = 0; latency->count && i < ESP_DDS_LINK_LATENCY_BUCKETS - 1; i++) {
+        seen += latency->buckets[i];
+        if (seen >= wanted && seen) return DDS_MIN(1u << i, latency->max_us);
+    }
+    return latency->max_us;
+}
+
+// Reliable readers
+static esp_dds_link_reader_t* find_reader(esp_dds_link_t* link, uint32_t hash, uint16_t writer) {
+    for (uint8_t i = 0; i < ESP_DDS_LINK_READERS; i++) {
+        esp_dds_link_reader_t* r = &link->readers[i];
+        if (r->in_use && r->hash == hash && r->writer == writer) return r;
+    }
+    return NULL;
+}
+
+static esp_dds_link_reader_t* add_reader(esp_dds_link_t* link, uint32_t hash, uint16_t writer, uint16_t first) {
+    for (uint8_t i = 0; i < ESP_DDS_LINK_READERS; i++) {
+        esp_dds_link_reader_t* r = &link->readers[i];
+        if (r->in_use) continue;
+        r->hash = hash;
+        r->writer = writer;
+        r->base = first;
+        r->last = (uint16_t)(first - 1);
+        r->nacked_at = r->last;
+        r->received = 0;
+        r->nack_due = false;
+        r->in_use = true;
+        return r;
+    }
+    return NULL;
+}
+
+// Moves base up to a sequence, giving up whatever below it never arrived
+static void reader_skip(esp_dds_link_t* link, esp_dds_link_reader_t* r, uint16_t to) {
+    while ((int16_t)(to - r->base) > 0) {
+        if (!(r->received & 1)) link->unrecovered++;
+        r->received >>= 1;
+        r->base++;
+    }
+    while (r->received & 1) {
+        r->received >>= 1;
+        r->base++;
+    }
+}
+
+// True the first time a sequence arrives. A gap is nacked when it opens, and again every
+// eighth of a history while it stays open, in case the nack or the resend got lost.
+static bool reader_accept(esp_dds_link_t* link, esp_dds_link_reader_t* r, uint16_t sequence, uint16_t first) {
+    reader_skip(link, r, first);
+    int16_t offset = (int16_t)(sequence - r->base);
+    if (offset < 0) return false;
+    if (offset > 31) {
+        reader_skip(link, r, (uint16_t)(sequence - 31));
+        offset = (int16_t)(sequence - r->base);
+    }
+    if (r->received & (1u << offset)) return false;
+    r->received |= 1u << offset;
+    bool opened = (int16_t)(sequence - r->last) > 1;
+    if ((int16_t)(sequence - r->last) > 0) r->last = sequence;
+    reader_skip(link, r, r->base);
+    if (r->received && (opened || (uint16_t)(r->last - r->nacked_at) >= ESP_DDS_LINK_HISTORY / 8)) {
+        r->nack_due = true;
+    }
+    return true;
+}
+
+static void writer_nacked(esp_dds_link_t* link, const uint8_t* b) {
+    if (get_u16(&b[4]) != link->address) return;  // Another node's writer
+    esp_dds_link_writer_t* w = find_writer(link, get_u32(b));
+    if (!w) return;
+    uint16_t base = get_u16(&b[6]);
+    uint32_t missing = get_u32(&b[8]);
+    uint32_t slots = 0;
+    for (uint8_t i = 0; missing; i++, missing >>= 1) {
+        uint16_t sequence = (uint16_t)(base + i);
+        uint16_t age = (uint16_t)(w->next_sequence - sequence);
+        if ((missing & 1) && age && age <= w->count) slots |= 1u << (sequence % ESP_DDS_LINK_HISTORY);
+    }
+    __atomic_fetch_or(&w->resend, slots, __ATOMIC_RELEASE);
+}
+
+// Finds the slot of a sample, or takes a free or expired one for its first fragment
+static esp_dds_link_reassembly_t* reassembly_slot(esp_dds_link_t* link, uint32_t hash, uint16_t writer,
+                                                  uint16_t sample, uint32_t size, uint32_t now) {
+    esp_dds_link_reassembly_t* spare = NULL;
+    for (uint8_t i = 0; i < ESP_DDS_LINK_REASSEMBLY; i++) {
+        esp_dds_link_reassembly_t* r = &link->reassembly[i];
+        if (r->in_use && r->hash == hash && r->writer == writer && r->sample == sample) {
+            return r->size == size ? r : NULL;
+        }
+        if (!spare && (!r->in_use || now - r->touched_us >= ESP_DDS_LINK_REASSEMBLY_US)) spare = r;
+    }
+    if (!spare) {
+        link->reassembly_overruns++;
+        return NULL;
+    }
+    if (spare->in_use) link->reassembly_expired++;
+    spare->hash = hash;
+    spare->writer = writer;
+    spare->sample = sample;
+    spare->size = size;
+    spare->arrived = 0;
+    memset(spare->fragments, 0, sizeof(spare->fragments));
+    spare->in_use = true;
+    return spare;
+}
+
+// Delivers the sample with its last fragment, in whatever order they came
+static uint16_t reassemble(esp_dds_link_t* link, const uint8_t* b, size_t body) {
+    uint32_t size = get_u32(&b[8]);
+    uint32_t offset = get_u32(&b[12]);
+    uint32_t length = (uint32_t)(body - LINK_FRAGMENT_HEADER);
+    if (size > ESP_DDS_MAX_SAMPLE_SIZE || offset >= size || offset % ESP_DDS_LINK_FRAGMENT_SIZE ||
+        !length || length > size - offset ||
+        (length != ESP_DDS_LINK_FRAGMENT_SIZE && offset + length != size)) {
+        link->frame_errors++;
+        return 0;
+    }
+    uint32_t now = link_now(link);
+    esp_dds_link_reassembly_t* r = reassembly_slot(link, get_u32(b), get_u16(&b[4]), get_u16(&b[6]), size, now);
+    if (!r) return 0;
+    uint32_t index = offset / ESP_DDS_LINK_FRAGMENT_SIZE;
+    uint32_t bit = 1u << (index % 32);
+    if (r->fragments[index / 32] & bit) return 0;
+    r->fragments[index / 32] |= bit;
+    memcpy(&r->data[offset], &b[LINK_FRAGMENT_HEADER], length);
+    r->arrived += length;
+    r->touched_us = now;
+    if (r->arrived < size) return 0;
+    
+    link->reassembled++;
+    uint16_t handled = esp_dds_transport_deliver(&link->base, r->hash, r->data, size);
+    r->in_use = false;
+    return handled;
+}
+
+// Delta topics, receiving side
+static esp_dds_link_delta_rx_t* find_delta_rx(esp_dds_link_t* link, uint32_t hash, bool add) {
+    esp_dds_link_delta_rx_t* spare = NULL;
+    for (uint8_t i = 0; i < ESP_DDS_LINK_DELTAS; i++) {
+        esp_dds_link_delta_rx_t* r = &link->delta_rx[i];
+        if (r->in_use && r->hash == hash) return r;
+        if (!spare && !r->in_use) spare = r;
+    }
+    if (!add || !spare) return NULL;
+    spare->hash = hash;
+    spare->has_base = false;
+    spare->has_newest = false;
+    spare->ack_due = false;
+    spare->in_use = true;
+    return spare;
+}
+
+// Kept and acknowledged if there is a slot, delivered either way
+static uint16_t receive_keyframe(esp_dds_link_t* link, const uint8_t* b, size_t body) {
+    uint32_t hash = get_u32(b);
+    size_t size = body - LINK_KEYFRAME_HEADER;
+    esp_dds_link_delta_rx_t* r = size <= ESP_DDS_MAX_MESSAGE_SIZE ? find_delta_rx(link, hash, true) : NULL;
+    if (r) {
+        keep_keyframe(r->newest, &b[LINK_KEYFRAME_HEADER], size);
+        r->newest_key = get_u16(&b[4]);
+        r->newest_size = (uint16_t)size;
+        r->has_newest = true;
+        r->ack_key = r->newest_key;
+        r->ack_due = true;
+    }
+    return esp_dds_transport_deliver(&link->base, hash, &b[LINK_KEYFRAME_HEADER], size);
+}
+
+// The first delta against the newest keyframe makes it the base
+static uint16_t receive_delta(esp_dds_link_t* link, const uint8_t* b, size_t body) {
+    uint32_t hash = get_u32(b);
+    uint16_t key = get_u16(&b[4]);
+    uint16_t size = get_u16(&b[6]);
+    esp_dds_link_delta_rx_t* r = find_delta_rx(link, hash, false);
+    if (r && r->has_newest && r->newest_key == key) {
+        memcpy(r->base, r->newest, sizeof(r->base));
+        r->base_key = key;
+        r->base_size = r->newest_size;
+        r->has_base = true;
+        r->has_newest = false;
+    }
+    if (!r || !r->has_base || r->base_key != key || r->base_size != size) {
+        link->delta_misses++;
+        return 0;
+    }
+    if (!delta_decode(r->base, size, &b[LINK_DELTA_HEADER], body - LINK_DELTA_HEADER, r->sample)) {
+        link->frame_errors++;
+        return 0;
+    }
+    return esp_dds_transport_deliver(&link->base, hash, r->sample, size);
+}
+
+// Samples go to the domain like local publishes, messages to the service and action
+// bookkeeping. A malformed submessage ends the frame, what came before it stands.
+uint16_t esp_dds_link_input(esp_dds_link_t* link, const uint8_t* frame, size_t size) {
+    if (size < ESP_DDS_LINK_FRAME_HEADER || frame[0] != ESP_DDS_LINK_VERSION) {
+        link->frame_errors++;
+        return 0;
+    }
+    // A frame behind the expected sequence is late or repeated, not a jump over the rest of
+    // the sequence space; its submessages still count, reliable samples drop duplicates
+    uint16_t sequence = get_u16(&frame[2]);
+    int16_t gap = (int16_t)(sequence - link->rx_sequence);
+    if (!link->rx_synced || gap >= 0) {
+        if (link->rx_synced) link->frames_lost += (uint16_t)gap;
+        link->rx_sequence = (uint16_t)(sequence + 1);
+        link->rx_synced = true;
+    } else {
+        link->frames_reordered++;
+    }
+    link->frames_received++;
+    
+    uint16_t handled = 0;
+    size_t pos = ESP_DDS_LINK_FRAME_HEADER;
+    while (pos + ESP_DDS_LINK_SUB_HEADER <= size) {
+        const uint8_t* p = &frame[pos];
+        size_t body = get_u16(&p[2]);
+        pos += ESP_DDS_LINK_SUB_HEADER;
+        if (pos + body > size) {
+            link->frame_errors++;
+            break;
+        }
+        const uint8_t* b = &frame[pos];
+        pos += LINK_PAD(body);
+        
+        uint8_t kind = p[0];
+        if (kind == ESP_DDS_LINK_DATA && body >= LINK_DATA_HEADER) {
+            handled += esp_dds_transport_deliver(&link->base, get_u32(b), &b[LINK_DATA_HEADER],
+                                                 body - LINK_DATA_HEADER);
+        } else if (kind == ESP_DDS_LINK_RDATA && body >= LINK_RDATA_HEADER) {
+            // Readers beyond ESP_DDS_LINK_READERS get best effort
+            uint32_t hash = get_u32(b);
+            uint16_t writer = get_u16(&b[4]);
+            uint16_t first = get_u16(&b[8]);
+            esp_dds_link_reader_t* r = find_reader(link, hash, writer);
+            if (!r) r = add_reader(link, hash, writer, first);
+            if (r && !reader_accept(link, r, get_u16(&b[6]), first)) {
+                link->duplicates++;
+                continue;
+            }
+            handled += esp_dds_transport_deliver(&link->base, hash, &b[LINK_RDATA_HEADER],
+                                                 body - LINK_RDATA_HEADER);
+        } else if (kind == ESP_DDS_LINK_HEARTBEAT && body >= LINK_HEARTBEAT_BODY) {
+            esp_dds_link_reader_t* r = find_reader(link, get_u32(b), get_u16(&b[4]));
+            if (!r) continue;
+            reader_skip(link, r, get_u16(&b[6]));
+            uint16_t last = get_u16(&b[8]);
+            if ((int16_t)(last - r->last) > 0) r->last = last;
+            if ((int16_t)(r->last - r->base) >= 0) r->nack_due = true;
+        } else if (kind == ESP_DDS_LINK_NACK && body >= LINK_NACK_BODY) {
+            writer_nacked(link, b);
+        } else if (kind == ESP_DDS_LINK_TDATA && body >= LINK_TDATA_HEADER) {
+            uint32_t hash = get_u32(b);
+            record_latency(link, get_u32(&b[4]), link_now(link));
+            handled += esp_dds_transport_deliver(&link->base, hash, &b[LINK_TDATA_HEADER],
+                                                 body - LINK_TDATA_HEADER);
+        } else if (kind == ESP_DDS_LINK_TIME && body >= LINK_TIME_BODY) {
+            clock_exchange(link, b, link_now(link));
+        } else if (kind == ESP_DDS_LINK_KEYFRAME && body >= LINK_KEYFRAME_HEADER) {
+            handled += receive_keyframe(link, b, body);
+        } else if (kind == ESP_DDS_LINK_DELTA && body >= LINK_DELTA_HEADER) {
+            handled += receive_delta(link, b, body);
+        } else if (kind == ESP_DDS_LINK_KEYACK && body >= LINK_KEYACK_BODY) {
+            esp_dds_link_delta_tx_t* d = find_delta_tx(link, get_u32(b));
+            if (d) __atomic_store_n(&d->ack, 0x10000u | get_u16(&b[4]), __ATOMIC_RELEASE);
+        } else if (kind == ESP_DDS_LINK_FRAGMENT && body >= LINK_FRAGMENT_HEADER) {
+            handled += reassemble(link, b, body);
+        } else if (kind >= ESP_DDS_LINK_MESSAGE && kind <= ESP_DDS_LINK_MESSAGE + ESP_DDS_MESSAGE_CANCEL &&
+                   body >= LINK_MESSAGE_HEADER) {
+            uint8_t message_kind = (uint8_t)(kind - ESP_DDS_LINK_MESSAGE);
+            uint16_t node = get_u16(&b[6]);
+            if (is_answer(message_kind) && link->address && node != link->address) continue;  // Someone else's
+            
+            uint32_t id = is_answer(message_kind) ? get_u16(&b[4]) : ((uint32_t)node << 16) | get_u16(&b[4]);
+            esp_dds_message_t m = { &b[LINK_MESSAGE_HEADER], body - LINK_MESSAGE_HEADER, get_u32(b), id,
+                                    message_kind, p[1] };
+            esp_dds_transport_receive(&link->base, &m);
+            handled++;
+        }
+    }
+    return handled;
+}
@@ -0,0 +1,365 @@
+#ifndef ESP_DDS_LINK_H
+#define ESP_DDS_LINK_H
+
+#include "esp_dds.h"
+
+// Frame layer under the serial and datagram transports. Samples of network-visible
+// topics and service/action messages become submessages tagged with their name hash,
+// queued in a static TX buffer until the frame is full, the publish call ends or the
+// batching window has passed. A batch publish therefore leaves as one frame. The port
+// below only moves whole frames.
+//
+//   frame      = version:u8 flags:u8 sequence:u16 submessage...
+//   submessage = kind:u8 status:u8 length:u16 body, body padded to 4 bytes
+//   data       = hash:u32 payload
+//   message    = hash:u32 id:u16 node:u16 payload
+//   rdata      = hash:u32 writer:u16 sequence:u16 first:u16 reserved:u16 payload
+//   heartbeat  = hash:u32 writer:u16 first:u16 last:u16 reserved:u16
+//   nack       = hash:u32 writer:u16 base:u16 missing:u32
+//   fragment   = hash:u32 writer:u16 sample:u16 total:u32 offset:u32 payload
+//   time       = sent:u32 echo_sent:u32 echo_received:u32 flags:u32
+//   tdata      = hash:u32 published:u32 payload
+//   keyframe   = hash:u32 key:u16 reserved:u16 payload
+//   delta      = hash:u32 key:u16 size:u16 run...
+//   run        = unchanged:u8 changed:u8 word:u32 * changed
+//   keyack     = hash:u32 key:u16 reserved:u16
+//
+// Fields are little endian. Padding keeps payloads 4-byte aligned in a received frame,
+// so subscribers may read them in place. Receivers skip kinds they do not know.
+//
+// On a medium shared by several nodes each link has its own address. Requests, goals
+// and cancels carry the sender's address in node, answers the address they are for;
+// a link takes only answers for its own address. Address 0 (point to point) takes all.
+//
+// Samples of ESP_DDS_NETWORK_RELIABLE topics go out as rdata, numbered per writer (topic
+// and address) and kept in a static history. Each one tells the readers which sequences
+// the history still holds, so a reader spots a gap with the next sample and asks for the
+// missing ones with a nack. Only a writer that went quiet sends heartbeats, a few, so
+// readers also notice a lost last sample. Repaired samples may arrive after later ones,
+// each is delivered once. A gap older than the history is given up (unrecovered). A
+// reader new to a writer catches up on what its history still holds.
+//
+// Samples above ESP_DDS_MAX_MESSAGE_SIZE (up to ESP_DDS_MAX_SAMPLE_SIZE) are copied to
+// an outgoing slot and leave as fragments, one per frame, best effort even on reliable
+// topics. Each flush sends a few fragments of every outgoing sample, so other topics'
+// samples and several large ones interleave, esp_dds_process_transports sends the rest.
+// A publish that finds every slot busy first finishes the oldest. The receiver collects
+// fragments in a reassembly slot per sample and delivers the sample once complete; a
+// slot without a new fragment for ESP_DDS_LINK_REASSEMBLY_US is given up.
+//
+// Action feedback is coalesced: a goal's feedback leaves at most once per
+// ESP_DDS_LINK_FEEDBACK_US, a newer value replaces the one waiting and flush sends it
+// when the period is up. Every other message is the priority lane and leaves at once,
+// ahead of waiting feedback and fragments; a result first takes its goal's waiting
+// feedback along, so the client still sees the latest value.
+//
+// Clock sync estimates the peer's clock NTP style. Every period a time submessage rides
+// along with the next frame, or goes alone on a quiet link; it carries its send time and
+// echoes the peer's last one with its arrival time. The four timestamps of an exchange
+// give the offset between the clocks and the round trip; exchanges slowed by queueing
+// are skipped, and the change of the offset over time gives the drift. Best-effort
+// samples then go out as tdata with their publish time, which the receiver translates
+// to its own clock to file the sample's latency in a histogram. Clocks may be anywhere
+// relative to each other, 32-bit wrap included. Point to point links only, a link with
+// an address does not sync.
+//
+// Delta topics are for telemetry that changes a few bytes per sample. The sender keeps
+// the last keyframe the receiver acknowledged and sends each sample as its XOR against
+// it, as runs of unchanged and changed 32-bit words; words past the last change are not
+// sent. A keyframe (the full sample) goes out every keyframe_every samples, and whenever
+// there is nothing acknowledged of the sample's size; until its ack is back, samples are
+// deltas against the previous one. A sample whose delta would not be smaller goes out
+// as plain data. The receiver keeps the newest keyframe and the one deltas refer to, a
+// delta against one it does not have is dropped (delta_misses) until the next keyframe
+// gets through. Best effort, point to point, up to ESP_DDS_MAX_MESSAGE_SIZE; samples of
+// delta topics carry no publish time.
+#ifndef ESP_DDS_LINK_MTU
+#define ESP_DDS_LINK_MTU 512              // Largest frame before port framing
+#endif
+
+#ifndef ESP_DDS_LINK_WRITERS
+#define ESP_DDS_LINK_WRITERS 2            // Reliable topics this node publishes
+#endif
+#ifndef ESP_DDS_LINK_HISTORY
+#define ESP_DDS_LINK_HISTORY 16           // Samples each reliable writer can resend, max 32
+#endif
+#ifndef ESP_DDS_LINK_READERS
+#define ESP_DDS_LINK_READERS 4            // Reliable writers tracked on the receiving side
+#endif
+#ifndef ESP_DDS_LINK_HEARTBEAT_US
+#define ESP_DDS_LINK_HEARTBEAT_US 10000   // Heartbeat period of a quiet writer
+#endif
+#define ESP_DDS_LINK_HEARTBEATS 10        // Heartbeats after a writer's last sample or resend
+#ifndef ESP_DDS_LINK_OUTGOING
+#define ESP_DDS_LINK_OUTGOING 2           // Large samples being sent at the same time
+#endif
+#ifndef ESP_DDS_LINK_REASSEMBLY
+#define ESP_DDS_LINK_REASSEMBLY 2         // Large samples being received at the same time
+#endif
+#ifndef ESP_DDS_LINK_REASSEMBLY_US
+#define ESP_DDS_LINK_REASSEMBLY_US 100000 // Incomplete sample lifetime after its last fragment
+#endif
+#ifndef ESP_DDS_LINK_FRAGMENT_BURST
+#define ESP_DDS_LINK_FRAGMENT_BURST 4     // Fragments of each outgoing sample per flush
+#endif
+#ifndef ESP_DDS_LINK_FEEDBACK
+#define ESP_DDS_LINK_FEEDBACK 2           // Goals whose feedback is coalesced at the same time
+#endif
+#ifndef ESP_DDS_LINK_DELTAS
+#define ESP_DDS_LINK_DELTAS 2             // Delta topics per direction
+#endif
+#ifndef ESP_DDS_LINK_DRIFT_US
+#define ESP_DDS_LINK_DRIFT_US 1000000     // Offset change measured over at least this long
+#endif
+#define ESP_DDS_LINK_LATENCY_BUCKETS 20   // Bucket i: latency below 2^i us, the last takes the rest
+#ifndef ESP_DDS_LINK_FEEDBACK_US
+#define ESP_DDS_LINK_FEEDBACK_US 10000    // Shortest gap between two feedback messages of a goal
+#endif
+
+#define ESP_DDS_LINK_VERSION 1
+#define ESP_DDS_LINK_FRAME_HEADER 4
+#define ESP_DDS_LINK_SUB_HEADER 4
+#define ESP_DDS_LINK_DATA 0x01            // Submessage kinds
+#define ESP_DDS_LINK_RDATA 0x02
+#define ESP_DDS_LINK_HEARTBEAT 0x03
+#define ESP_DDS_LINK_NACK 0x04
+#define ESP_DDS_LINK_FRAGMENT 0x05
+#define ESP_DDS_LINK_TIME 0x06
+#define ESP_DDS_LINK_TDATA 0x07
+#define ESP_DDS_LINK_KEYFRAME 0x08
+#define ESP_DDS_LINK_DELTA 0x09
+#define ESP_DDS_LINK_KEYACK 0x0A
+#define ESP_DDS_LINK_MESSAGE 0x10         // Plus esp_dds_message_kind_t
+
+typedef char esp_dds_link_mtu_check[(ESP_DDS_LINK_MTU >= ESP_DDS_LINK_FRAME_HEADER + ESP_DDS_LINK_SUB_HEADER + 12 +
+                                     ESP_DDS_MAX_MESSAGE_SIZE + 3 && ESP_DDS_LINK_MTU <= 0xFFFF) ? 1 : -1];
+typedef char esp_dds_link_sample_check[(ESP_DDS_MAX_SAMPLE_SIZE >= ESP_DDS_MAX_MESSAGE_SIZE) ? 1 : -1];
+typedef char esp_dds_link_history_check[(ESP_DDS_LINK_HISTORY >= 1 && ESP_DDS_LINK_HISTORY <= 32) ? 1 : -1];
+
+typedef struct esp_dds_link_s esp_dds_link_t;
+
+// Port hooks. write sends one complete frame, it runs under the domain mutex and should
+// only queue. read waits up to timeout_ms for input, hands each complete frame to
+// esp_dds_link_input and returns the sum of what that handled. clock times the batching
+// window for ports with their own notion of time, NULL means DDS_MICROS().
+typedef struct {
+    bool (*write)(esp_dds_link_t* link, const uint8_t* frame, size_t size);
+    uint16_t (*read)(esp_dds_link_t* link, uint32_t timeout_ms);
+    uint32_t (*clock)(esp_dds_link_t* link);
+} esp_dds_link_port_t;
+
+typedef struct {
+    uint16_t sequence;
+    uint16_t size;
+    uint8_t data[ESP_DDS_MAX_MESSAGE_SIZE] __attribute__((aligned(4)));
+} esp_dds_link_sample_t;
+
+// Sending side of one reliable topic
+typedef struct {
+    uint32_t hash;
+    bool in_use;
+    uint8_t heartbeats;            // Still to send before the writer goes silent
+    uint16_t next_sequence;
+    uint16_t count;                // Samples in the history
+    uint32_t heartbeat_us;         // Last sample, resend or heartbeat
+    volatile uint32_t resend;      // History slots readers asked for, set by the receiving task
+    esp_dds_link_sample_t history[ESP_DDS_LINK_HISTORY];  // Slot = sequence % ESP_DDS_LINK_HISTORY
+} esp_dds_link_writer_t;
+
+// Receiving side of one remote reliable writer. Updated by the receiving task and read
+// under the domain mutex to build nacks; a stale read costs at most a redundant resend.
+typedef struct {
+    uint32_t hash;
+    uint16_t writer;               // Writer's link address
+    uint16_t base;                 // Oldest sequence still missing
+    uint16_t last;                 // Newest sequence the writer announced
+    uint16_t nacked_at;            // last when the previous nack went out
+    bool in_use;
+    volatile bool nack_due;
+    uint32_t received;             // Bit i: base + i arrived
+} esp_dds_link_reader_t;
+
+// Payload of one fragment, the rest of a frame holding nothing else
+#define ESP_DDS_LINK_FRAGMENT_SIZE \
+    ((ESP_DDS_LINK_MTU - ESP_DDS_LINK_FRAME_HEADER - ESP_DDS_LINK_SUB_HEADER - 16) & ~3u)
+#define ESP_DDS_LINK_FRAGMENT_WORDS ((ESP_DDS_MAX_SAMPLE_SIZE / ESP_DDS_LINK_FRAGMENT_SIZE + 32) / 32)
+
+// Large sample on its way out
+typedef struct {
+    uint32_t hash;
+    uint32_t size;
+    uint32_t sent;                 // Bytes already in fragments
+    uint16_t sample;
+    bool in_use;
+    uint8_t data[ESP_DDS_MAX_SAMPLE_SIZE] __attribute__((aligned(4)));
+} esp_dds_link_outgoing_t;
+
+// Large sample being put together, touched only by the receiving task
+typedef struct {
+    uint32_t hash;
+    uint32_t size;
+    uint32_t arrived;              // Bytes so far
+    uint32_t touched_us;           // Last fragment
+    uint16_t writer;
+    uint16_t sample;
+    bool in_use;
+    uint32_t fragments[ESP_DDS_LINK_FRAGMENT_WORDS];  // Bit i: fragment i arrived
+    uint8_t data[ESP_DDS_MAX_SAMPLE_SIZE] __attribute__((aligned(4)));
+} esp_dds_link_reassembly_t;
+
+// Latest feedback of one remote goal, waiting for its period
+typedef struct {
+    uint32_t hash;
+    uint32_t id;                   // Goal id with the client's address in the upper half
+    uint32_t sent_us;              // Last feedback that left
+    uint16_t size;
+    bool waiting;                  // data holds a value not sent yet
+    bool in_use;
+    uint8_t data[ESP_DDS_MAX_MESSAGE_SIZE] __attribute__((aligned(4)));
+} esp_dds_link_feedback_t;
+
+#define ESP_DDS_LINK_DELTA_WORDS ((ESP_DDS_MAX_MESSAGE_SIZE + 3) / 4)
+
+// Sending side of one delta topic
+typedef struct {
+    uint32_t hash;
+    bool in_use;
+    bool acked;                    // base holds a keyframe the receiver has
+    bool pending;                  // next holds a keyframe waiting for its ack
+    uint16_t keyframe_every;
+    uint16_t since_keyframe;       // Samples since the last keyframe
+    uint16_t next_key;             // Number of the next keyframe
+    uint16_t base_key;
+    uint16_t base_size;
+    uint16_t pending_key;
+    uint16_t pending_size;
+    volatile uint32_t ack;         // Last keyack, key plus 0x10000; set by the receiving task
+    uint32_t base[ESP_DDS_LINK_DELTA_WORDS];   // Zero past the size
+    uint32_t next[ESP_DDS_LINK_DELTA_WORDS];
+    uint8_t encoded[ESP_DDS_MAX_MESSAGE_SIZE] __attribute__((aligned(4)));
+} esp_dds_link_delta_tx_t;
+
+// Receiving side of one delta topic, touched by the receiving task; ack_due and
+// ack_key are read under the domain mutex to send the keyack
+typedef struct {
+    uint32_t hash;
+    bool in_use;
+    bool has_base;
+    bool has_newest;
+    volatile bool ack_due;
+    uint16_t ack_key;
+    uint16_t base_key;             // Keyframe the sender's deltas refer to
+    uint16_t base_size;
+    uint16_t newest_key;           // Keyframe received last, base once a delta refers to it
+    uint16_t newest_size;
+    uint32_t base[ESP_DDS_LINK_DELTA_WORDS];
+    uint32_t newest[ESP_DDS_LINK_DELTA_WORDS];
+    uint32_t sample[ESP_DDS_LINK_DELTA_WORDS]; // Decoded
+} esp_dds_link_delta_rx_t;
+
+// Estimate of the peer's clock, updated by the receiving task
+typedef struct {
+    uint32_t period_us;            // Between time submessages, 0 = off
+    uint32_t sent_us;              // Last time submessage out
+    uint32_t peer_sent;            // Send time of the peer's last one, peer clock
+    uint32_t peer_received_us;     // Its arrival
+    bool heard;                    // peer_sent is valid
+    bool synced;                   // offset_us is valid
+    uint32_t offset_us;            // Peer clock minus local clock at offset_at_us, modulo 2^32
+    uint32_t offset_at_us;
+    int32_t drift_ppb;             // Peer clock rate minus local, parts per billion
+    uint32_t drift_offset_us;      // Offset at the start of the drift measurement
+    uint32_t drift_at_us;
+    uint32_t round_trip_us;        // Of the last exchange used
+    uint32_t best_round_trip_us;   // Fastest exchange lately, creeps up so it can follow the path
+    uint32_t exchanges;            // Used
+    uint32_t skipped;              // Too slow to trust
+} esp_dds_link_clock_t;
+
+// Publish to arrival of samples from the peer, in the receiver's clock
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t early;                // Arrived before their translated publish time, counted as 0 us
+    uint32_t buckets[ESP_DDS_LINK_LATENCY_BUCKETS];
+} esp_dds_link_latency_t;
+
+struct esp_dds_link_s {
+    esp_dds_transport_t base;      // Attached to the domain
+    const esp_dds_link_port_t* port;
+    uint32_t batch_us;             // Samples wait this long for company, 0 = one frame per publish call
+    uint32_t batch_start_us;       // When the oldest queued submessage arrived
+    uint16_t tx_used;
+    uint16_t tx_sequence;
+    uint16_t rx_sequence;          // Next sequence expected from the peer
+    uint16_t address;              // This node on a shared medium, 0 = point to point
+    bool rx_synced;
+    volatile uint32_t receiving;   // One reader at a time, others back off
+    uint32_t frames_sent;
+    uint32_t frames_received;
+    uint32_t frames_lost;          // Sequence gaps seen by the receiver
+    uint32_t frames_reordered;     // Frames behind the sequence expected, late or duplicated
+    uint32_t frame_errors;         // Bad checksum, framing or layout
+    uint32_t write_failures;
+    uint32_t resent;               // Reliable samples sent again on request
+    uint32_t nacks;
+    uint32_t heartbeats;
+    uint32_t duplicates;           // Reliable samples received twice, dropped
+    uint32_t unrecovered;          // Reliable samples given up by the receiver
+    uint32_t fragments_sent;
+    uint32_t reassembled;          // Large samples delivered
+    uint32_t reassembly_expired;   // Large samples given up, a fragment missing
+    uint32_t reassembly_overruns;  // Fragments dropped, every slot busy
+    uint32_t feedback_coalesced;   // Feedback replaced by a newer value before it left
+    uint32_t keyframes_sent;
+    uint32_t deltas_sent;
+    uint32_t delta_misses;         // Deltas dropped, their keyframe not here
+    uint16_t next_sample;          // Numbers large samples sent
+    esp_dds_link_writer_t writers[ESP_DDS_LINK_WRITERS];
+    esp_dds_link_reader_t readers[ESP_DDS_LINK_READERS];
+    esp_dds_link_feedback_t feedback[ESP_DDS_LINK_FEEDBACK];
+    esp_dds_link_clock_t clock;
+    esp_dds_link_latency_t latency;
+    uint8_t tx[ESP_DDS_LINK_MTU] __attribute__((aligned(4)));
+    esp_dds_link_outgoing_t outgoing[ESP_DDS_LINK_OUTGOING];
+    esp_dds_link_reassembly_t reassembly[ESP_DDS_LINK_REASSEMBLY];
+    esp_dds_link_delta_tx_t delta_tx[ESP_DDS_LINK_DELTAS];
+    esp_dds_link_delta_rx_t delta_rx[ESP_DDS_LINK_DELTAS];
+};
+
+// For ports: resets the link state and installs the frame layer as transport ops
+void esp_dds_link_init(esp_dds_link_t* link, const esp_dds_link_port_t* port);
+uint16_t esp_dds_link_input(esp_dds_link_t* link, const uint8_t* frame, size_t size);
+
+// Latency for bandwidth: samples of later publish calls may join a queued frame for up
+// to batch_us, esp_dds_process_transports sends it once the window has passed
+void esp_dds_link_set_batching(esp_dds_link_t* link, uint32_t batch_us);
+
+// Starts (period_us > 0) or stops clock sync. Both ends turn it on; samples carry their
+// publish time while it runs, 4 bytes more each.
+void esp_dds_link_set_clock_sync(esp_dds_link_t* link, uint32_t period_us);
+
+// Sends a best-effort topic as deltas with a keyframe every keyframe_every samples
+// (0 = plain samples again). Set before traffic flows; false if every slot is taken or
+// the link has an address. The receiver needs no setup.
+bool esp_dds_link_set_delta(esp_dds_link_t* link, esp_dds_name_t topic, uint16_t keyframe_every);
+
+// Translates a peer timestamp to the local clock, false until the first exchange
+bool esp_dds_link_to_local_time(const esp_dds_link_t* link, uint32_t remote_us, uint32_t* local_us);
+
+// Copies the latency histogram, reset starts a new one
+void esp_dds_link_get_latency(esp_dds_link_t* link, esp_dds_link_latency_t* latency, bool reset);
+
+// Upper bound of the bucket holding the given percentile, max_us for the last bucket
+uint32_t esp_dds_link_latency_percentile(const esp_dds_link_latency_t* latency, uint8_t percent);
+
+#define ESP_DDS_LINK_SET_BATCHING(link, batch_us) esp_dds_link_set_batching(link, batch_us)
+#define ESP_DDS_LINK_SET_CLOCK_SYNC(link, period_us) esp_dds_link_set_clock_sync(link, period_us)
+#define ESP_DDS_LINK_SET_DELTA(link, topic, keyframe_every) \
+    esp_dds_link_set_delta(link, ESP_DDS_NAME(topic), keyframe_every)
+#define ESP_DDS_LINK_TO_LOCAL_TIME(link, remote_us, local_us) esp_dds_link_to_local_time(link, remote_us, local_us)
+#define ESP_DDS_LINK_GET_LATENCY(link, latency, reset) esp_dds_link_get_latency(link, latency, reset)
+
+#endif // ESP_DDS_LINK_H
@@ -0,0 +1,140 @@
+#ifndef ESP_DDS_MSG_H
+#define ESP_DDS_MSG_H
+
+#include "esp_dds.h"
+
+// Support for message types generated by tools/esp_dds_gen.py from ROS2-style .msg files.
+// A generated header holds the C struct, its type hash and a serializer/deserializer
+// pair for the little-endian wire format: fields in order, no padding, bounded strings
+// and sequences as a u16 count followed by the elements. Where the struct already has
+// the wire layout on a little-endian target, both are a plain memcpy; the compiler
+// settles that at build time.
+//
+//   python3 tools/esp_dds_gen.py -o src msg/Imu.msg      // writes src/imu_msg.h
+//
+//   imu_t imu = {...};
+//   ESP_DDS_PUBLISH_TYPED("/imu", imu);
+//   ESP_DDS_SUBSCRIBE_TYPED("/imu", imu_t, on_imu, NULL);  // void on_imu(const char*, const imu_t&, void*)
+//
+// Samples that fail to deserialize (wrong size, count over its bound) never reach the
+// typed callback.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define ESP_DDS_WIRE_NATIVE 0
+#else
+#define ESP_DDS_WIRE_NATIVE 1             // Target byte order is the wire's
+#endif
+
+// Little-endian stores and loads through memcpy, so any alignment is fine
+#if ESP_DDS_WIRE_NATIVE
+#define ESP_DDS_WIRE_SWAP16(v) (v)
+#define ESP_DDS_WIRE_SWAP32(v) (v)
+#define ESP_DDS_WIRE_SWAP64(v) (v)
+#else
+#define ESP_DDS_WIRE_SWAP16(v) __builtin_bswap16(v)
+#define ESP_DDS_WIRE_SWAP32(v) __builtin_bswap32(v)
+#define ESP_DDS_WIRE_SWAP64(v) __builtin_bswap64(v)
+#endif
+
+static inline void esp_dds_put_u8(uint8_t* p, uint8_t v) { *p = v; }
+static inline void esp_dds_put_u16(uint8_t* p, uint16_t v) {
+    v = ESP_DDS_WIRE_SWAP16(v);
+    memcpy(p, &v, sizeof(v));
+}
+static inline void esp_dds_put_u32(uint8_t* p, uint32_t v) {
+    v = ESP_DDS_WIRE_SWAP32(v);
+    memcpy(p, &v, sizeof(v));
+}
+static inline void esp_dds_put_u64(uint8_t* p, uint64_t v) {
+    v = ESP_DDS_WIRE_SWAP64(v);
+    memcpy(p, &v, sizeof(v));
+}
+static inline void esp_dds_put_f32(uint8_t* p, float v) {
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    esp_dds_put_u32(p, u);
+}
+static inline void esp_dds_put_f64(uint8_t* p, double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    esp_dds_put_u64(p, u);
+}
+
+static inline uint8_t esp_dds_get_u8(const uint8_t* p) { return *p; }
+static inline uint16_t esp_dds_get_u16(const uint8_t* p) {
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return ESP_DDS_WIRE_SWAP16(v);
+}
+static inline uint32_t esp_dds_get_u32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return ESP_DDS_WIRE_SWAP32(v);
+}
+static inline uint64_t esp_dds_get_u64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return ESP_DDS_WIRE_SWAP64(v);
+}
+static inline float esp_dds_get_f32(const uint8_t* p) {
+    uint32_t u = esp_dds_get_u32(p);
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+static inline double esp_dds_get_f64(const uint8_t* p) {
+    uint64_t u = esp_dds_get_u64(p);
+    double v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+#ifdef __cplusplus
+namespace esp_dds {
+
+// Specialized by every generated header:
+//   type_hash, max_wire_size, serialize(const T*, uint8_t*) -> size,
+//   deserialize(T*, const uint8_t*, size_t) -> bool
+template <typename T> struct MessageTraits;
+
+template <typename T>
+bool publish(esp_dds_domain_t* domain, esp_dds_name_t topic, const T& message) {
+    uint8_t wire[MessageTraits<T>::max_wire_size] __attribute__((aligned(8)));
+    size_t size = MessageTraits<T>::serialize(&message, wire);
+    return esp_dds_domain_publish_typed(domain, topic, MessageTraits<T>::type_hash, wire, size);
+}
+
+// One trampoline per type and callback, the subscription's context passes through
+template <typename T, void (*Callback)(const char* topic, const T& message, void* context)>
+void dispatch(const char* topic, const void* data, size_t size, void* context) {
+    T message;
+    if (MessageTraits<T>::deserialize(&message, (const uint8_t*)data, size)) Callback(topic, message, context);
+}
+
+template <typename T, void (*Callback)(const char* topic, const T& message, void* context)>
+bool subscribe(esp_dds_domain_t* domain, esp_dds_name_t topic, void* context) {
+    return esp_dds_domain_subscribe_typed(domain, topic, MessageTraits<T>::type_hash, &dispatch<T, Callback>, context);
+}
+
+template <typename T, void (*Callback)(const char* topic, const T& message, void* context)>
+void unsubscribe(esp_dds_domain_t* domain, esp_dds_name_t topic) {
+    esp_dds_domain_unsubscribe_name(domain, topic, &dispatch<T, Callback>);
+}
+
+} // namespace esp_dds
+
+#define ESP_DDS_PUBLISH_TYPED(topic, message) \
+    esp_dds::publish(esp_dds_default_domain(), ESP_DDS_NAME(topic), message)
+#define ESP_DDS_SUBSCRIBE_TYPED(topic, type, callback, context) \
+    esp_dds::subscribe<type, callback>(esp_dds_default_domain(), ESP_DDS_NAME(topic), context)
+#define ESP_DDS_UNSUBSCRIBE_TYPED(topic, type, callback) \
+    esp_dds::unsubscribe<type, callback>(esp_dds_default_domain(), ESP_DDS_NAME(topic))
+
+#define ESP_DDS_DOMAIN_PUBLISH_TYPED(domain, topic, message) \
+    esp_dds::publish(domain, ESP_DDS_NAME(topic), message)
+#define ESP_DDS_DOMAIN_SUBSCRIBE_TYPED(domain, topic, type, callback, context) \
+    esp_dds::subscribe<type, callback>(domain, ESP_DDS_NAME(topic), context)
+#define ESP_DDS_DOMAIN_UNSUBSCRIBE_TYPED(domain, topic, type, callback) \
+    esp_dds::unsubscribe<type, callback>(domain, ESP_DDS_NAME(topic))
+#endif
+
+#endif // ESP_DDS_MSG_H
@@ -0,0 +1,290 @@
+#include "esp_dds_shm.h"
+
+#ifdef ESP_DDS_SHM_AVAILABLE
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define SHM_MAGIC 0x53444453UL       // "SDDS", written last by the creator
+#define SHM_SLOT_BYTES ((ESP_DDS_MAX_MESSAGE_SIZE + 7) & ~7)
+#define SHM_SLOT_MASK (ESP_DDS_SHM_SLOTS - 1)
+#define SHM_PATH_LENGTH (ESP_DDS_SHM_MAX_GROUP_LENGTH + ESP_DDS_MAX_NAME_LENGTH + 2)
+
+typedef char shm_slots_check[(ESP_DDS_SHM_SLOTS & SHM_SLOT_MASK) == 0 ? 1 : -1];
+
+// Seqlock per slot: 2n + 1 while sample n is written, 2n + 2 once it is complete
+typedef struct {
+    uint32_t seq;
+    uint32_t size;
+    uint32_t publish_us;
+    uint32_t reserved;
+    uint8_t data[SHM_SLOT_BYTES];
+} shm_slot_t;
+
+struct esp_dds_shm_segment_s {
+    uint32_t magic;
+    uint32_t slot_count;           // Layout checks, builds with other limits refuse the ring
+    uint32_t slot_bytes;
+    uint32_t hash;
+    uint32_t users;                // Mappings, the last to close unlinks
+    uint32_t write_seq;            // Samples written, only the writer stores it
+    uint64_t writer;               // Claiming transport's writer_id, 0 = unclaimed
+    char name[ESP_DDS_MAX_NAME_LENGTH];
+    shm_slot_t slots[ESP_DDS_SHM_SLOTS];
+};
+
+// Group doorbell - every write bumps rings, readers sleep on it as a futex
+struct esp_dds_shm_bell_s {
+    uint32_t magic;
+    uint32_t users;
+    uint32_t rings;
+    uint32_t waiters;              // Writers skip the wake syscall while nobody sleeps
+};
+
+static uint32_t shm_instances;
+
+static void segment_path(char* path, const char* group, const char* topic) {
+    int n = snprintf(path, SHM_PATH_LENGTH, "/%s", group);
+    for (const char* c = topic; *c && n < SHM_PATH_LENGTH - 1; c++) {
+        path[n++] = (*c == '/') ? '.' : *c;
+    }
+    path[n] = '\0';
+}
+
+// Creates or opens a segment of the given size. The creator sizes it, everyone else
+// waits for that and then for the creator's magic.
+static void* map_segment(const char* path, size_t bytes, bool* created) {
+    int fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+    *created = (fd >= 0);
+    if (fd < 0) {
+        if (errno != EEXIST || (fd = shm_open(path, O_RDWR, 0600)) < 0) return NULL;
+    } else if (ftruncate(fd, (off_t)bytes) != 0) {
+        close(fd);
+        shm_unlink(path);
+        return NULL;
+    }
+    
+    struct stat st;
+    st.st_size = 0;
+    for (int i = 0; i < 1000 && fstat(fd, &st) == 0 && (size_t)st.st_size < bytes; i++) {
+        usleep(100);
+    }
+    void* p = ((size_t)st.st_size == bytes)
+        ? mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    return (p == MAP_FAILED) ? NULL : p;
+}
+
+static bool wait_magic(const uint32_t* magic) {
+    for (int i = 0; i < 1000 && __atomic_load_n(magic, __ATOMIC_ACQUIRE) != SHM_MAGIC; i++) {
+        usleep(100);
+    }
+    return __atomic_load_n(magic, __ATOMIC_ACQUIRE) == SHM_MAGIC;
+}
+
+static void unmap_segment(void* p, size_t bytes, uint32_t* users, const char* path) {
+    if (__atomic_sub_fetch(users, 1, __ATOMIC_ACQ_REL) == 0) shm_unlink(path);
+    munmap(p, bytes);
+}
+
+static esp_dds_shm_topic_t* find_ring(esp_dds_shm_t* shm, uint32_t hash) {
+    for (uint8_t i = 0; i < shm->topic_count; i++) {
+        if (shm->topics[i].hash == hash) return &shm->topics[i];
+    }
+    return NULL;
+}
+
+static bool shm_open_topic(esp_dds_transport_t* tr, const char* topic, uint32_t hash,
+                           esp_dds_visibility_t visibility) {
+    esp_dds_shm_t* shm = (esp_dds_shm_t*)tr;
+    if (find_ring(shm, hash)) return true;
+    if (shm->topic_count >= ESP_DDS_SHM_MAX_TOPICS) return false;
+    
+    char path[SHM_PATH_LENGTH];
+    segment_path(path, shm->group, topic);
+    bool created;
+    esp_dds_shm_segment_t* seg = (esp_dds_shm_segment_t*)map_segment(path, sizeof(*seg), &created);
+    if (!seg) return false;
+    if (created) {
+        seg->slot_count = ESP_DDS_SHM_SLOTS;
+        seg->slot_bytes = SHM_SLOT_BYTES;
+        seg->hash = hash;
+        strncpy(seg->name, topic, sizeof(seg->name) - 1);
+        __atomic_store_n(&seg->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+    if (!wait_magic(&seg->magic) || seg->slot_count != ESP_DDS_SHM_SLOTS ||
+        seg->slot_bytes != SHM_SLOT_BYTES || seg->hash != hash) {
+        munmap(seg, sizeof(*seg));
+        return false;
+    }
+    __atomic_add_fetch(&seg->users, 1, __ATOMIC_ACQ_REL);
+    
+    esp_dds_shm_topic_t* ring = &shm->topics[shm->topic_count++];
+    ring->segment = seg;
+    ring->hash = hash;
+    ring->writer = false;
+    ring->read_seq = __atomic_load_n(&seg->write_seq, __ATOMIC_ACQUIRE);
+    return true;
+}
+
+// Takes an unclaimed ring, or one whose writer's process no longer exists
+static bool claim_ring(esp_dds_shm_t* shm, esp_dds_shm_topic_t* ring) {
+    uint64_t owner = __atomic_load_n(&ring->segment->writer, __ATOMIC_ACQUIRE);
+    if (owner && (kill((pid_t)(owner >> 32), 0) == 0 || errno != ESRCH)) return false;
+    if (!__atomic_compare_exchange_n(&ring->segment->writer, &owner, shm->writer_id, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    ring->writer = true;
+    return true;
+}
+
+static bool shm_send(esp_dds_transport_t* tr, const char* topic, uint32_t hash,
+                     const void* data, size_t size, uint32_t publish_us) {
+    esp_dds_shm_t* shm = (esp_dds_shm_t*)tr;
+    esp_dds_shm_topic_t* ring = find_ring(shm, hash);
+    if (size > ESP_DDS_MAX_MESSAGE_SIZE || !ring || !(ring->writer || claim_ring(shm, ring))) return false;
+    
+    esp_dds_shm_segment_t* seg = ring->segment;
+    uint32_t n = seg->write_seq;
+    shm_slot_t* slot = &seg->slots[n & SHM_SLOT_MASK];
+    __atomic_store_n(&slot->seq, 2 * n + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->size = (uint32_t)size;
+    slot->publish_us = publish_us;
+    memcpy(slot->data, data, size);
+    __atomic_store_n(&slot->seq, 2 * n + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&seg->write_seq, n + 1, __ATOMIC_RELEASE);
+    
+    // Pairs with the reader's waiters increment before it sleeps on an unchanged count
+    esp_dds_shm_bell_t* bell = shm->bell;
+    __atomic_add_fetch(&bell->rings, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&bell->waiters, __ATOMIC_SEQ_CST)) {
+        syscall(SYS_futex, &bell->rings, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+    return true;
+}
+
+// Delivers every complete sample the reader has not seen. Each is copied out of its slot
+// and delivered only if the slot's sequence still matches after the copy, so a writer
+// lapping a slow reader costs samples but never hands a torn one to the subscribers.
+static uint16_t drain_ring(esp_dds_shm_t* shm, esp_dds_shm_topic_t* ring) {
+    esp_dds_shm_segment_t* seg = ring->segment;
+    uint32_t written = __atomic_load_n(&seg->write_seq, __ATOMIC_ACQUIRE);
+    if (written - ring->read_seq > ESP_DDS_SHM_SLOTS) {
+        shm->lost += written - ring->read_seq - ESP_DDS_SHM_SLOTS;
+        ring->read_seq = written - ESP_DDS_SHM_SLOTS;
+    }
+    
+    uint16_t delivered = 0;
+    while (ring->read_seq != written) {
+        uint32_t n = ring->read_seq++;
+        shm_slot_t* slot = &seg->slots[n & SHM_SLOT_MASK];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != 2 * n + 2) {
+            shm->lost++;
+            continue;
+        }
+        uint32_t size = slot->size;
+        if (size <= ESP_DDS_MAX_MESSAGE_SIZE) memcpy(shm->sample, slot->data, size);
+        
+        // Overwritten while it was copied
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != 2 * n + 2 || size > ESP_DDS_MAX_MESSAGE_SIZE) {
+            shm->lost++;
+            continue;
+        }
+        esp_dds_transport_deliver(&shm->base, ring->hash, shm->sample, size);
+        delivered++;
+    }
+    return delivered;
+}
+
+static uint16_t drain_rings(esp_dds_shm_t* shm) {
+    uint16_t delivered = 0;
+    for (uint8_t i = 0; i < shm->topic_count; i++) {
+        if (!shm->topics[i].writer) delivered += drain_ring(shm, &shm->topics[i]);
+    }
+    return delivered;
+}
+
+// Sleeps on the doorbell until a ring of this reader has samples or the timeout expires
+static uint16_t shm_poll(esp_dds_transport_t* tr, uint32_t timeout_ms) {
+    esp_dds_shm_t* shm = (esp_dds_shm_t*)tr;
+    esp_dds_shm_bell_t* bell = shm->bell;
+    uint32_t start = DDS_MILLIS();
+    
+    while (true) {
+        uint32_t rings = __atomic_load_n(&bell->rings, __ATOMIC_SEQ_CST);
+        uint16_t delivered = drain_rings(shm);
+        uint32_t elapsed = DDS_MILLIS() - start;
+        if (delivered || elapsed >= timeout_ms) return delivered;
+        
+        uint32_t remaining = timeout_ms - elapsed;
+        struct timespec ts = { (time_t)(remaining / 1000), (long)(remaining % 1000) * 1000000L };
+        __atomic_add_fetch(&bell->waiters, 1, __ATOMIC_SEQ_CST);
+        syscall(SYS_futex, &bell->rings, FUTEX_WAIT, rings, &ts, NULL, 0);
+        __atomic_sub_fetch(&bell->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+static const esp_dds_transport_ops_t shm_ops = { shm_open_topic, shm_send, NULL, NULL, shm_poll };
+
+bool esp_dds_domain_shm_open(esp_dds_domain_t* d, esp_dds_shm_t* shm, const char* group) {
+    if (!d || !shm || !group || !group[0] || strlen(group) >= ESP_DDS_SHM_MAX_GROUP_LENGTH ||
+        strchr(group, '/')) {
+        return false;
+    }
+    memset(shm, 0, sizeof(*shm));
+    shm->base.ops = &shm_ops;
+    strcpy(shm->group, group);
+    shm->writer_id = ((uint64_t)getpid() << 32) | __atomic_add_fetch(&shm_instances, 1, __ATOMIC_RELAXED);
+    
+    char path[SHM_PATH_LENGTH];
+    snprintf(path, sizeof(path), "/%s", group);
+    bool created;
+    esp_dds_shm_bell_t* bell = (esp_dds_shm_bell_t*)map_segment(path, sizeof(*bell), &created);
+    if (!bell) return false;
+    if (created) __atomic_store_n(&bell->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+    if (!wait_magic(&bell->magic)) {
+        munmap(bell, sizeof(*bell));
+        return false;
+    }
+    __atomic_add_fetch(&bell->users, 1, __ATOMIC_ACQ_REL);
+    shm->bell = bell;
+    
+    if (!esp_dds_domain_attach_transport(d, &shm->base)) {
+        esp_dds_shm_close(shm);
+        return false;
+    }
+    return true;
+}
+
+void esp_dds_shm_close(esp_dds_shm_t* shm) {
+    if (!shm || !shm->bell) return;
+    esp_dds_detach_transport(&shm->base);
+    
+    char path[SHM_PATH_LENGTH];
+    for (uint8_t i = 0; i < shm->topic_count; i++) {
+        esp_dds_shm_segment_t* seg = shm->topics[i].segment;
+        uint64_t owner = shm->writer_id;
+        __atomic_compare_exchange_n(&seg->writer, &owner, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        segment_path(path, shm->group, seg->name);
+        unmap_segment(seg, sizeof(*seg), &seg->users, path);
+    }
+    shm->topic_count = 0;
+    
+    snprintf(path, sizeof(path), "/%s", shm->group);
+    unmap_segment(shm->bell, sizeof(*shm->bell), &shm->bell->users, path);
+    shm->bell = NULL;
+}
+
+bool esp_dds_shm_open(esp_dds_shm_t* shm, const char* group) {
+    return esp_dds_domain_shm_open(esp_dds_default_domain(), shm, group);
+}
+
+#endif
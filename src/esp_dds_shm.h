@@ -0,0 +1,64 @@
+#ifndef ESP_DDS_SHM_H
+#define ESP_DDS_SHM_H
+
+#include "esp_dds.h"
+
+// Shared-memory transport for firmware builds running as Linux processes (simulation,
+// hardware-in-the-loop). Each network-visible topic maps to the POSIX shared-memory
+// segment "/<group>.<topic>" with '/' in the topic turned into '.', holding a ring of
+// ESP_DDS_SHM_SLOTS samples. One transport writes a topic, any number read it. Readers
+// sleep on a futex in the group's doorbell segment "/<group>" and copy each sample out
+// of the ring before delivering it. A sample the writer overwrites before the copy is
+// complete, or a reader ESP_DDS_SHM_SLOTS samples behind, counts as lost.
+//
+//   static esp_dds_shm_t shm;
+//   ESP_DDS_SHM_OPEN(&shm, "sim");
+//   ESP_DDS_SET_TOPIC_VISIBILITY("/motor/cmd", ESP_DDS_NETWORK_VISIBLE);
+//   while (true) ESP_DDS_PROCESS_TRANSPORTS(10);
+#if defined(DDS_HOST) && defined(__linux__)
+#define ESP_DDS_SHM_AVAILABLE 1
+
+#ifndef ESP_DDS_SHM_MAX_TOPICS
+#define ESP_DDS_SHM_MAX_TOPICS 16         // Rings mapped by one transport
+#endif
+#ifndef ESP_DDS_SHM_SLOTS
+#define ESP_DDS_SHM_SLOTS 64              // Samples per ring, power of two
+#endif
+#define ESP_DDS_SHM_MAX_GROUP_LENGTH 24
+
+typedef struct esp_dds_shm_segment_s esp_dds_shm_segment_t;
+typedef struct esp_dds_shm_bell_s esp_dds_shm_bell_t;
+
+// One mapped ring
+typedef struct {
+    esp_dds_shm_segment_t* segment;
+    uint32_t hash;
+    uint32_t read_seq;             // Next sample to deliver
+    bool writer;                   // This transport owns the ring and never reads it
+} esp_dds_shm_topic_t;
+
+typedef struct {
+    esp_dds_transport_t base;      // Attached to the domain
+    char group[ESP_DDS_SHM_MAX_GROUP_LENGTH];
+    uint64_t writer_id;            // Process id and instance, claims rings
+    esp_dds_shm_bell_t* bell;
+    esp_dds_shm_topic_t topics[ESP_DDS_SHM_MAX_TOPICS];
+    uint8_t topic_count;
+    uint32_t lost;                 // Samples overwritten before this reader got them
+    uint8_t sample[ESP_DDS_MAX_MESSAGE_SIZE] __attribute__((aligned(8)));  // Copy being delivered
+} esp_dds_shm_t;
+
+// Opens the group's doorbell and attaches the transport. The first transport to publish
+// a topic owns its ring until it closes or its process exits, publishing elsewhere then
+// counts as dropped. Late readers start with the next sample written.
+bool esp_dds_shm_open(esp_dds_shm_t* shm, const char* group);  // On the default domain
+bool esp_dds_domain_shm_open(esp_dds_domain_t* domain, esp_dds_shm_t* shm, const char* group);
+void esp_dds_shm_close(esp_dds_shm_t* shm);  // Detaches, the last user unlinks each segment
+
+#define ESP_DDS_SHM_OPEN(shm, group) esp_dds_shm_open(shm, group)
+#define ESP_DDS_DOMAIN_SHM_OPEN(domain, shm, group) esp_dds_domain_shm_open(domain, shm, group)
+#define ESP_DDS_SHM_CLOSE(shm) esp_dds_shm_close(shm)
+
+#endif
+
+#endif // ESP_DDS_SHM_H
@@ -0,0 +1,136 @@
+#include "esp_dds_sim.h"
+
+// xorshift32, never 0 once seeded
+static uint32_t sim_random(esp_dds_sim_net_t* net) {
+    uint32_t x = net->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    net->random = x;
+    return x;
+}
+
+static inline bool sim_reached(uint32_t now_us, uint32_t due_us) {
+    return (int32_t)(now_us - due_us) >= 0;
+}
+
+// Keeps the queue ordered by due time, frames due at the same time in send order
+static bool queue_push(esp_dds_sim_node_t* node, uint32_t due_us, uint16_t frame) {
+    if (node->queued >= ESP_DDS_SIM_QUEUE) return false;
+    uint16_t i = node->queued++;
+    while (i > 0 && (int32_t)(node->queue[i - 1].due_us - due_us) > 0) {
+        node->queue[i] = node->queue[i - 1];
+        i--;
+    }
+    node->queue[i].due_us = due_us;
+    node->queue[i].frame = frame;
+    return true;
+}
+
+// One copy of the frame, one delivery per receiver that does not lose it
+static bool sim_write(esp_dds_link_t* link, const uint8_t* data, size_t size) {
+    esp_dds_sim_node_t* node = (esp_dds_sim_node_t*)link;
+    esp_dds_sim_net_t* net = node->net;
+    uint16_t slot = 0;
+    while (slot < ESP_DDS_SIM_FRAMES && net->frames[slot].receivers) slot++;
+    if (slot == ESP_DDS_SIM_FRAMES) {
+        net->overruns++;
+        return false;
+    }
+    
+    // The medium carries one frame at a time
+    uint32_t wire = (uint32_t)size + net->config.frame_overhead;
+    if (!sim_reached(net->medium_free_us, net->now_us)) net->medium_free_us = net->now_us;
+    if (net->config.bandwidth_bps) {
+        net->medium_free_us += (uint32_t)((uint64_t)wire * 8000000ULL / net->config.bandwidth_bps);
+    }
+    net->frames_sent++;
+    net->bytes_sent += wire;
+    
+    esp_dds_sim_frame_t* f = &net->frames[slot];
+    memcpy(f->data, data, size);
+    f->size = (uint16_t)size;
+    for (uint8_t i = 0; i < net->node_count; i++) {
+        esp_dds_sim_node_t* receiver = net->nodes[i];
+        if (receiver == node) continue;
+        if (net->config.loss_permille && sim_random(net) % 1000 < net->config.loss_permille) {
+            net->frames_lost++;
+            continue;
+        }
+        uint32_t due_us = net->medium_free_us + net->config.latency_us;
+        if (net->config.jitter_us) due_us += sim_random(net) % (net->config.jitter_us + 1);
+        if (queue_push(receiver, due_us, slot)) {
+            f->receivers++;
+        } else {
+            receiver->overruns++;
+        }
+    }
+    return true;
+}
+
+// The clock only moves between runs, so there is nothing to wait for
+static uint16_t sim_read(esp_dds_link_t* link, uint32_t timeout_ms) {
+    esp_dds_sim_node_t* node = (esp_dds_sim_node_t*)link;
+    esp_dds_sim_net_t* net = node->net;
+    uint16_t handled = 0;
+    uint16_t taken = 0;
+    while (taken < node->queued && sim_reached(net->now_us, node->queue[taken].due_us)) {
+        esp_dds_sim_frame_t* f = &net->frames[node->queue[taken++].frame];
+        handled += esp_dds_link_input(link, f->data, f->size);
+        f->receivers--;
+    }
+    if (taken) {
+        node->queued -= taken;
+        memmove(node->queue, &node->queue[taken], node->queued * sizeof(node->queue[0]));
+    }
+    return handled;
+}
+
+static uint32_t sim_clock(esp_dds_link_t* link) {
+    return ((esp_dds_sim_node_t*)link)->net->now_us;
+}
+
+static const esp_dds_link_port_t sim_port = { sim_write, sim_read, sim_clock };
+
+void esp_dds_sim_init(esp_dds_sim_net_t* net, const esp_dds_sim_config_t* config) {
+    memset(net, 0, offsetof(esp_dds_sim_net_t, frames));
+    for (uint16_t i = 0; i < ESP_DDS_SIM_FRAMES; i++) {
+        net->frames[i].receivers = 0;
+    }
+    net->config = *config;
+    net->random = config->seed ? config->seed : 1;
+}
+
+bool esp_dds_sim_add_node(esp_dds_sim_net_t* net, esp_dds_sim_node_t* node, esp_dds_domain_t* domain) {
+    if (!net || !node || !domain || net->node_count >= ESP_DDS_SIM_MAX_NODES) return false;
+    esp_dds_link_init(&node->link, &sim_port);
+    node->link.address = (uint16_t)(net->node_count + 1);
+    node->net = net;
+    node->queued = 0;
+    node->overruns = 0;
+    if (!esp_dds_domain_attach_transport(domain, &node->link.base)) return false;
+    net->nodes[net->node_count++] = node;
+    return true;
+}
+
+uint32_t esp_dds_sim_run(esp_dds_sim_net_t* net, uint32_t duration_us, uint32_t step_us) {
+    uint32_t handled = 0;
+    uint32_t elapsed = 0;
+    if (!step_us) step_us = duration_us ? duration_us : 1;
+    do {
+        uint32_t step = DDS_MIN(step_us, duration_us - elapsed);
+        net->now_us += step;
+        elapsed += step;
+        for (uint8_t i = 0; i < net->node_count; i++) {
+            handled += esp_dds_domain_process_transports(net->nodes[i]->link.base.domain, 0);
+        }
+    } while (elapsed < duration_us);
+    return handled;
+}
+
+void esp_dds_sim_close(esp_dds_sim_net_t* net) {
+    for (uint8_t i = 0; i < net->node_count; i++) {
+        esp_dds_detach_transport(&net->nodes[i]->link.base);
+    }
+    net->node_count = 0;
+}
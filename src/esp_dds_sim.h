@@ -0,0 +1,97 @@
+#ifndef ESP_DDS_SIM_H
+#define ESP_DDS_SIM_H
+
+#include "esp_dds_link.h"
+
+// Simulated network - many participants in one process, each a domain with a node
+// attached as its transport. Nodes share one broadcast medium with configurable latency,
+// jitter, bandwidth and loss. Time is virtual and moves only in esp_dds_sim_run, which
+// then lets every node receive in turn, and loss and jitter come from a seeded generator,
+// so a run repeats exactly. Nodes speak the link frame format, so network-visible topics,
+// services, actions and batching behave as on a real link.
+//
+//   static esp_dds_sim_net_t net;
+//   static esp_dds_sim_node_t nodes[20];
+//   esp_dds_sim_config_t config = {500, 200, 1000000, 10, 30, 42};
+//   ESP_DDS_SIM_INIT(&net, &config);
+//   for (int i = 0; i < 20; i++) ESP_DDS_SIM_ADD_NODE(&net, &nodes[i], domains[i]);
+//   ESP_DDS_SIM_RUN(&net, 100000, 1000);      // 100 ms in 1 ms steps
+//
+// The clock stands still while a remote sync call waits, use the async forms and
+// ESP_DDS_DOMAIN_PROCESS_PENDING between runs instead.
+#ifndef ESP_DDS_SIM_MAX_NODES
+#define ESP_DDS_SIM_MAX_NODES 64
+#endif
+#ifndef ESP_DDS_SIM_FRAMES
+#define ESP_DDS_SIM_FRAMES 128            // Frames in flight on the whole network
+#endif
+#ifndef ESP_DDS_SIM_QUEUE
+#define ESP_DDS_SIM_QUEUE 64              // Frames waiting for one receiver
+#endif
+
+typedef char esp_dds_sim_nodes_check[(ESP_DDS_SIM_MAX_NODES <= 255) ? 1 : -1];
+
+typedef struct {
+    uint32_t latency_us;           // Every frame takes at least this long
+    uint32_t jitter_us;            // Plus 0..jitter_us, drawn per receiver
+    uint32_t bandwidth_bps;        // Shared by all senders, 0 = unlimited
+    uint16_t loss_permille;        // Chance that a receiver misses a frame
+    uint16_t frame_overhead;       // Bytes the medium adds to each frame
+    uint32_t seed;                 // Same seed and traffic, same run
+} esp_dds_sim_config_t;
+
+typedef struct esp_dds_sim_net_s esp_dds_sim_net_t;
+
+typedef struct {
+    uint32_t due_us;
+    uint16_t frame;
+} esp_dds_sim_delivery_t;
+
+typedef struct {
+    esp_dds_link_t link;           // Attached to the node's domain
+    esp_dds_sim_net_t* net;
+    uint16_t queued;
+    uint32_t overruns;             // Frames lost to a full receive queue
+    esp_dds_sim_delivery_t queue[ESP_DDS_SIM_QUEUE];  // Ordered by due time
+} esp_dds_sim_node_t;
+
+typedef struct {
+    uint16_t size;
+    uint8_t receivers;             // Queued deliveries, 0 = slot free
+    uint8_t data[ESP_DDS_LINK_MTU] __attribute__((aligned(4)));
+} esp_dds_sim_frame_t;
+
+struct esp_dds_sim_net_s {
+    esp_dds_sim_config_t config;
+    uint32_t now_us;               // Virtual clock
+    uint32_t medium_free_us;       // When the medium has sent the last frame
+    uint32_t random;
+    uint8_t node_count;
+    esp_dds_sim_node_t* nodes[ESP_DDS_SIM_MAX_NODES];
+    uint32_t frames_sent;
+    uint32_t bytes_sent;           // Including frame_overhead
+    uint32_t frames_lost;          // Deliveries dropped by loss_permille
+    uint32_t overruns;             // Frames not sent, every slot in flight
+    esp_dds_sim_frame_t frames[ESP_DDS_SIM_FRAMES];
+};
+
+// Clears the network, the clock starts at 0
+void esp_dds_sim_init(esp_dds_sim_net_t* net, const esp_dds_sim_config_t* config);
+
+// Attaches a node to a domain, one node per domain, and gives it the next link address
+// starting at 1. Nodes stay until esp_dds_sim_close.
+bool esp_dds_sim_add_node(esp_dds_sim_net_t* net, esp_dds_sim_node_t* node, esp_dds_domain_t* domain);
+
+// Advances the clock in steps, after each step every node in order sends what its
+// batching window released and receives what has arrived. Returns samples and
+// messages handled.
+uint32_t esp_dds_sim_run(esp_dds_sim_net_t* net, uint32_t duration_us, uint32_t step_us);
+
+void esp_dds_sim_close(esp_dds_sim_net_t* net);  // Detaches every node
+
+#define ESP_DDS_SIM_INIT(net, config) esp_dds_sim_init(net, config)
+#define ESP_DDS_SIM_ADD_NODE(net, node, domain) esp_dds_sim_add_node(net, node, domain)
+#define ESP_DDS_SIM_RUN(net, duration_us, step_us) esp_dds_sim_run(net, duration_us, step_us)
+#define ESP_DDS_SIM_CLOSE(net) esp_dds_sim_close(net)
+
+#endif // ESP_DDS_SIM_H
@@ -0,0 +1,306 @@
+#include "esp_dds_uart.h"
+
+#ifdef ESP_PLATFORM
+#include "driver/uart.h"
+#elif defined(DDS_HOST)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#endif
+
+#if defined(ESP_PLATFORM) || defined(DDS_HOST)
+#define CRC_INIT 0xFFFF
+
+// CRC-16/CCITT-FALSE, a nibble at a time from a 16-entry table
+static const uint16_t crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static uint16_t crc16(const uint8_t* p, size_t size, uint16_t crc) {
+    while (size--) {
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (*p >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (*p++ & 0x0F)]);
+    }
+    return crc;
+}
+
+// COBS encoder writing straight into the TX buffer, one byte at a time
+typedef struct {
+    uint8_t* out;
+    size_t used;
+    size_t code_at;                // Where the current block's length byte goes
+    uint8_t code;
+} cobs_writer_t;
+
+static void cobs_put(cobs_writer_t* w, uint8_t b) {
+    if (b) {
+        w->out[w->used++] = b;
+        w->code++;
+    }
+    if (!b || w->code == 0xFF) {
+        w->out[w->code_at] = w->code;
+        w->code = 1;
+        w->code_at = w->used++;
+    }
+}
+
+// Closes the last block and appends the frame delimiter
+static size_t cobs_finish(cobs_writer_t* w) {
+    w->out[w->code_at] = w->code;
+    w->out[w->used++] = 0;
+    return w->used;
+}
+
+// Decodes in place (the output never overtakes the input), 0 if malformed
+static size_t cobs_decode(uint8_t* buf, size_t size) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < size) {
+        uint8_t code = buf[in++];
+        if (!code || in + code - 1 > size) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            buf[out++] = buf[in++];
+        }
+        if (code != 0xFF && in < size) buf[out++] = 0;
+    }
+    return out;
+}
+
+static bool port_write(esp_dds_uart_t* u, const uint8_t* data, size_t size);
+
+static bool uart_write(esp_dds_link_t* link, const uint8_t* frame, size_t size) {
+    esp_dds_uart_t* u = (esp_dds_uart_t*)link;
+    uint16_t crc = crc16(frame, size, CRC_INIT);
+    cobs_writer_t w = { u->tx, 1, 0, 1 };
+    for (size_t i = 0; i < size; i++) {
+        cobs_put(&w, frame[i]);
+    }
+    cobs_put(&w, (uint8_t)crc);
+    cobs_put(&w, (uint8_t)(crc >> 8));
+    return port_write(u, u->tx, cobs_finish(&w));
+}
+
+static uint16_t input_frame(esp_dds_uart_t* u) {
+    size_t size = cobs_decode(u->frame, u->frame_used);
+    if (size < 2 + ESP_DDS_LINK_FRAME_HEADER ||
+        crc16(u->frame, size - 2, CRC_INIT) != (uint16_t)(u->frame[size - 2] | (u->frame[size - 1] << 8))) {
+        u->link.frame_errors++;
+        return 0;
+    }
+    return esp_dds_link_input(&u->link, u->frame, size - 2);
+}
+
+// Collects encoded bytes up to each delimiter, a frame too long for the buffer is
+// dropped whole
+static uint16_t input_bytes(esp_dds_uart_t* u, const uint8_t* bytes, size_t count) {
+    uint16_t handled = 0;
+    u->bytes_received += (uint32_t)count;
+    for (size_t i = 0; i < count; i++) {
+        if (bytes[i]) {
+            if (u->frame_used < sizeof(u->frame)) {
+                u->frame[u->frame_used++] = bytes[i];
+            } else {
+                u->overflow = true;
+            }
+            continue;
+        }
+        if (u->overflow) {
+            u->link.frame_errors++;
+        } else if (u->frame_used) {
+            handled += input_frame(u);
+        }
+        u->frame_used = 0;
+        u->overflow = false;
+    }
+    return handled;
+}
+
+#ifdef ESP_PLATFORM
+// Copies into the driver's TX ring, the UART drains it in the background
+static bool port_write(esp_dds_uart_t* u, const uint8_t* data, size_t size) {
+    int written = uart_write_bytes((uart_port_t)u->port, (const char*)data, size);
+    if (written > 0) u->bytes_sent += (uint32_t)written;
+    return written == (int)size;
+}
+
+// Waits for the first byte, then takes whatever else the driver holds
+static uint16_t uart_read(esp_dds_link_t* link, uint32_t timeout_ms) {
+    esp_dds_uart_t* u = (esp_dds_uart_t*)link;
+    uint16_t handled = 0;
+    TickType_t wait = pdMS_TO_TICKS(timeout_ms);
+    while (true) {
+        size_t available = 0;
+        uart_get_buffered_data_len((uart_port_t)u->port, &available);
+        size_t want = available ? DDS_MIN(available, sizeof(u->rx)) : 1;
+        int n = uart_read_bytes((uart_port_t)u->port, u->rx, want, wait);
+        if (n <= 0) break;
+        handled += input_bytes(u, u->rx, (size_t)n);
+        wait = 0;
+    }
+    return handled;
+}
+
+static const esp_dds_link_port_t uart_port = { uart_write, uart_read, NULL };
+
+bool esp_dds_domain_uart_open(esp_dds_domain_t* d, esp_dds_uart_t* uart, int port, uint32_t baud,
+                              int tx_pin, int rx_pin) {
+    if (!d || !uart || !baud) return false;
+    memset(uart, 0, offsetof(esp_dds_uart_t, tx));
+    esp_dds_link_init(&uart->link, &uart_port);
+    uart->port = port;
+    
+    uart_config_t config = {};
+    config.baud_rate = (int)baud;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    
+    // Rings hold a few encoded frames each way, the driver moves them by interrupt
+    uart_port_t p = (uart_port_t)port;
+    if (uart_driver_install(p, 4 * ESP_DDS_UART_ENCODED_MAX, 4 * ESP_DDS_UART_ENCODED_MAX, 0, NULL, 0) != ESP_OK) {
+        return false;
+    }
+    if (uart_param_config(p, &config) != ESP_OK ||
+        uart_set_pin(p, tx_pin < 0 ? UART_PIN_NO_CHANGE : tx_pin, rx_pin < 0 ? UART_PIN_NO_CHANGE : rx_pin,
+                     UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK ||
+        !esp_dds_domain_attach_transport(d, &uart->link.base)) {
+        uart_driver_delete(p);
+        return false;
+    }
+    return true;
+}
+
+bool esp_dds_uart_open(esp_dds_uart_t* uart, int port, uint32_t baud, int tx_pin, int rx_pin) {
+    return esp_dds_domain_uart_open(esp_dds_default_domain(), uart, port, baud, tx_pin, rx_pin);
+}
+
+void esp_dds_uart_close(esp_dds_uart_t* uart) {
+    if (!uart || !uart->link.base.domain) return;
+    esp_dds_detach_transport(&uart->link.base);
+    uart_driver_delete((uart_port_t)uart->port);
+}
+
+#else
+// An emulated line holds each frame back until the previous one would have left the
+// wire, at 10 bits per byte (8N1). A short wait for a full descriptor is allowed,
+// after that the frame is cut and the peer drops it at its CRC.
+static bool port_write(esp_dds_uart_t* u, const uint8_t* data, size_t size) {
+    if (u->line_baud) {
+        uint64_t now = dds_host_time_us();
+        while (now < u->line_free_us) now = dds_host_time_us();
+        u->line_free_us = now + (uint64_t)size * 10000000ULL / u->line_baud;
+    }
+    
+    size_t done = 0;
+    uint32_t start = DDS_MILLIS();
+    while (done < size) {
+        ssize_t n = write(u->fd, data + done, size - done);
+        if (n > 0) {
+            done += (size_t)n;
+            continue;
+        }
+        if ((n < 0 && errno != EAGAIN && errno != EINTR) || DDS_MILLIS() - start >= 10) break;
+        struct pollfd p = { u->fd, POLLOUT, 0 };
+        poll(&p, 1, 1);
+    }
+    u->bytes_sent += (uint32_t)done;
+    return done == size;
+}
+
+static uint16_t uart_read(esp_dds_link_t* link, uint32_t timeout_ms) {
+    esp_dds_uart_t* u = (esp_dds_uart_t*)link;
+    struct pollfd p = { u->fd, POLLIN, 0 };
+    if (poll(&p, 1, (int)timeout_ms) <= 0) return 0;
+    
+    uint16_t handled = 0;
+    ssize_t n;
+    while ((n = read(u->fd, u->rx, sizeof(u->rx))) > 0) {
+        handled += input_bytes(u, u->rx, (size_t)n);
+        if ((size_t)n < sizeof(u->rx)) break;
+    }
+    return handled;
+}
+
+static const esp_dds_link_port_t uart_port = { uart_write, uart_read, NULL };
+
+bool esp_dds_domain_uart_open_fd(esp_dds_domain_t* d, esp_dds_uart_t* uart, int fd, uint32_t line_baud) {
+    if (!d || !uart || fd < 0) return false;
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) return false;
+    
+    memset(uart, 0, offsetof(esp_dds_uart_t, tx));
+    esp_dds_link_init(&uart->link, &uart_port);
+    uart->fd = fd;
+    uart->line_baud = line_baud;
+    return esp_dds_domain_attach_transport(d, &uart->link.base);
+}
+
+bool esp_dds_uart_open_fd(esp_dds_uart_t* uart, int fd, uint32_t line_baud) {
+    return esp_dds_domain_uart_open_fd(esp_dds_default_domain(), uart, fd, line_baud);
+}
+
+static speed_t baud_constant(uint32_t baud) {
+    switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+#ifdef B460800
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 1500000: return B1500000;
+    case 2000000: return B2000000;
+    case 3000000: return B3000000;
+    case 4000000: return B4000000;
+#endif
+    default: return B0;
+    }
+}
+
+bool esp_dds_domain_uart_open_path(esp_dds_domain_t* d, esp_dds_uart_t* uart, const char* path, uint32_t baud) {
+    speed_t speed = baud_constant(baud);
+    if (!path || speed == B0) return false;
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) return false;
+    
+    struct termios tio;
+    bool ok = tcgetattr(fd, &tio) == 0;
+    if (ok) {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+        ok = cfsetispeed(&tio, speed) == 0 && cfsetospeed(&tio, speed) == 0 &&
+             tcsetattr(fd, TCSANOW, &tio) == 0;
+    }
+    if (!ok || !esp_dds_domain_uart_open_fd(d, uart, fd, 0)) {
+        close(fd);
+        return false;
+    }
+    tcflush(fd, TCIOFLUSH);
+    return true;
+}
+
+bool esp_dds_uart_open_path(esp_dds_uart_t* uart, const char* path, uint32_t baud) {
+    return esp_dds_domain_uart_open_path(esp_dds_default_domain(), uart, path, baud);
+}
+
+void esp_dds_uart_close(esp_dds_uart_t* uart) {
+    if (!uart || !uart->link.base.domain) return;
+    esp_dds_detach_transport(&uart->link.base);
+    close(uart->fd);
+    uart->fd = -1;
+}
+
+#endif
+
+#else
+void esp_dds_uart_close(esp_dds_uart_t* uart) {
+    if (uart) esp_dds_detach_transport(&uart->link.base);
+}
+#endif
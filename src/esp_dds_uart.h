@@ -0,0 +1,73 @@
+#ifndef ESP_DDS_UART_H
+#define ESP_DDS_UART_H
+
+#include "esp_dds_link.h"
+
+// Serial transport - link frames over a UART between an ESP32 and a host or between
+// two boards, or over any byte stream a host opens as a file descriptor (tty, pty).
+// Each frame carries a CRC-16/CCITT, is COBS encoded and ends in a zero byte, so a
+// receiver resynchronizes at the next delimiter after noise or a peer restart and
+// drops only the damaged frame. TX and RX buffers are static in the transport.
+//
+//   static esp_dds_uart_t uart;
+//   ESP_DDS_UART_OPEN(&uart, UART_NUM_1, 921600, 17, 16);   // ESP32: port, baud, TX and RX pin
+//   ESP_DDS_UART_OPEN_PATH(&uart, "/dev/ttyUSB0", 921600);  // Host end of the same link
+//   ESP_DDS_SET_TOPIC_VISIBILITY("/imu", ESP_DDS_NETWORK_VISIBLE);
+//   while (true) ESP_DDS_PROCESS_TRANSPORTS(10);
+#define ESP_DDS_UART_FRAME_MAX (ESP_DDS_LINK_MTU + 2)                         // Frame and CRC
+#define ESP_DDS_UART_ENCODED_MAX (ESP_DDS_UART_FRAME_MAX + ESP_DDS_UART_FRAME_MAX / 254 + 2)
+#ifndef ESP_DDS_UART_RX_CHUNK
+#define ESP_DDS_UART_RX_CHUNK 256         // Bytes taken from the driver per read
+#endif
+
+typedef struct {
+    esp_dds_link_t link;           // Attached to the domain
+#ifdef ESP_PLATFORM
+    int port;                      // uart_port_t
+#else
+    int fd;
+    uint32_t line_baud;            // Paces writes like a line of this rate, 0 = as fast as the fd takes them
+    uint64_t line_free_us;         // When the paced line has sent the last frame
+#endif
+    uint16_t frame_used;           // Encoded bytes of the frame being received
+    bool overflow;                 // Frame too long, dropped up to the next delimiter
+    uint32_t bytes_sent;
+    uint32_t bytes_received;
+    uint8_t tx[ESP_DDS_UART_ENCODED_MAX] __attribute__((aligned(4)));
+    uint8_t rx[ESP_DDS_UART_RX_CHUNK] __attribute__((aligned(4)));
+    uint8_t frame[ESP_DDS_UART_ENCODED_MAX] __attribute__((aligned(4)));  // Decoded in place
+} esp_dds_uart_t;
+
+#ifdef ESP_PLATFORM
+// Installs the UART driver (8N1, no flow control) and attaches the transport. Pins
+// below 0 keep the port's defaults.
+bool esp_dds_uart_open(esp_dds_uart_t* uart, int port, uint32_t baud, int tx_pin, int rx_pin);
+bool esp_dds_domain_uart_open(esp_dds_domain_t* domain, esp_dds_uart_t* uart, int port, uint32_t baud,
+                              int tx_pin, int rx_pin);
+
+#define ESP_DDS_UART_OPEN(uart, port, baud, tx_pin, rx_pin) esp_dds_uart_open(uart, port, baud, tx_pin, rx_pin)
+#define ESP_DDS_DOMAIN_UART_OPEN(domain, uart, port, baud, tx_pin, rx_pin) \
+    esp_dds_domain_uart_open(domain, uart, port, baud, tx_pin, rx_pin)
+#elif defined(DDS_HOST)
+// Takes over an open descriptor and makes it non-blocking. line_baud emulates a serial
+// line on descriptors without one, such as a pseudo-terminal.
+bool esp_dds_uart_open_fd(esp_dds_uart_t* uart, int fd, uint32_t line_baud);
+bool esp_dds_domain_uart_open_fd(esp_dds_domain_t* domain, esp_dds_uart_t* uart, int fd, uint32_t line_baud);
+
+// Opens a serial device in raw 8N1 mode at a standard rate up to 4000000 baud
+bool esp_dds_uart_open_path(esp_dds_uart_t* uart, const char* path, uint32_t baud);
+bool esp_dds_domain_uart_open_path(esp_dds_domain_t* domain, esp_dds_uart_t* uart, const char* path, uint32_t baud);
+
+#define ESP_DDS_UART_OPEN_FD(uart, fd, line_baud) esp_dds_uart_open_fd(uart, fd, line_baud)
+#define ESP_DDS_DOMAIN_UART_OPEN_FD(domain, uart, fd, line_baud) \
+    esp_dds_domain_uart_open_fd(domain, uart, fd, line_baud)
+#define ESP_DDS_UART_OPEN_PATH(uart, path, baud) esp_dds_uart_open_path(uart, path, baud)
+#define ESP_DDS_DOMAIN_UART_OPEN_PATH(domain, uart, path, baud) \
+    esp_dds_domain_uart_open_path(domain, uart, path, baud)
+#endif
+
+void esp_dds_uart_close(esp_dds_uart_t* uart);  // Detaches, then releases the driver or descriptor
+
+#define ESP_DDS_UART_CLOSE(uart) esp_dds_uart_close(uart)
+
+#endif // ESP_DDS_UART_H
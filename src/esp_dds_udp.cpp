@@ -0,0 +1,124 @@
+#include "esp_dds_udp.h"
+
+#if defined(ESP_PLATFORM) || defined(DDS_HOST)
+#ifdef ESP_PLATFORM
+#include "lwip/sockets.h"
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// xorshift32 for loss injection
+static bool drop_next(esp_dds_udp_t* u) {
+    uint32_t x = u->drop_random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    u->drop_random = x;
+    return x % 1000 < u->drop_permille;
+}
+
+static bool udp_write(esp_dds_link_t* link, const uint8_t* frame, size_t size) {
+    esp_dds_udp_t* u = (esp_dds_udp_t*)link;
+    if (!u->peer_port) return false;
+    if (u->drop_permille && drop_next(u)) {
+        u->datagrams_dropped++;
+        u->bytes_sent += (uint32_t)size;
+        return true;  // Lost on the way, as far as the sender can tell
+    }
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(u->peer_port);
+    to.sin_addr.s_addr = u->peer_ip;
+    ssize_t n = sendto(u->fd, frame, size, 0, (const struct sockaddr*)&to, sizeof(to));
+    if (n != (ssize_t)size) return false;
+    u->bytes_sent += (uint32_t)size;
+    return true;
+}
+
+// Waits for the first datagram, then takes whatever else is queued
+static uint16_t udp_read(esp_dds_link_t* link, uint32_t timeout_ms) {
+    esp_dds_udp_t* u = (esp_dds_udp_t*)link;
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(u->fd, &fds);
+    struct timeval tv = { (long)(timeout_ms / 1000), (long)(timeout_ms % 1000) * 1000 };
+    if (select(u->fd + 1, &fds, NULL, NULL, &tv) <= 0) return 0;
+    
+    uint16_t handled = 0;
+    while (true) {
+        struct sockaddr_in from;
+        socklen_t from_size = sizeof(from);
+        ssize_t n = recvfrom(u->fd, u->rx, sizeof(u->rx), 0, (struct sockaddr*)&from, &from_size);
+        if (n <= 0) break;
+        u->bytes_received += (uint32_t)n;
+        if (u->learn_peer) {
+            u->peer_ip = from.sin_addr.s_addr;
+            u->peer_port = ntohs(from.sin_port);
+        }
+        handled += esp_dds_link_input(&u->link, u->rx, (size_t)n);
+    }
+    return handled;
+}
+
+static const esp_dds_link_port_t udp_port = { udp_write, udp_read, NULL };
+
+bool esp_dds_domain_udp_open(esp_dds_domain_t* d, esp_dds_udp_t* udp, uint16_t local_port,
+                             const char* peer_ip, uint16_t peer_port) {
+    if (!d || !udp) return false;
+    memset(udp, 0, offsetof(esp_dds_udp_t, rx));
+    esp_dds_link_init(&udp->link, &udp_port);
+    udp->fd = -1;
+    udp->learn_peer = (peer_ip == NULL);
+    if (peer_ip && (!peer_port || inet_pton(AF_INET, peer_ip, &udp->peer_ip) != 1)) return false;
+    udp->peer_port = peer_ip ? peer_port : 0;
+    
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+    struct sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(local_port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    socklen_t local_size = sizeof(local);
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (bind(fd, (const struct sockaddr*)&local, sizeof(local)) != 0 ||
+        getsockname(fd, (struct sockaddr*)&local, &local_size) != 0 ||
+        flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        close(fd);
+        return false;
+    }
+    udp->fd = fd;
+    udp->local_port = ntohs(local.sin_port);
+    if (!esp_dds_domain_attach_transport(d, &udp->link.base)) {
+        close(fd);
+        udp->fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool esp_dds_udp_open(esp_dds_udp_t* udp, uint16_t local_port, const char* peer_ip, uint16_t peer_port) {
+    return esp_dds_domain_udp_open(esp_dds_default_domain(), udp, local_port, peer_ip, peer_port);
+}
+
+void esp_dds_udp_close(esp_dds_udp_t* udp) {
+    if (!udp || !udp->link.base.domain) return;
+    esp_dds_detach_transport(&udp->link.base);
+    close(udp->fd);
+    udp->fd = -1;
+}
+
+#else
+void esp_dds_udp_close(esp_dds_udp_t* udp) {
+    if (udp) esp_dds_detach_transport(&udp->link.base);
+}
+#endif
+
+void esp_dds_udp_set_loss(esp_dds_udp_t* udp, uint16_t drop_permille, uint32_t seed) {
+    udp->drop_permille = drop_permille;
+    udp->drop_random = seed ? seed : 1;
+}
@@ -0,0 +1,50 @@
+#ifndef ESP_DDS_UDP_H
+#define ESP_DDS_UDP_H
+
+#include "esp_dds_link.h"
+
+// Datagram transport - one link frame per UDP datagram between two nodes, over lwIP
+// sockets on the ESP32 and BSD sockets on hosts. Frames carry no checksum of their own,
+// UDP's covers them. A node opened without a peer answers whoever sent to it last, so a
+// host can serve a board that knows only the host's address.
+//
+//   static esp_dds_udp_t udp;
+//   ESP_DDS_UDP_OPEN(&udp, 7400, "192.168.1.20", 7400);
+//   ESP_DDS_SET_TOPIC_VISIBILITY("/motor/cmd", ESP_DDS_NETWORK_RELIABLE);
+//   while (true) ESP_DDS_PROCESS_TRANSPORTS(10);
+typedef struct {
+    esp_dds_link_t link;           // Attached to the domain
+    int fd;
+    uint16_t local_port;           // Bound port, filled in when 0 was asked for
+    uint16_t peer_port;            // 0 = not known yet
+    uint32_t peer_ip;              // IPv4, network byte order
+    bool learn_peer;               // Opened without a peer
+    uint16_t drop_permille;        // Test hook: datagrams dropped on purpose before sending
+    uint32_t drop_random;
+    uint32_t datagrams_dropped;
+    uint32_t bytes_sent;
+    uint32_t bytes_received;
+    uint8_t rx[ESP_DDS_LINK_MTU] __attribute__((aligned(4)));
+} esp_dds_udp_t;
+
+#if defined(ESP_PLATFORM) || defined(DDS_HOST)
+// Binds local_port on all interfaces (0 = any free port) and attaches the transport.
+// peer_ip NULL waits for the peer to send first.
+bool esp_dds_udp_open(esp_dds_udp_t* udp, uint16_t local_port, const char* peer_ip, uint16_t peer_port);
+bool esp_dds_domain_udp_open(esp_dds_domain_t* domain, esp_dds_udp_t* udp, uint16_t local_port,
+                             const char* peer_ip, uint16_t peer_port);
+
+#define ESP_DDS_UDP_OPEN(udp, local_port, peer_ip, peer_port) esp_dds_udp_open(udp, local_port, peer_ip, peer_port)
+#define ESP_DDS_DOMAIN_UDP_OPEN(domain, udp, local_port, peer_ip, peer_port) \
+    esp_dds_domain_udp_open(domain, udp, local_port, peer_ip, peer_port)
+#endif
+
+void esp_dds_udp_close(esp_dds_udp_t* udp);  // Detaches and closes the socket
+
+// Loss injection for tests, reproducible from the seed
+void esp_dds_udp_set_loss(esp_dds_udp_t* udp, uint16_t drop_permille, uint32_t seed);
+
+#define ESP_DDS_UDP_CLOSE(udp) esp_dds_udp_close(udp)
+#define ESP_DDS_UDP_SET_LOSS(udp, drop_permille, seed) esp_dds_udp_set_loss(udp, drop_permille, seed)
+
+#endif // ESP_DDS_UDP_H
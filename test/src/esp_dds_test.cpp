@@ -1,4 +1,5 @@
 #include "esp_dds_test.h"
+#include "status_msg.h"
 #include <string.h>
 
 // Test state
@@ -26,7 +27,32 @@ test_result_t test_results[] = {
     {"Concurrent Actions", false, UINT32_MAX, 0, 0, 0},
     {"Action Cancellation", false, UINT32_MAX, 0, 0, 0},
     {"Deadlock Scenarios", false, UINT32_MAX, 0, 0, 0},
-    {"Callback Context", false, UINT32_MAX, 0, 0, 0}
+    {"Callback Context", false, UINT32_MAX, 0, 0, 0},
+    {"QoS Monitoring", false, UINT32_MAX, 0, 0, 0},
+    {"Content Filters", false, UINT32_MAX, 0, 0, 0},
+    {"Rate Limits", false, UINT32_MAX, 0, 0, 0},
+    {"Wildcard Subscriptions", false, UINT32_MAX, 0, 0, 0},
+    {"Name Hashing", false, UINT32_MAX, 0, 0, 0},
+    {"Name Arena", false, UINT32_MAX, 0, 0, 0},
+    {"Publish Benchmark", false, UINT32_MAX, 0, 0, 0},
+    {"Entity Removal", false, UINT32_MAX, 0, 0, 0},
+    {"Multiple Domains", false, UINT32_MAX, 0, 0, 0},
+    {"Sized Context", false, UINT32_MAX, 0, 0, 0},
+    {"Executors", false, UINT32_MAX, 0, 0, 0},
+    {"Timers", false, UINT32_MAX, 0, 0, 0},
+    {"WaitSet", false, UINT32_MAX, 0, 0, 0},
+    {"Batch Publish", false, UINT32_MAX, 0, 0, 0},
+    {"Keyed Topics", false, UINT32_MAX, 0, 0, 0},
+    {"Shared Memory Transport", false, UINT32_MAX, 0, 0, 0},
+    {"Serial Transport", false, UINT32_MAX, 0, 0, 0},
+    {"Simulated Network", false, UINT32_MAX, 0, 0, 0},
+    {"Reliable Delivery", false, UINT32_MAX, 0, 0, 0},
+    {"Large Samples", false, UINT32_MAX, 0, 0, 0},
+    {"Remote Services", false, UINT32_MAX, 0, 0, 0},
+    {"Remote Actions", false, UINT32_MAX, 0, 0, 0},
+    {"Clock Sync", false, UINT32_MAX, 0, 0, 0},
+    {"Typed Messages", false, UINT32_MAX, 0, 0, 0},
+    {"Delta Compression", false, UINT32_MAX, 0, 0, 0}
 };
 
 const int NUM_TESTS = sizeof(test_results) / sizeof(test_results[0]);
@@ -817,6 +843,3394 @@ void test_callback_context(void) {
     test_results[11].passed = true;
 }
 
+// ===== TEST 13: QOS MONITORING =====
+
+typedef struct {
+    uint32_t deadline_missed;
+    uint32_t liveliness_lost;
+    uint32_t liveliness_restored;
+} qos_counters_t;
+
+static void test_qos_callback(const char* topic, esp_dds_qos_event_t event, uint32_t count, void* context) {
+    qos_counters_t* counters = (qos_counters_t*)context;
+    switch (event) {
+        case ESP_DDS_QOS_DEADLINE_MISSED: counters->deadline_missed += count; break;
+        case ESP_DDS_QOS_LIVELINESS_LOST: counters->liveliness_lost++; break;
+        case ESP_DDS_QOS_LIVELINESS_RESTORED: counters->liveliness_restored++; break;
+    }
+}
+
+void test_qos_monitoring(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 13: QoS Monitoring\n");
+    
+    qos_counters_t counters = {0, 0, 0};
+    bool test_passed = true;
+    
+    // 20 ms period with 50% tolerance, 100 ms lease
+    ESP_DDS_SET_DEADLINE("/test/imu", 20000, 50, test_qos_callback, &counters);
+    ESP_DDS_SET_LIVELINESS("/test/imu", 100000, test_qos_callback, &counters);
+    
+    // Publishing on time must not report anything
+    test_message_t msg = {0, 0};
+    for (int i = 0; i < 20; i++) {
+        ESP_DDS_PUBLISH("/test/imu", msg);
+        
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PROCESS_TIMERS();
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[12].min_time_us) test_results[12].min_time_us = duration;
+        if (duration > test_results[12].max_time_us) test_results[12].max_time_us = duration;
+        test_results[12].avg_time_us = (test_results[12].avg_time_us * i + duration) / (i + 1);
+        
+        DDS_DELAY(10);
+    }
+    
+    if (counters.deadline_missed != 0 || counters.liveliness_lost != 0) {
+        TEST_PRINT("  ❌ QOS FAIL: False reports (missed=%lu, lost=%lu)\n",
+                  counters.deadline_missed, counters.liveliness_lost);
+        test_passed = false;
+        test_results[12].failures++;
+    }
+    
+    // Go silent for 200 ms - deadline misses and liveliness loss expected
+    for (int i = 0; i < 20; i++) {
+        ESP_DDS_PROCESS_TIMERS();
+        DDS_DELAY(10);
+    }
+    ESP_DDS_PROCESS_TIMERS();
+    
+    esp_dds_topic_status_t status;
+    ESP_DDS_GET_TOPIC_STATUS("/test/imu", status);
+    
+    if (counters.deadline_missed < 5 || status.deadline_missed != counters.deadline_missed) {
+        TEST_PRINT("  ❌ QOS FAIL: Deadline misses=%lu (status=%lu)\n",
+                  counters.deadline_missed, status.deadline_missed);
+        test_passed = false;
+        test_results[12].failures++;
+    }
+    
+    if (counters.liveliness_lost != 1 || status.alive) {
+        TEST_PRINT("  ❌ QOS FAIL: Liveliness lost=%lu, alive=%s\n",
+                  counters.liveliness_lost, status.alive ? "true" : "false");
+        test_passed = false;
+        test_results[12].failures++;
+    }
+    
+    // Publisher comes back
+    for (int i = 0; i < 15 && counters.liveliness_restored == 0; i++) {
+        ESP_DDS_PUBLISH("/test/imu", msg);
+        ESP_DDS_PROCESS_TIMERS();
+        DDS_DELAY(10);
+    }
+    
+    if (counters.liveliness_restored != 1) {
+        TEST_PRINTLN("  ❌ QOS FAIL: Liveliness not restored");
+        test_passed = false;
+        test_results[12].failures++;
+    }
+    
+#ifdef DDS_HOST
+    // The 32-bit microsecond clock wraps 300 ms into a silent second: a 50 ms deadline
+    // keeps missing, a 100 ms lease is lost once and comes back only with a sample
+    qos_counters_t wrap = {0, 0, 0};
+    dds_host_micros_offset() = 0xFFFFFFFFUL - 300000 - (uint32_t)dds_host_time_us();
+    esp_dds_test_cleanup();
+    ESP_DDS_SET_DEADLINE("/test/wrap", 50000, 0, test_qos_callback, &wrap);
+    ESP_DDS_SET_LIVELINESS("/test/wrap", 100000, test_qos_callback, &wrap);
+    uint32_t wrap_start = DDS_MILLIS();
+    while (DDS_MILLIS() - wrap_start < 1000) {
+        ESP_DDS_PROCESS_TIMERS();
+        DDS_DELAY(1);
+    }
+    uint32_t wrap_missed = wrap.deadline_missed;
+    uint32_t wrap_restored = wrap.liveliness_restored;
+    for (int i = 0; i < 5; i++) {
+        ESP_DDS_PUBLISH("/test/wrap", msg);
+        ESP_DDS_PROCESS_TIMERS();
+        DDS_DELAY(10);
+    }
+    dds_host_micros_offset() = 0;
+    esp_dds_test_cleanup();
+    
+    if (wrap_missed < 17 || wrap_missed > 21 || wrap.liveliness_lost != 1 || wrap_restored != 0 ||
+        wrap.liveliness_restored != 1) {
+        TEST_PRINT("  ❌ QOS FAIL: Across the clock wrap %lu misses in 1 s (20), lost=%lu (1), "
+                  "restored=%lu while silent (0), %lu after publishing (1)\n", wrap_missed,
+                  wrap.liveliness_lost, wrap_restored, wrap.liveliness_restored);
+        test_passed = false;
+        test_results[12].failures++;
+    }
+#endif
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ QOS PASS: %lu deadline misses detected. Check timing: min=%lu, max=%lu, avg=%lu us\n",
+                  counters.deadline_missed, test_results[12].min_time_us,
+                  test_results[12].max_time_us, test_results[12].avg_time_us);
+        test_results[12].passed = true;
+    }
+}
+
+// ===== TEST 14: CONTENT FILTERS =====
+
+static bool test_counting_predicate(const void* data, size_t size, void* context) {
+    (*(uint32_t*)context)++;
+    return ((const status_message_t*)data)->value % 2 == 0;
+}
+
+void test_content_filters(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 14: Content Filters\n");
+    
+    uint32_t threshold_count1 = 0, threshold_count2 = 0, changed_count = 0;
+    uint32_t even_count = 0, predicate_calls = 0;
+    bool test_passed = true;
+    
+    esp_dds_filter_t threshold = {
+        { ESP_DDS_FILTER_FIELD(status_message_t, value, ESP_DDS_FILTER_GT | ESP_DDS_FILTER_SIGNED, 100) }, 1, NULL, NULL
+    };
+    esp_dds_filter_t state_changed = {
+        { ESP_DDS_FILTER_FIELD(status_message_t, state, ESP_DDS_FILTER_CHANGED, 0) }, 1, NULL, NULL
+    };
+    esp_dds_filter_t even = { {}, 0, test_counting_predicate, &predicate_calls };
+    
+    ESP_DDS_SUBSCRIBE_FILTERED("/test/status", threshold, test_topic_callback, &threshold_count1);
+    ESP_DDS_SUBSCRIBE_FILTERED("/test/status", threshold, test_topic_callback, &threshold_count2);
+    ESP_DDS_SUBSCRIBE_FILTERED("/test/status", state_changed, test_topic_callback, &changed_count);
+    ESP_DDS_SUBSCRIBE_FILTERED("/test/status", even, test_topic_callback, &even_count);
+    ESP_DDS_SUBSCRIBE_FILTERED("/test/status", even, test_topic_callback, &even_count);
+    
+    // value 0..199 -> 99 above threshold, 100 even; state changes every 50 samples
+    for (int i = 0; i < 200; i++) {
+        status_message_t msg = {(uint8_t)(i / 50), i};
+        
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PUBLISH("/test/status", msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[13].min_time_us) test_results[13].min_time_us = duration;
+        if (duration > test_results[13].max_time_us) test_results[13].max_time_us = duration;
+        test_results[13].avg_time_us = (test_results[13].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (threshold_count1 != 99 || threshold_count2 != 99) {
+        TEST_PRINT("  ❌ FILTER FAIL: Threshold deliveries %lu/%lu (expected 99)\n",
+                  threshold_count1, threshold_count2);
+        test_passed = false;
+        test_results[13].failures++;
+    }
+    
+    if (changed_count != 4) {
+        TEST_PRINT("  ❌ FILTER FAIL: State changes %lu (expected 4)\n", changed_count);
+        test_passed = false;
+        test_results[13].failures++;
+    }
+    
+    // Shared predicate runs once per sample, not once per subscriber
+    if (even_count != 200 || predicate_calls != 200) {
+        TEST_PRINT("  ❌ FILTER FAIL: Predicate deliveries %lu (expected 200), calls %lu (expected 200)\n",
+                  even_count, predicate_calls);
+        test_passed = false;
+        test_results[13].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ FILTER PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[13].min_time_us, test_results[13].max_time_us, test_results[13].avg_time_us);
+        test_results[13].passed = true;
+    }
+}
+
+// ===== TEST 15: RATE LIMITS =====
+
+static void test_latest_callback(const char* topic, const void* data, size_t size, void* context) {
+    *(int32_t*)context = ((const test_message_t*)data)->data;
+}
+
+void test_rate_limits(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 15: Rate Limits\n");
+    
+    uint32_t full_count = 0, limited_count = 0;
+    int32_t latest = -1;
+    bool test_passed = true;
+    
+    ESP_DDS_SUBSCRIBE("/test/telemetry", test_topic_callback, &full_count);
+    ESP_DDS_SUBSCRIBE_RATE_LIMITED("/test/telemetry", 50000, false, test_topic_callback, &limited_count);
+    ESP_DDS_SUBSCRIBE_RATE_LIMITED("/test/telemetry", 50000, true, test_latest_callback, &latest);
+    
+    // ~300 ms of samples every 2 ms
+    uint32_t start_ms = DDS_MILLIS();
+    int32_t last_sent = 0;
+    while (DDS_MILLIS() - start_ms < 300) {
+        test_message_t msg = {last_sent, TEST_GET_MICROS()};
+        ESP_DDS_PUBLISH("/test/telemetry", msg);
+        ESP_DDS_PROCESS_TIMERS();
+        last_sent++;
+        DDS_DELAY(2);
+    }
+    last_sent--;
+    
+    // Window opens with no new sample - keep-latest must deliver the held one
+    for (int i = 0; i < 10 && latest != last_sent; i++) {
+        DDS_DELAY(10);
+        ESP_DDS_PROCESS_TIMERS();
+    }
+    
+    uint32_t max_expected = 300 / 50 + 1;
+    if (limited_count < 2 || limited_count > max_expected) {
+        TEST_PRINT("  ❌ RATE FAIL: %lu deliveries of %lu samples (expected <= %lu)\n",
+                  limited_count, full_count, max_expected);
+        test_passed = false;
+        test_results[14].failures++;
+    }
+    
+    if (latest != last_sent) {
+        TEST_PRINT("  ❌ RATE FAIL: Keep-latest delivered %d, last published %d\n", latest, last_sent);
+        test_passed = false;
+        test_results[14].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ RATE PASS: %lu of %lu samples delivered, latest=%d\n",
+                  limited_count, full_count, latest);
+        test_results[14].passed = true;
+    }
+}
+
+// ===== TEST 16: WILDCARD SUBSCRIPTIONS =====
+
+void test_wildcard_subscriptions(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 16: Wildcard Subscriptions\n");
+    
+    uint32_t current_count = 0, sensor_count = 0;
+    bool test_passed = true;
+    test_message_t msg = {1, 0};
+    
+    // Topic created before the pattern is resolved immediately
+    ESP_DDS_PUBLISH("/motor/3/current", msg);
+    
+    bool ok = ESP_DDS_SUBSCRIBE_PATTERN("/motor/*/current", test_topic_callback, &current_count);
+    ok = ESP_DDS_SUBSCRIBE_PATTERN("/sensors/#", test_topic_callback, &sensor_count) && ok;
+    
+    // Invalid patterns are rejected
+    if (!ok || ESP_DDS_SUBSCRIBE_PATTERN("/a/#/b", test_topic_callback, NULL) ||
+        ESP_DDS_SUBSCRIBE_PATTERN("/a/x*", test_topic_callback, NULL)) {
+        TEST_PRINTLN("  ❌ WILDCARD FAIL: Pattern validation");
+        test_passed = false;
+        test_results[15].failures++;
+    }
+    
+    ESP_DDS_PUBLISH("/motor/3/current", msg);   // current
+    ESP_DDS_PUBLISH("/motor/1/current", msg);   // current
+    ESP_DDS_PUBLISH("/motor/1/voltage", msg);   // -
+    ESP_DDS_PUBLISH("/motor/current", msg);     // -
+    ESP_DDS_PUBLISH("/sensors", msg);           // sensors
+    ESP_DDS_PUBLISH("/sensors/imu/accel", msg); // sensors
+    ESP_DDS_PUBLISH("/sensorsx", msg);          // -
+    
+    if (current_count != 2 || sensor_count != 2) {
+        TEST_PRINT("  ❌ WILDCARD FAIL: current=%lu (expected 2), sensors=%lu (expected 2)\n",
+                  current_count, sensor_count);
+        test_passed = false;
+        test_results[15].failures++;
+    }
+    
+    // Resolved topics publish at the same cost as plain subscriptions
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PUBLISH("/motor/1/current", msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[15].min_time_us) test_results[15].min_time_us = duration;
+        if (duration > test_results[15].max_time_us) test_results[15].max_time_us = duration;
+        test_results[15].avg_time_us = (test_results[15].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    ESP_DDS_UNSUBSCRIBE_PATTERN("/motor/*/current", test_topic_callback);
+    current_count = 0;
+    ESP_DDS_PUBLISH("/motor/1/current", msg);
+    ESP_DDS_PUBLISH("/motor/7/current", msg);
+    
+    if (current_count != 0) {
+        TEST_PRINTLN("  ❌ WILDCARD FAIL: Pattern unsubscribe didn't work");
+        test_passed = false;
+        test_results[15].failures++;
+    }
+    
+    // An explicit subscription and two overlapping patterns share callback and context;
+    // the explicit one runs on an executor, so it is told apart from the pattern copies
+    uint32_t shared = 0;
+    uint8_t exec = ESP_DDS_CREATE_EXECUTOR(ESP_DDS_EXECUTOR_SINGLE_THREADED, 1);
+    uint8_t group = ESP_DDS_CREATE_CALLBACK_GROUP(exec, ESP_DDS_GROUP_MUTUALLY_EXCLUSIVE);
+    ok = ESP_DDS_SUBSCRIBE_GROUPED("/arm/joint", group, test_topic_callback, &shared);
+    ok = ESP_DDS_SUBSCRIBE_PATTERN("/arm/*", test_topic_callback, &shared) && ok;
+    ok = ESP_DDS_SUBSCRIBE_PATTERN("/arm/#", test_topic_callback, &shared) && ok;
+    uint32_t inline_counts[3], spun_counts[3];
+    for (int step = 0; step < 3; step++) {
+        if (step == 1) ESP_DDS_UNSUBSCRIBE_PATTERN("/arm/*", test_topic_callback);
+        if (step == 2) ESP_DDS_UNSUBSCRIBE_PATTERN("/arm/#", test_topic_callback);
+        shared = 0;
+        ESP_DDS_PUBLISH("/arm/joint", msg);
+        inline_counts[step] = shared;
+        ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+        spun_counts[step] = shared - inline_counts[step];
+    }
+    if (!ok || inline_counts[0] != 2 || inline_counts[1] != 1 || inline_counts[2] != 0 ||
+        spun_counts[0] != 1 || spun_counts[1] != 1 || spun_counts[2] != 1) {
+        TEST_PRINT("  ❌ WILDCARD FAIL: Overlapping unsubscribe, inline %lu/%lu/%lu (2/1/0), "
+                  "executor %lu/%lu/%lu (1/1/1)\n", inline_counts[0], inline_counts[1], inline_counts[2],
+                  spun_counts[0], spun_counts[1], spun_counts[2]);
+        test_passed = false;
+        test_results[15].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ WILDCARD PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[15].min_time_us, test_results[15].max_time_us, test_results[15].avg_time_us);
+        test_results[15].passed = true;
+    }
+}
+
+// ===== TEST 17: NAME HASHING =====
+
+void test_name_hashing(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 17: Name Hashing\n");
+    
+    uint32_t count = 0;
+    bool test_passed = true;
+    test_message_t msg = {1, 0};
+    
+    // Literal names are hashed at build time, runtime names must agree
+    char buffer[ESP_DDS_MAX_NAME_LENGTH];
+    snprintf(buffer, sizeof(buffer), "/hash_%d", 7);
+    esp_dds_name_t literal = ESP_DDS_NAME("/hash_7");
+    esp_dds_name_t runtime = ESP_DDS_NAME(buffer);
+    
+    if (literal.hash != runtime.hash || literal.length != runtime.length || literal.length != 7) {
+        TEST_PRINT("  ❌ NAME FAIL: Literal hash 0x%08lx != runtime hash 0x%08lx\n",
+                  (unsigned long)literal.hash, (unsigned long)runtime.hash);
+        test_passed = false;
+        test_results[16].failures++;
+    }
+    
+    // Invalid runtime names carry a zero length and are rejected by the API
+    snprintf(buffer, sizeof(buffer), "hash_%d", 7);
+    if (ESP_DDS_NAME(buffer).length != 0 || ESP_DDS_PUBLISH(buffer, msg)) {
+        TEST_PRINTLN("  ❌ NAME FAIL: Invalid runtime name accepted");
+        test_passed = false;
+        test_results[16].failures++;
+    }
+    
+    // Literal, runtime and plain string APIs all resolve to the same topic
+    ESP_DDS_SUBSCRIBE("/hash_7", test_topic_callback, &count);
+    snprintf(buffer, sizeof(buffer), "/hash_%d", 7);
+    ESP_DDS_PUBLISH("/hash_7", msg);
+    ESP_DDS_PUBLISH(buffer, msg);
+    esp_dds_publish("/hash_7", &msg, sizeof(msg));
+    ESP_DDS_PUBLISH("/hash_8", msg);
+    
+    if (count != 3) {
+        TEST_PRINT("  ❌ NAME FAIL: Received %lu (expected 3)\n", count);
+        test_passed = false;
+        test_results[16].failures++;
+    }
+    
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PUBLISH("/hash_7", msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[16].min_time_us) test_results[16].min_time_us = duration;
+        if (duration > test_results[16].max_time_us) test_results[16].max_time_us = duration;
+        test_results[16].avg_time_us = (test_results[16].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ NAME PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[16].min_time_us, test_results[16].max_time_us, test_results[16].avg_time_us);
+        test_results[16].passed = true;
+    }
+}
+
+// ===== TEST 18: NAME ARENA =====
+
+static void test_name_topic_callback(const char* topic, const void* data, size_t size, void* context) {
+    *(const char**)context = topic;
+}
+
+static void test_name_async_callback(const char* service, const void* response, size_t size, void* context) {
+    *(const char**)context = service;
+}
+
+void test_name_arena(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 18: Name Arena\n");
+    
+    const char* first = NULL;
+    const char* second = NULL;
+    const char* service_name = NULL;
+    bool test_passed = true;
+    test_message_t msg = {1, 0};
+    
+    // Callbacks get the interned copy, stable across publishes
+    ESP_DDS_SUBSCRIBE("/arena/topic", test_name_topic_callback, &first);
+    ESP_DDS_PUBLISH("/arena/topic", msg);
+    ESP_DDS_UNSUBSCRIBE("/arena/topic", test_name_topic_callback);
+    ESP_DDS_SUBSCRIBE("/arena/topic", test_name_topic_callback, &second);
+    ESP_DDS_PUBLISH("/arena/topic", msg);
+    
+    if (!first || first != second || strcmp(first, "/arena/topic") != 0) {
+        TEST_PRINTLN("  ❌ ARENA FAIL: Topic name not interned");
+        test_passed = false;
+        test_results[17].failures++;
+    }
+    
+    // Pending calls reference the service slot and report its interned name
+    ESP_DDS_CREATE_SERVICE("/arena/service", test_service_callback, ESP_DDS_ASYNC, NULL);
+    int32_t request = 21;
+    ESP_DDS_CALL_SERVICE_ASYNC("/arena/service", request, test_name_async_callback, &service_name, 100);
+    ESP_DDS_PROCESS_PENDING(10);
+    
+    if (!service_name || strcmp(service_name, "/arena/service") != 0) {
+        TEST_PRINTLN("  ❌ ARENA FAIL: Async callback got wrong service name");
+        test_passed = false;
+        test_results[17].failures++;
+    }
+    
+    // Topic creation interns the name, publish afterwards only compares hashes
+    char name[ESP_DDS_MAX_NAME_LENGTH];
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        snprintf(name, sizeof(name), "/arena/created_%d", i);
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PUBLISH(name, msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[17].min_time_us) test_results[17].min_time_us = duration;
+        if (duration > test_results[17].max_time_us) test_results[17].max_time_us = duration;
+        test_results[17].avg_time_us = (test_results[17].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ ARENA PASS: Context %u bytes, creation timing: min=%lu, max=%lu, avg=%lu us\n",
+                  (unsigned)sizeof(esp_dds_context_t), test_results[17].min_time_us,
+                  test_results[17].max_time_us, test_results[17].avg_time_us);
+        test_results[17].passed = true;
+    }
+}
+
+// ===== TEST 19: PUBLISH BENCHMARK =====
+
+// Nanoseconds per publish over TEST_BENCH_PUBLISHES, timing in test_results[18]
+static uint32_t bench_publish(const char* topic, uint32_t* count, uint32_t subscribers) {
+    test_message_t msg = {1, 0};
+    uint32_t best = UINT32_MAX;
+    
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        *count = 0;
+        uint32_t start_time = TEST_GET_MICROS();
+        for (int n = 0; n < TEST_BENCH_PUBLISHES; n++) {
+            esp_dds_publish(topic, &msg, sizeof(msg));
+        }
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        
+        if (*count != TEST_BENCH_PUBLISHES * subscribers) {
+            test_results[18].failures++;
+        }
+        if (duration < best) best = duration;
+        if (duration < test_results[18].min_time_us) test_results[18].min_time_us = duration;
+        if (duration > test_results[18].max_time_us) test_results[18].max_time_us = duration;
+    }
+    return (uint32_t)((uint64_t)best * 1000 / TEST_BENCH_PUBLISHES);
+}
+
+void test_publish_benchmark(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 19: Publish Benchmark\n");
+    
+    uint32_t count = 0;
+    test_message_t msg = {1, 0};
+    char name[ESP_DDS_MAX_NAME_LENGTH];
+    
+    // Full topic table, measured topics created last so lookups scan every hash
+    for (int i = 0; i < ESP_DDS_MAX_TOPICS - 2; i++) {
+        snprintf(name, sizeof(name), "/bench/filler_%d", i);
+        ESP_DDS_PUBLISH(name, msg);
+    }
+    ESP_DDS_SUBSCRIBE("/bench/single", test_topic_callback, &count);
+    for (int i = 0; i < ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC; i++) {
+        ESP_DDS_SUBSCRIBE("/bench/fanout", test_topic_callback, &count);
+    }
+    
+    uint32_t single_ns = bench_publish("/bench/single", &count, 1);
+    uint32_t fanout_ns = bench_publish("/bench/fanout", &count, ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC);
+    
+    if (test_results[18].failures == 0) {
+        test_results[18].avg_time_us = single_ns / 1000;
+        TEST_PRINT("  ✅ BENCH PASS: %d topics, 1 subscriber %lu ns, %d subscribers %lu ns per publish\n",
+                  ESP_DDS_MAX_TOPICS, (unsigned long)single_ns,
+                  ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC, (unsigned long)fanout_ns);
+        test_results[18].passed = true;
+    } else {
+        TEST_PRINTLN("  ❌ BENCH FAIL: Lost deliveries");
+    }
+}
+
+// ===== TEST 20: ENTITY REMOVAL =====
+
+static void test_aborted_result_callback(const char* action, const void* result, size_t size,
+                                         esp_dds_action_state_t state, void* context) {
+    if (state == ESP_DDS_ACTION_ABORTED) {
+        (*(uint32_t*)context)++;
+    }
+}
+
+void test_entity_removal(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 20: Entity Removal\n");
+    
+    bool test_passed = true;
+    int32_t request = 21, response = 0;
+    test_message_t msg = {1, 0};
+    char name[ESP_DDS_MAX_NAME_LENGTH];
+    
+    // Destroyed services fail fast and their slot is reused
+    ESP_DDS_CREATE_SERVICE("/remove/service", test_service_callback, ESP_DDS_SYNC, NULL);
+    bool destroyed = ESP_DDS_DESTROY_SERVICE("/remove/service");
+    bool dead_call = ESP_DDS_CALL_SERVICE_SYNC("/remove/service", request, response, 100);
+    bool double_destroy = ESP_DDS_DESTROY_SERVICE("/remove/service");
+    
+    if (!destroyed || dead_call || double_destroy) {
+        TEST_PRINTLN("  ❌ REMOVAL FAIL: Destroyed service still reachable");
+        test_passed = false;
+        test_results[19].failures++;
+    }
+    
+    for (int i = 0; i < ESP_DDS_MAX_SERVICES; i++) {
+        snprintf(name, sizeof(name), "/remove/service_%d", i);
+        esp_dds_create_service(name, test_service_callback, ESP_DDS_SYNC, NULL);
+    }
+    
+    // Hot-swap cycles on a full table, timed per destroy/create pair
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        bool ok = esp_dds_destroy_service("/remove/service_3");
+        ok = esp_dds_create_service("/remove/service_3", test_service_callback, ESP_DDS_SYNC, NULL) && ok;
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        
+        if (!ok || !ESP_DDS_CALL_SERVICE_SYNC("/remove/service_3", request, response, 100) || response != 42) {
+            TEST_PRINT("  ❌ REMOVAL FAIL: Swap cycle %d failed\n", i);
+            test_passed = false;
+            test_results[19].failures++;
+        }
+        if (duration < test_results[19].min_time_us) test_results[19].min_time_us = duration;
+        if (duration > test_results[19].max_time_us) test_results[19].max_time_us = duration;
+        test_results[19].avg_time_us = (test_results[19].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    // A goal in flight on a destroyed action is reported as aborted
+    uint32_t aborted = 0;
+    navigation_context_t nav_ctx = {0, {0, 0}};
+    navigation_goal_t goal = {100, 10};
+    ESP_DDS_CREATE_ACTION("/remove/action", navigation_goal_callback, navigation_execute_callback,
+                          navigation_cancel_callback, &nav_ctx);
+    ESP_DDS_SEND_GOAL("/remove/action", goal, NULL, test_aborted_result_callback, &aborted, 100);
+    ESP_DDS_DESTROY_ACTION("/remove/action");
+    ESP_DDS_PROCESS_PENDING(10);
+    
+    if (aborted != 1 || ESP_DDS_SEND_GOAL("/remove/action", goal, NULL, NULL, NULL, 100)) {
+        TEST_PRINT("  ❌ REMOVAL FAIL: Aborted results %lu (expected 1)\n", aborted);
+        test_passed = false;
+        test_results[19].failures++;
+    }
+    
+    // Idle topics are collected, subscribed ones survive
+    uint32_t count = 0;
+    ESP_DDS_SUBSCRIBE("/remove/kept", test_topic_callback, &count);
+    for (int i = 0; i < 5; i++) {
+        snprintf(name, sizeof(name), "/remove/idle_%d", i);
+        ESP_DDS_PUBLISH(name, msg);
+    }
+    uint8_t collected = ESP_DDS_COLLECT_TOPICS();
+    ESP_DDS_PUBLISH("/remove/kept", msg);
+    
+    if (collected != 5 || count != 1) {
+        TEST_PRINT("  ❌ REMOVAL FAIL: Collected %u topics (expected 5), received %lu\n", collected, count);
+        test_passed = false;
+        test_results[19].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ REMOVAL PASS: Swap timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[19].min_time_us, test_results[19].max_time_us, test_results[19].avg_time_us);
+        test_results[19].passed = true;
+    }
+}
+
+// ===== TEST 21: MULTIPLE DOMAINS =====
+
+ESP_DDS_DOMAIN_DEFINE(test_motor_domain, 4, 2, 2, 128);
+ESP_DDS_DOMAIN_DEFINE(test_ui_domain, 8, 1, 1, 256);
+
+void test_multiple_domains(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 21: Multiple Domains\n");
+    
+    esp_dds_domain_t* motor = &test_motor_domain;
+    esp_dds_domain_t* ui = &test_ui_domain;
+    ESP_DDS_DOMAIN_INIT(motor);
+    ESP_DDS_DOMAIN_INIT(ui);
+    
+    uint32_t motor_count = 0, ui_count = 0, default_count = 0;
+    bool test_passed = true;
+    test_message_t msg = {1, 0};
+    
+    // Same topic name in three domains, each delivery stays in its domain
+    ESP_DDS_DOMAIN_SUBSCRIBE(motor, "/status", test_topic_callback, &motor_count);
+    ESP_DDS_DOMAIN_SUBSCRIBE(ui, "/status", test_topic_callback, &ui_count);
+    ESP_DDS_SUBSCRIBE("/status", test_topic_callback, &default_count);
+    
+    ESP_DDS_DOMAIN_PUBLISH(motor, "/status", msg);
+    ESP_DDS_DOMAIN_PUBLISH(motor, "/status", msg);
+    ESP_DDS_DOMAIN_PUBLISH(ui, "/status", msg);
+    
+    if (motor_count != 2 || ui_count != 1 || default_count != 0) {
+        TEST_PRINT("  ❌ DOMAIN FAIL: motor=%lu (2), ui=%lu (1), default=%lu (0)\n",
+                  motor_count, ui_count, default_count);
+        test_passed = false;
+        test_results[20].failures++;
+    }
+    
+    // Limits are per domain: the motor domain holds 4 topics, the ui domain 8
+    char name[ESP_DDS_MAX_NAME_LENGTH];
+    int motor_created = 0, ui_created = 0;
+    for (int i = 0; i < 8; i++) {
+        snprintf(name, sizeof(name), "/limit_%d", i);
+        if (esp_dds_domain_publish(motor, name, &msg, sizeof(msg))) motor_created++;
+        if (esp_dds_domain_publish(ui, name, &msg, sizeof(msg))) ui_created++;
+    }
+    
+    if (motor_created != 3 || ui_created != 7) {
+        TEST_PRINT("  ❌ DOMAIN FAIL: Created motor=%d (3), ui=%d (7)\n", motor_created, ui_created);
+        test_passed = false;
+        test_results[20].failures++;
+    }
+    
+    // Services and reset are per domain as well
+    int32_t request = 5, response = 0;
+    ESP_DDS_DOMAIN_CREATE_SERVICE(motor, "/calibrate", test_service_callback, ESP_DDS_SYNC, NULL);
+    bool motor_call = ESP_DDS_DOMAIN_CALL_SERVICE_SYNC(motor, "/calibrate", request, response, 100);
+    bool default_call = ESP_DDS_CALL_SERVICE_SYNC("/calibrate", request, response, 100);
+    ESP_DDS_DOMAIN_RESET(ui);
+    ui_count = 0;
+    ESP_DDS_DOMAIN_PUBLISH(ui, "/status", msg);
+    ESP_DDS_DOMAIN_PUBLISH(motor, "/status", msg);
+    
+    if (!motor_call || default_call || ui_count != 0 || motor_count != 3) {
+        TEST_PRINTLN("  ❌ DOMAIN FAIL: Services or reset leaked across domains");
+        test_passed = false;
+        test_results[20].failures++;
+    }
+    
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_DOMAIN_PUBLISH(motor, "/status", msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[20].min_time_us) test_results[20].min_time_us = duration;
+        if (duration > test_results[20].max_time_us) test_results[20].max_time_us = duration;
+        test_results[20].avg_time_us = (test_results[20].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ DOMAIN PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[20].min_time_us, test_results[20].max_time_us, test_results[20].avg_time_us);
+        test_results[20].passed = true;
+    }
+}
+
+// ===== TEST 22: SIZED CONTEXT =====
+
+struct TestNodeConfig : esp_dds::DefaultConfig {
+    static constexpr size_t topics = 3;
+    static constexpr size_t services = 1;
+    static constexpr size_t actions = 1;
+    static constexpr size_t pending = 2;
+    static constexpr size_t subscribers_per_topic = 2;
+    static constexpr size_t name_bytes = 64;
+};
+
+typedef esp_dds::Context<TestNodeConfig> test_node_context_t;
+static_assert(sizeof(test_node_context_t::index_type) == 1, "Small limits must use 8-bit indices");
+static_assert(sizeof(test_node_context_t) == test_node_context_t::footprint, "Footprint must be exact");
+static_assert(test_node_context_t::footprint < esp_dds::Context<>::footprint, "Node must be smaller than default");
+
+static test_node_context_t test_node_context;
+
+void test_sized_context(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 22: Sized Context\n");
+    TEST_PRINT("  Footprint: node=%u, default=%u bytes\n",
+              (unsigned)test_node_context_t::footprint, (unsigned)esp_dds::Context<>::footprint);
+    
+    test_node_context.init();
+    esp_dds_domain_t* node = test_node_context.domain();
+    uint32_t count = 0;
+    bool test_passed = true;
+    test_message_t msg = {1, 0};
+    
+    // Subscribers per topic come from the config, not ESP_DDS_MAX_SUBSCRIBERS_PER_TOPIC
+    bool first = ESP_DDS_DOMAIN_SUBSCRIBE(node, "/node/a", test_topic_callback, &count);
+    bool second = ESP_DDS_DOMAIN_SUBSCRIBE(node, "/node/a", test_topic_callback, &count);
+    bool third = ESP_DDS_DOMAIN_SUBSCRIBE(node, "/node/a", test_topic_callback, &count);
+    ESP_DDS_DOMAIN_PUBLISH(node, "/node/a", msg);
+    
+    if (!first || !second || third || count != 2) {
+        TEST_PRINT("  ❌ CONTEXT FAIL: Subscribers %d/%d/%d (1/1/0), count=%lu (2)\n",
+                  first, second, third, count);
+        test_passed = false;
+        test_results[21].failures++;
+    }
+    
+    // Topic table holds exactly three entries
+    bool b = ESP_DDS_DOMAIN_PUBLISH(node, "/node/b", msg);
+    bool c = ESP_DDS_DOMAIN_PUBLISH(node, "/node/c", msg);
+    bool d = ESP_DDS_DOMAIN_PUBLISH(node, "/node/d", msg);
+    
+    if (!b || !c || d) {
+        TEST_PRINT("  ❌ CONTEXT FAIL: Topics b/c/d %d/%d/%d (1/1/0)\n", b, c, d);
+        test_passed = false;
+        test_results[21].failures++;
+    }
+    
+    // Reset keeps the wiring, init again is harmless
+    test_node_context.reset();
+    test_node_context.init();
+    count = 0;
+    ESP_DDS_DOMAIN_SUBSCRIBE(node, "/node/d", test_topic_callback, &count);
+    ESP_DDS_DOMAIN_PUBLISH(node, "/node/d", msg);
+    
+    if (count != 1) {
+        TEST_PRINT("  ❌ CONTEXT FAIL: After reset count=%lu (1)\n", count);
+        test_passed = false;
+        test_results[21].failures++;
+    }
+    
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_DOMAIN_PUBLISH(node, "/node/d", msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[21].min_time_us) test_results[21].min_time_us = duration;
+        if (duration > test_results[21].max_time_us) test_results[21].max_time_us = duration;
+        test_results[21].avg_time_us = (test_results[21].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ CONTEXT PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[21].min_time_us, test_results[21].max_time_us, test_results[21].avg_time_us);
+        test_results[21].passed = true;
+    }
+}
+
+// ===== TEST 23: EXECUTORS =====
+
+static bool exec_nested_call_ok = false;
+
+static bool test_exec_goal_callback(const void* goal, size_t size, void* context) {
+    return true;
+}
+
+static esp_dds_action_state_t test_exec_execute_callback(const void* goal, size_t goal_size,
+                                                         void* result, size_t* result_size, void* context) {
+    *result_size = 0;
+    return ++(*(uint32_t*)context) < 3 ? ESP_DDS_ACTION_EXECUTING : ESP_DDS_ACTION_SUCCEEDED;
+}
+
+// Calls a service of the same group from inside a group callback
+static void test_exec_nested_callback(const char* topic, const void* data, size_t size, void* context) {
+    int32_t request = 2, response = 0;
+    exec_nested_call_ok = ESP_DDS_CALL_SERVICE_SYNC((const char*)context, request, response, 5);
+}
+
+#ifdef ESP_PLATFORM
+static volatile int32_t exec_running = 0;
+static volatile int32_t exec_max_running = 0;
+
+static void test_exec_overlap_callback(const char* topic, const void* data, size_t size, void* context) {
+    int32_t running = __atomic_add_fetch(&exec_running, 1, __ATOMIC_SEQ_CST);
+    if (running > exec_max_running) exec_max_running = running;
+    DDS_DELAY(5);
+    __atomic_sub_fetch(&exec_running, 1, __ATOMIC_SEQ_CST);
+}
+#endif
+
+void test_executors(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 23: Executors\n");
+    
+    bool test_passed = true;
+    uint32_t count = 0, async_count = 0, steps = 0;
+    test_message_t msg = {1, 0};
+    
+    uint8_t exec = ESP_DDS_CREATE_EXECUTOR(ESP_DDS_EXECUTOR_SINGLE_THREADED, 1);
+    uint8_t exclusive = ESP_DDS_CREATE_CALLBACK_GROUP(exec, ESP_DDS_GROUP_MUTUALLY_EXCLUSIVE);
+    uint8_t reentrant = ESP_DDS_CREATE_CALLBACK_GROUP(exec, ESP_DDS_GROUP_REENTRANT);
+    
+    // Grouped subscriptions, services and actions run only when the executor spins
+    ESP_DDS_SUBSCRIBE_GROUPED("/exec/topic", exclusive, test_topic_callback, &count);
+    ESP_DDS_CREATE_SERVICE("/exec/service", test_service_callback, ESP_DDS_ASYNC, NULL);
+    ESP_DDS_SET_SERVICE_GROUP("/exec/service", exclusive);
+    ESP_DDS_CREATE_ACTION("/exec/action", test_exec_goal_callback, test_exec_execute_callback, NULL, &steps);
+    ESP_DDS_SET_ACTION_GROUP("/exec/action", exclusive);
+    
+    int32_t request = 4;
+    ESP_DDS_PUBLISH("/exec/topic", msg);
+    ESP_DDS_PUBLISH("/exec/topic", msg);
+    ESP_DDS_CALL_SERVICE_ASYNC("/exec/service", request, test_async_callback, &async_count, 100);
+    ESP_DDS_SEND_GOAL("/exec/action", request, NULL, NULL, NULL, 100);
+    ESP_DDS_PROCESS_ACTIONS();
+    ESP_DDS_PROCESS_PENDING(10);
+    
+    if (count != 0 || service_call_count != 0 || steps != 0 || async_count != 0) {
+        TEST_PRINT("  ❌ EXECUTOR FAIL: Ran outside the executor (topic=%lu, service=%lu, steps=%lu)\n",
+                  count, service_call_count, steps);
+        test_passed = false;
+        test_results[22].failures++;
+    }
+    
+    uint16_t executed = 0;
+    for (int i = 0; i < 5; i++) {
+        executed += ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+    }
+    ESP_DDS_PROCESS_PENDING(10);
+    
+    if (count != 2 || service_call_count != 1 || async_count != 1 || steps != 3 || executed != 6) {
+        TEST_PRINT("  ❌ EXECUTOR FAIL: topic=%lu (2), service=%lu (1), async=%lu (1), steps=%lu (3), run=%u (6)\n",
+                  count, service_call_count, async_count, steps, executed);
+        test_passed = false;
+        test_results[22].failures++;
+    }
+    
+    // A mutually exclusive group blocks sync calls from its own callbacks, reentrant does not
+    ESP_DDS_CREATE_SERVICE("/exec/sync", test_service_callback, ESP_DDS_SYNC, NULL);
+    ESP_DDS_SET_SERVICE_GROUP("/exec/sync", exclusive);
+    ESP_DDS_SUBSCRIBE_GROUPED("/exec/nested", exclusive, test_exec_nested_callback, (void*)"/exec/sync");
+    ESP_DDS_PUBLISH("/exec/nested", msg);
+    ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+    bool exclusive_call = exec_nested_call_ok;
+    
+    ESP_DDS_SET_SERVICE_GROUP("/exec/sync", reentrant);
+    ESP_DDS_PUBLISH("/exec/nested", msg);
+    ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+    bool reentrant_call = exec_nested_call_ok;
+    
+    if (exclusive_call || !reentrant_call) {
+        TEST_PRINT("  ❌ EXECUTOR FAIL: Nested sync call exclusive=%d (0), reentrant=%d (1)\n",
+                  exclusive_call, reentrant_call);
+        test_passed = false;
+        test_results[22].failures++;
+    }
+    
+    // A full queue is reported to the publisher
+    bool accepted = true;
+    for (int i = 0; i <= ESP_DDS_MAX_QUEUED_WORK; i++) {
+        accepted = ESP_DDS_PUBLISH("/exec/topic", msg);
+    }
+    ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+    
+    if (accepted) {
+        TEST_PRINTLN("  ❌ EXECUTOR FAIL: Publish accepted more samples than the queue holds");
+        test_passed = false;
+        test_results[22].failures++;
+    }
+    
+#ifdef ESP_PLATFORM
+    // Worker pool - reentrant callbacks overlap, mutually exclusive ones never do
+    uint8_t pool = ESP_DDS_CREATE_EXECUTOR(ESP_DDS_EXECUTOR_MULTI_THREADED, 2);
+    uint8_t pool_reentrant = ESP_DDS_CREATE_CALLBACK_GROUP(pool, ESP_DDS_GROUP_REENTRANT);
+    uint8_t pool_exclusive = ESP_DDS_CREATE_CALLBACK_GROUP(pool, ESP_DDS_GROUP_MUTUALLY_EXCLUSIVE);
+    ESP_DDS_SUBSCRIBE_GROUPED("/exec/overlap", pool_reentrant, test_exec_overlap_callback, NULL);
+    ESP_DDS_SUBSCRIBE_GROUPED("/exec/serial", pool_exclusive, test_exec_overlap_callback, NULL);
+    ESP_DDS_EXECUTOR_START(pool);
+    
+    exec_max_running = 0;
+    for (int i = 0; i < 4; i++) ESP_DDS_PUBLISH("/exec/overlap", msg);
+    DDS_DELAY(50);
+    int32_t overlap = exec_max_running;
+    
+    exec_max_running = 0;
+    for (int i = 0; i < 4; i++) ESP_DDS_PUBLISH("/exec/serial", msg);
+    DDS_DELAY(50);
+    int32_t serial = exec_max_running;
+    ESP_DDS_EXECUTOR_STOP(pool);
+    DDS_DELAY(10);
+    
+    if (overlap < 2 || serial != 1) {
+        TEST_PRINT("  ❌ EXECUTOR FAIL: Concurrency reentrant=%ld (2), exclusive=%ld (1)\n", overlap, serial);
+        test_passed = false;
+        test_results[22].failures++;
+    }
+#endif
+    
+    // Cost of handing a sample to an executor
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PUBLISH("/exec/topic", msg);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+        if (duration < test_results[22].min_time_us) test_results[22].min_time_us = duration;
+        if (duration > test_results[22].max_time_us) test_results[22].max_time_us = duration;
+        test_results[22].avg_time_us = (test_results[22].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ EXECUTOR PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[22].min_time_us, test_results[22].max_time_us, test_results[22].avg_time_us);
+        test_results[22].passed = true;
+    }
+}
+
+// ===== TEST 24: TIMERS =====
+
+typedef struct {
+    uint32_t fires;
+    uint32_t max_late_us;
+    uint32_t total_late_us;
+    uint32_t period_us;            // Non-zero: count periods skipped by a preempted loop
+    uint32_t skipped;
+} test_timer_stats_t;
+
+static void test_timer_callback(uint32_t late_us, void* context) {
+    test_timer_stats_t* stats = (test_timer_stats_t*)context;
+    stats->fires++;
+    if (stats->period_us) stats->skipped += late_us / stats->period_us;
+    stats->total_late_us += late_us;
+    if (late_us > stats->max_late_us) stats->max_late_us = late_us;
+}
+
+// A gateway sized for many timers - per-tick cost must not grow with the count
+struct TestTimerConfig : esp_dds::DefaultConfig {
+    static constexpr size_t topics = 4;
+    static constexpr size_t timers = 1024;
+};
+
+static esp_dds::Context<TestTimerConfig> test_timer_context;
+
+void test_timers(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 24: Timers\n");
+    
+    bool test_passed = true;
+    test_timer_stats_t stats = {0, 0, 0, 2000, 0};
+    
+    // Jitter of a 2 ms timer polled from a busy loop, host schedulers may preempt it
+    uint16_t timer = ESP_DDS_CREATE_TIMER(2000, test_timer_callback, &stats);
+    uint32_t start = DDS_MICROS();
+    while (DDS_MICROS() - start < 50000) {
+        ESP_DDS_PROCESS_TIMERS();
+    }
+    
+    if (timer == ESP_DDS_NO_TIMER || stats.fires + stats.skipped < 20 || stats.fires > 25) {
+        TEST_PRINT("  ❌ TIMER FAIL: %lu fires, %lu skipped in 50 ms (25)\n", stats.fires, stats.skipped);
+        test_passed = false;
+        test_results[23].failures++;
+    } else {
+        TEST_PRINT("  📊 Timer jitter: max=%lu, avg=%lu us over %lu fires\n",
+                  stats.max_late_us, stats.total_late_us / stats.fires, stats.fires);
+    }
+    
+    // A stalled loop fires once and keeps the original phase
+    memset(&stats, 0, sizeof(stats));
+    DDS_DELAY(10);
+    ESP_DDS_PROCESS_TIMERS();
+    ESP_DDS_PROCESS_TIMERS();
+    
+    if (stats.fires != 1 || stats.max_late_us < 6000) {
+        TEST_PRINT("  ❌ TIMER FAIL: Missed periods fired %lu times (1), late=%lu us\n",
+                  stats.fires, stats.max_late_us);
+        test_passed = false;
+        test_results[23].failures++;
+    }
+    
+    // Grouped timers run only when their executor spins
+    uint8_t exec = ESP_DDS_CREATE_EXECUTOR(ESP_DDS_EXECUTOR_SINGLE_THREADED, 1);
+    uint8_t group = ESP_DDS_CREATE_CALLBACK_GROUP(exec, ESP_DDS_GROUP_MUTUALLY_EXCLUSIVE);
+    ESP_DDS_SET_TIMER_GROUP(timer, group);
+    memset(&stats, 0, sizeof(stats));
+    DDS_DELAY(3);
+    ESP_DDS_PROCESS_TIMERS();
+    uint32_t before_spin = stats.fires;
+    ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+    
+    if (before_spin != 0 || stats.fires != 1) {
+        TEST_PRINT("  ❌ TIMER FAIL: Grouped timer fired %lu before spin (0), %lu after (1)\n",
+                  before_spin, stats.fires);
+        test_passed = false;
+        test_results[23].failures++;
+    }
+    
+    // Destroyed timers stay silent and their slot is reused
+    ESP_DDS_DESTROY_TIMER(timer);
+    memset(&stats, 0, sizeof(stats));
+    DDS_DELAY(5);
+    ESP_DDS_PROCESS_TIMERS();
+    ESP_DDS_EXECUTOR_SPIN_SOME(exec);
+    uint16_t reused = ESP_DDS_CREATE_TIMER(1000, test_timer_callback, &stats);
+    
+    if (stats.fires != 0 || reused != timer || ESP_DDS_DESTROY_TIMER(ESP_DDS_MAX_TIMERS)) {
+        TEST_PRINT("  ❌ TIMER FAIL: Destroyed timer fired %lu times or slot %u not reused\n", stats.fires, reused);
+        test_passed = false;
+        test_results[23].failures++;
+    }
+    
+    // 1024 timers spread over 1..1.5 s - every one fires once
+    test_timer_context.init();
+    esp_dds_domain_t* big = test_timer_context.domain();
+    test_timer_stats_t big_stats = {0, 0, 0};
+    uint16_t created = 0;
+    for (uint32_t i = 0; i < TestTimerConfig::timers; i++) {
+        if (ESP_DDS_DOMAIN_CREATE_TIMER(big, 1000000 + i * 488, test_timer_callback, &big_stats) != ESP_DDS_NO_TIMER) {
+            created++;
+        }
+    }
+    
+    // Cost of a timer check with 1024 armed timers
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_DOMAIN_PROCESS_TIMERS(big);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[23].min_time_us) test_results[23].min_time_us = duration;
+        if (duration > test_results[23].max_time_us) test_results[23].max_time_us = duration;
+        test_results[23].avg_time_us = (test_results[23].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    start = DDS_MICROS();
+    while (DDS_MICROS() - start < 1600000 && big_stats.fires < created) {
+        ESP_DDS_DOMAIN_PROCESS_TIMERS(big);
+        DDS_DELAY(1);
+    }
+    
+    if (created != TestTimerConfig::timers || big_stats.fires != created) {
+        TEST_PRINT("  ❌ TIMER FAIL: %u of %u timers created, %lu fired\n",
+                  created, (unsigned)TestTimerConfig::timers, big_stats.fires);
+        test_passed = false;
+        test_results[23].failures++;
+    } else {
+        TEST_PRINT("  📊 1024 timers: max late=%lu, avg late=%lu us\n",
+                  big_stats.max_late_us, big_stats.total_late_us / big_stats.fires);
+    }
+    
+#ifdef DDS_HOST
+    // A 100 ms timer keeps its rate while the 32-bit microsecond clock wraps 300 ms in
+    dds_host_micros_offset() = 0xFFFFFFFFUL - 300000 - (uint32_t)dds_host_time_us();
+    test_timer_context.init();
+    test_timer_stats_t wrap_stats = {0, 0, 0, 0, 0};
+    ESP_DDS_DOMAIN_CREATE_TIMER(big, 100000, test_timer_callback, &wrap_stats);
+    uint32_t wrap_start = DDS_MILLIS();
+    while (DDS_MILLIS() - wrap_start < 1000) {
+        ESP_DDS_DOMAIN_PROCESS_TIMERS(big);
+        DDS_DELAY(1);
+    }
+    dds_host_micros_offset() = 0;
+    
+    if (wrap_stats.fires < 9 || wrap_stats.fires > 10 || wrap_stats.max_late_us > 50000) {
+        TEST_PRINT("  ❌ TIMER FAIL: Across the clock wrap %lu fires in 1 s (10), max late=%lu us\n",
+                  wrap_stats.fires, wrap_stats.max_late_us);
+        test_passed = false;
+        test_results[23].failures++;
+    }
+#endif
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ TIMER PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[23].min_time_us, test_results[23].max_time_us, test_results[23].avg_time_us);
+        test_results[23].passed = true;
+    }
+}
+
+// ===== TEST 25: WAITSET =====
+
+static esp_dds_waitset_t test_waitset_storage;
+
+static void test_waitset_result_callback(const char* action, const void* result, size_t size,
+                                         esp_dds_action_state_t state, void* context) {
+    if (state == ESP_DDS_ACTION_SUCCEEDED) (*(uint32_t*)context)++;
+}
+
+#ifdef ESP_PLATFORM
+static void test_waitset_guard_task(void* arg) {
+    DDS_DELAY(20);
+    ESP_DDS_WAITSET_TRIGGER(&test_waitset_storage, *(uint8_t*)arg);
+    vTaskDelete(NULL);
+}
+#endif
+
+void test_waitset(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 25: WaitSet\n");
+    
+    bool test_passed = true;
+    uint32_t responses = 0, results = 0, steps = 0;
+    test_message_t msg = {7, 0};
+    
+    ESP_DDS_CREATE_SERVICE("/ws/service", test_service_callback, ESP_DDS_ASYNC, NULL);
+    ESP_DDS_CREATE_ACTION("/ws/action", test_exec_goal_callback, test_exec_execute_callback, NULL, &steps);
+    
+    ESP_DDS_WAITSET_INIT(&test_waitset_storage);
+    uint8_t imu = ESP_DDS_WAITSET_ATTACH_TOPIC(&test_waitset_storage, "/ws/imu");
+    uint8_t odom = ESP_DDS_WAITSET_ATTACH_TOPIC(&test_waitset_storage, "/ws/odom");
+    uint8_t reply = ESP_DDS_WAITSET_ATTACH_SERVICE(&test_waitset_storage, "/ws/service");
+    uint8_t result = ESP_DDS_WAITSET_ATTACH_ACTION(&test_waitset_storage, "/ws/action");
+    uint8_t guard = ESP_DDS_WAITSET_ATTACH_GUARD(&test_waitset_storage);
+    
+    // Nothing ready - the wait times out with no condition
+    uint32_t start = DDS_MILLIS();
+    uint32_t fired = ESP_DDS_WAIT(&test_waitset_storage, 20);
+    uint32_t waited = DDS_MILLIS() - start;
+    
+    if (guard == ESP_DDS_NO_CONDITION || fired != 0 || waited < 15) {
+        TEST_PRINT("  ❌ WAITSET FAIL: Idle wait fired=0x%lx after %lu ms (0 after 20 ms)\n", fired, waited);
+        test_passed = false;
+        test_results[24].failures++;
+    }
+    
+    // A sample fires exactly its read condition and can be taken once
+    ESP_DDS_PUBLISH("/ws/odom", msg);
+    fired = ESP_DDS_WAIT(&test_waitset_storage, 100);
+    test_message_t taken = {0, 0};
+    bool took = ESP_DDS_WAITSET_TAKE(&test_waitset_storage, odom, taken);
+    bool took_again = ESP_DDS_WAITSET_TAKE(&test_waitset_storage, odom, taken);
+    
+    if (fired != ESP_DDS_CONDITION_BIT(odom) || !took || took_again || taken.data != msg.data) {
+        TEST_PRINT("  ❌ WAITSET FAIL: Read condition fired=0x%lx (0x%lx), take=%d/%d\n",
+                  fired, ESP_DDS_CONDITION_BIT(odom), took, took_again);
+        test_passed = false;
+        test_results[24].failures++;
+    }
+    
+    // Service response and action result wake the caller, process_pending delivers them
+    int32_t request = 21;
+    ESP_DDS_CALL_SERVICE_ASYNC("/ws/service", request, test_async_callback, &responses, 100);
+    ESP_DDS_SEND_GOAL("/ws/action", request, NULL, test_waitset_result_callback, &results, 100);
+    fired = ESP_DDS_WAIT(&test_waitset_storage, 100);
+    for (int i = 0; i < 5; i++) {
+        ESP_DDS_PROCESS_ACTIONS();
+    }
+    fired |= ESP_DDS_WAIT(&test_waitset_storage, 100);
+    ESP_DDS_PROCESS_PENDING(10);
+    
+    uint32_t expected = ESP_DDS_CONDITION_BIT(reply) | ESP_DDS_CONDITION_BIT(result);
+    if (fired != expected || responses != 1 || results != 1) {
+        TEST_PRINT("  ❌ WAITSET FAIL: fired=0x%lx (0x%lx), responses=%lu (1), results=%lu (1)\n",
+                  fired, expected, responses, results);
+        test_passed = false;
+        test_results[24].failures++;
+    }
+    
+    // Guards fire on demand, detached conditions never
+    ESP_DDS_WAITSET_DETACH(&test_waitset_storage, imu);
+    ESP_DDS_PUBLISH("/ws/imu", msg);
+    ESP_DDS_WAITSET_TRIGGER(&test_waitset_storage, guard);
+    fired = ESP_DDS_WAIT(&test_waitset_storage, 100);
+    
+    if (fired != ESP_DDS_CONDITION_BIT(guard) || ESP_DDS_WAITSET_TRIGGER(&test_waitset_storage, odom)) {
+        TEST_PRINT("  ❌ WAITSET FAIL: Guard fired=0x%lx (0x%lx)\n", fired, ESP_DDS_CONDITION_BIT(guard));
+        test_passed = false;
+        test_results[24].failures++;
+    }
+    
+#ifdef ESP_PLATFORM
+    // Another task wakes the waiting one without polling
+    xTaskCreate(test_waitset_guard_task, "ws_guard", 2048, &guard, 5, NULL);
+    start = DDS_MILLIS();
+    fired = ESP_DDS_WAIT(&test_waitset_storage, 1000);
+    waited = DDS_MILLIS() - start;
+    
+    if (fired != ESP_DDS_CONDITION_BIT(guard) || waited > 100) {
+        TEST_PRINT("  ❌ WAITSET FAIL: Cross-task wake fired=0x%lx after %lu ms\n", fired, waited);
+        test_passed = false;
+        test_results[24].failures++;
+    }
+#endif
+    
+    // Cost of publishing to a read condition and waking on it
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_PUBLISH("/ws/odom", msg);
+        ESP_DDS_WAIT(&test_waitset_storage, 10);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[24].min_time_us) test_results[24].min_time_us = duration;
+        if (duration > test_results[24].max_time_us) test_results[24].max_time_us = duration;
+        test_results[24].avg_time_us = (test_results[24].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    ESP_DDS_WAITSET_DEINIT(&test_waitset_storage);
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ WAITSET PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[24].min_time_us, test_results[24].max_time_us, test_results[24].avg_time_us);
+        test_results[24].passed = true;
+    }
+}
+
+// ===== TEST 26: BATCH PUBLISH =====
+
+#define TEST_BATCH_TOPICS 12
+
+// Records the order samples arrive in
+static void test_batch_order_callback(const char* topic, const void* data, size_t size, void* context) {
+    uint32_t* log = (uint32_t*)context;
+    log[++log[0]] = (uint32_t)((const test_message_t*)data)->data;
+}
+
+// Best nanoseconds per sample over TEST_TIMING_SAMPLES rounds of TEST_BENCH_PUBLISHES / 12 cycles
+static uint32_t bench_batch(const esp_dds_batch_entry_t* entries, bool batched, uint32_t* count) {
+    const int cycles = TEST_BENCH_PUBLISHES / TEST_BATCH_TOPICS;
+    uint32_t best = UINT32_MAX;
+    
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        *count = 0;
+        uint32_t start_time = TEST_GET_MICROS();
+        for (int n = 0; n < cycles; n++) {
+            if (batched) {
+                esp_dds_publish_batch(entries, TEST_BATCH_TOPICS);
+            } else {
+                for (int k = 0; k < TEST_BATCH_TOPICS; k++) {
+                    esp_dds_publish_name(entries[k].topic, entries[k].data, entries[k].size);
+                }
+            }
+        }
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        
+        if (*count != (uint32_t)(cycles * TEST_BATCH_TOPICS)) {
+            test_results[25].failures++;
+        }
+        if (duration < best) best = duration;
+        if (batched) {
+            if (duration < test_results[25].min_time_us) test_results[25].min_time_us = duration;
+            if (duration > test_results[25].max_time_us) test_results[25].max_time_us = duration;
+        }
+    }
+    return (uint32_t)((uint64_t)best * 1000 / (cycles * TEST_BATCH_TOPICS));
+}
+
+void test_batch_publish(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 26: Batch Publish\n");
+    
+    bool test_passed = true;
+    uint32_t count = 0;
+    test_message_t first = {1, 0}, second = {2, 0};
+    
+    // Samples arrive in entry order, an invalid entry rejects the whole batch
+    uint32_t log[4] = {0};
+    ESP_DDS_SUBSCRIBE("/batch/a", test_batch_order_callback, log);
+    ESP_DDS_SUBSCRIBE("/batch/b", test_batch_order_callback, log);
+    esp_dds_batch_entry_t ordered[] = {
+        ESP_DDS_BATCH_ENTRY("/batch/b", second),
+        ESP_DDS_BATCH_ENTRY("/batch/a", first),
+        ESP_DDS_BATCH_ENTRY("/batch/b", first)
+    };
+    bool published = ESP_DDS_PUBLISH_BATCH(ordered);
+    
+    esp_dds_batch_entry_t invalid[] = {
+        ESP_DDS_BATCH_ENTRY("/batch/a", first),
+        { esp_dds_make_name("no_slash"), &first, sizeof(first) }
+    };
+    bool rejected = !ESP_DDS_PUBLISH_BATCH(invalid);
+    
+    if (!published || !rejected || log[0] != 3 || log[1] != 2 || log[2] != 1 || log[3] != 1) {
+        TEST_PRINT("  ❌ BATCH FAIL: published=%d, rejected=%d, order=%lu:%lu,%lu,%lu (3:2,1,1)\n",
+                  published, rejected, log[0], log[1], log[2], log[3]);
+        test_passed = false;
+        test_results[25].failures++;
+    }
+    
+    // Sensor hub - 12 topics published every cycle, names hashed once up front
+    static const char* hub_topics[TEST_BATCH_TOPICS] = {
+        "/hub/imu", "/hub/gyro", "/hub/mag", "/hub/baro", "/hub/temp", "/hub/humidity",
+        "/hub/current", "/hub/voltage", "/hub/encoder_l", "/hub/encoder_r", "/hub/range", "/hub/light"
+    };
+    test_message_t samples[TEST_BATCH_TOPICS];
+    esp_dds_batch_entry_t entries[TEST_BATCH_TOPICS];
+    for (int k = 0; k < TEST_BATCH_TOPICS; k++) {
+        samples[k].data = k;
+        samples[k].timestamp = 0;
+        entries[k].topic = esp_dds_make_name(hub_topics[k]);
+        entries[k].data = &samples[k];
+        entries[k].size = sizeof(samples[k]);
+        esp_dds_subscribe(hub_topics[k], test_topic_callback, &count);
+    }
+    
+    uint32_t single_ns = bench_batch(entries, false, &count);
+    uint32_t batch_ns = bench_batch(entries, true, &count);
+    
+    if (test_results[25].failures) {
+        TEST_PRINTLN("  ❌ BATCH FAIL: Lost deliveries");
+        test_passed = false;
+    }
+    
+    if (test_passed) {
+        test_results[25].avg_time_us = batch_ns * TEST_BATCH_TOPICS / 1000;
+        TEST_PRINT("  ✅ BATCH PASS: %d topics, %lu ns per sample individually, %lu ns batched\n",
+                  TEST_BATCH_TOPICS, (unsigned long)single_ns, (unsigned long)batch_ns);
+        test_results[25].passed = true;
+    }
+}
+
+// ===== TEST 27: KEYED TOPICS =====
+
+typedef struct {
+    uint32_t timestamp;
+    uint16_t motor_id;   // Key
+    int16_t current_ma;
+} test_motor_state_t;
+
+void test_keyed_topics(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 27: Keyed Topics\n");
+    
+    bool test_passed = true;
+    uint32_t all_count = 0, selected_count = 0;
+    const uint32_t selected[] = {2, 5};
+    
+    ESP_DDS_SET_TOPIC_KEY("/motors/state", test_motor_state_t, motor_id);
+    ESP_DDS_SUBSCRIBE("/motors/state", test_topic_callback, &all_count);
+    bool restricted = ESP_DDS_SUBSCRIBE_INSTANCES("/motors/state", selected, test_topic_callback, &selected_count);
+    bool unkeyed = ESP_DDS_SUBSCRIBE_INSTANCES("/motors/unkeyed", selected, test_topic_callback, &selected_count);
+    
+    // Latest sample per motor, restricted subscribers see only their motors
+    for (uint16_t round = 0; round < 2; round++) {
+        for (uint16_t id = 0; id < 8; id++) {
+            test_motor_state_t state = {round, id, (int16_t)(id * 100 + round)};
+            ESP_DDS_PUBLISH("/motors/state", state);
+        }
+    }
+    
+    test_motor_state_t motor = {0, 0, 0};
+    bool read3 = ESP_DDS_READ_INSTANCE("/motors/state", 3, motor);
+    bool read9 = ESP_DDS_READ_INSTANCE("/motors/state", 9, motor) ||
+                 ESP_DDS_READ_INSTANCE("/motors/unkeyed", 3, motor);
+    ESP_DDS_READ_INSTANCE("/motors/state", 3, motor);
+    
+    if (!restricted || unkeyed || !read3 || read9 || motor.current_ma != 301 ||
+        all_count != 16 || selected_count != 4) {
+        TEST_PRINT("  ❌ KEYED FAIL: read=%d/%d current=%d (301), all=%lu (16), selected=%lu (4)\n",
+                  read3, read9, motor.current_ma, all_count, selected_count);
+        test_passed = false;
+        test_results[26].failures++;
+    }
+    
+    // Samples without the key are rejected, a full instance pool still delivers
+    uint16_t truncated = 3;
+    bool short_rejected = !ESP_DDS_PUBLISH("/motors/state", truncated);
+    
+    ESP_DDS_SET_TOPIC_KEY("/cells/voltage", test_motor_state_t, motor_id);
+    bool rekey_rejected = !ESP_DDS_SET_TOPIC_KEY("/cells/voltage", test_motor_state_t, current_ma);
+    ESP_DDS_SUBSCRIBE("/cells/voltage", test_topic_callback, &all_count);
+    all_count = 0;
+    uint32_t cached = 0;
+    for (uint16_t cell = 0; cell < ESP_DDS_MAX_INSTANCES; cell++) {
+        test_motor_state_t state = {0, cell, 3700};
+        if (ESP_DDS_PUBLISH("/cells/voltage", state)) cached++;
+    }
+    
+    if (!short_rejected || !rekey_rejected || cached != ESP_DDS_MAX_INSTANCES - 8 ||
+        all_count != ESP_DDS_MAX_INSTANCES) {
+        TEST_PRINT("  ❌ KEYED FAIL: short=%d, rekey=%d, cached=%lu (%d), delivered=%lu (%d)\n",
+                  short_rejected, rekey_rejected, cached, ESP_DDS_MAX_INSTANCES - 8,
+                  all_count, ESP_DDS_MAX_INSTANCES);
+        test_passed = false;
+        test_results[26].failures++;
+    }
+    
+    // Cost of reading the latest sample of one instance
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start_time = TEST_GET_MICROS();
+        ESP_DDS_READ_INSTANCE("/motors/state", 7, motor);
+        uint32_t duration = TEST_GET_MICROS() - start_time;
+        if (duration < test_results[26].min_time_us) test_results[26].min_time_us = duration;
+        if (duration > test_results[26].max_time_us) test_results[26].max_time_us = duration;
+        test_results[26].avg_time_us = (test_results[26].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ KEYED PASS: Timing: min=%lu, max=%lu, avg=%lu us\n",
+                  test_results[26].min_time_us, test_results[26].max_time_us, test_results[26].avg_time_us);
+        test_results[26].passed = true;
+    }
+}
+
+// ===== TEST 28: SHARED MEMORY TRANSPORT =====
+
+#ifdef ESP_DDS_SHM_AVAILABLE
+#include <stdlib.h>
+#include <sys/wait.h>
+
+#define TEST_SHM_ROUND_TRIPS 200   // Per timing sample
+
+typedef struct {
+    int32_t seq;                   // -1 stops the echo process
+    uint32_t sent_us;
+    uint32_t echoed_us;            // Same monotonic clock in both processes
+} test_shm_sample_t;
+
+ESP_DDS_DOMAIN_DEFINE(test_sim_domain, 8, 1, 1, 128);
+ESP_DDS_DOMAIN_DEFINE(test_hil_domain, 8, 1, 1, 128);
+static esp_dds_shm_t test_sim_shm, test_hil_shm;
+
+static void test_shm_echo_callback(const char* topic, const void* data, size_t size, void* context) {
+    test_shm_sample_t sample = *(const test_shm_sample_t*)data;
+    sample.echoed_us = DDS_MICROS();
+    ESP_DDS_DOMAIN_PUBLISH(&test_hil_domain, "/shm/pong", sample);
+    *(int32_t*)context = sample.seq;
+}
+
+static void test_shm_pong_callback(const char* topic, const void* data, size_t size, void* context) {
+    *(test_shm_sample_t*)context = *(const test_shm_sample_t*)data;
+}
+
+// Second process - echoes pings until told to stop, exit code 0 on success
+static void test_shm_echo_process(const char* group) {
+    ESP_DDS_DOMAIN_INIT(&test_hil_domain);
+    int32_t last = 0;
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_hil_domain, "/shm/ping", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_hil_domain, "/shm/pong", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_hil_domain, "/shm/ping", test_shm_echo_callback, &last);
+    if (!ESP_DDS_DOMAIN_SHM_OPEN(&test_hil_domain, &test_hil_shm, group)) _exit(1);
+    
+    while (last != -1 && ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_hil_domain, 2000)) {
+    }
+    ESP_DDS_SHM_CLOSE(&test_hil_shm);
+    _exit(last == -1 ? 0 : 2);
+}
+
+typedef struct {
+    uint32_t seq;
+    uint8_t fill[60];              // Every byte the low byte of seq
+} test_shm_burst_t;
+
+typedef struct {
+    uint32_t delivered;
+    uint32_t torn;
+} test_shm_burst_count_t;
+
+// Slow subscriber - a sample changing under it while it sleeps was delivered torn
+static void test_shm_burst_callback(const char* topic, const void* data, size_t size, void* context) {
+    test_shm_burst_count_t* count = (test_shm_burst_count_t*)context;
+    const test_shm_burst_t* sample = (const test_shm_burst_t*)data;
+    uint32_t seq = sample->seq;
+    usleep(50);
+    bool intact = size == sizeof(*sample) && sample->seq == seq;
+    for (size_t i = 0; intact && i < sizeof(sample->fill); i++) {
+        intact = sample->fill[i] == (uint8_t)seq;
+    }
+    count->delivered++;
+    if (!intact) count->torn++;
+}
+
+// Second process - publishes as fast as it can for a while, laps the slow reader
+static void test_shm_burst_process(const char* group) {
+    ESP_DDS_DOMAIN_INIT(&test_hil_domain);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_hil_domain, "/shm/burst", ESP_DDS_NETWORK_VISIBLE);
+    if (!ESP_DDS_DOMAIN_SHM_OPEN(&test_hil_domain, &test_hil_shm, group)) _exit(1);
+    
+    test_shm_burst_t sample;
+    uint32_t start = DDS_MILLIS();
+    for (uint32_t seq = 0; DDS_MILLIS() - start < 200; seq++) {
+        sample.seq = seq;
+        memset(sample.fill, (uint8_t)seq, sizeof(sample.fill));
+        ESP_DDS_DOMAIN_PUBLISH(&test_hil_domain, "/shm/burst", sample);
+    }
+    ESP_DDS_SHM_CLOSE(&test_hil_shm);
+    _exit(0);
+}
+
+// Publishes a ping and waits for its echo, returns the one-way latency or UINT32_MAX
+static uint32_t test_shm_round_trip(int32_t seq, test_shm_sample_t* pong, uint32_t* rtt) {
+    test_shm_sample_t ping = {seq, DDS_MICROS(), 0};
+    ESP_DDS_DOMAIN_PUBLISH(&test_sim_domain, "/shm/ping", ping);
+    while (pong->seq != seq) {
+        if (!ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_sim_domain, 100)) return UINT32_MAX;
+    }
+    *rtt = DDS_MICROS() - ping.sent_us;
+    return pong->echoed_us - ping.sent_us;
+}
+
+static int test_compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void test_shm_transport(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 28: Shared Memory Transport\n");
+    
+    bool test_passed = true;
+    char group[ESP_DDS_SHM_MAX_GROUP_LENGTH];
+    snprintf(group, sizeof(group), "esp_dds_test_%d", (int)getpid());
+    
+    // Two domains stand in for two processes - visible topics cross, local ones do not
+    uint32_t sim_count = 0, hil_count = 0;
+    ESP_DDS_DOMAIN_INIT(&test_sim_domain);
+    ESP_DDS_DOMAIN_INIT(&test_hil_domain);
+    bool opened = ESP_DDS_DOMAIN_SHM_OPEN(&test_sim_domain, &test_sim_shm, group) &&
+                  ESP_DDS_DOMAIN_SHM_OPEN(&test_hil_domain, &test_hil_shm, group);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_sim_domain, "/sim/ctrl", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_hil_domain, "/sim/ctrl", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_sim_domain, "/sim/ctrl", test_topic_callback, &sim_count);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_hil_domain, "/sim/ctrl", test_topic_callback, &hil_count);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_hil_domain, "/sim/local", test_topic_callback, &hil_count);
+    
+    test_message_t msg = {7, 0};
+    for (int i = 0; i < 10; i++) ESP_DDS_DOMAIN_PUBLISH(&test_sim_domain, "/sim/ctrl", msg);
+    ESP_DDS_DOMAIN_PUBLISH(&test_sim_domain, "/sim/local", msg);
+    uint16_t received = ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_hil_domain, 0);
+    uint16_t echoed = ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_sim_domain, 0);
+    
+    // The ring has one writer, a lagging reader loses the oldest samples
+    bool refused = !test_hil_shm.base.dropped;
+    ESP_DDS_DOMAIN_PUBLISH(&test_hil_domain, "/sim/ctrl", msg);
+    refused = refused && test_hil_shm.base.dropped == 1;
+    for (int i = 0; i < ESP_DDS_SHM_SLOTS + 10; i++) ESP_DDS_DOMAIN_PUBLISH(&test_sim_domain, "/sim/ctrl", msg);
+    uint16_t lagged = ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_hil_domain, 0);
+    
+    if (!opened || received != 10 || echoed != 0 || sim_count != 10 + ESP_DDS_SHM_SLOTS + 10 ||
+        !refused || lagged != ESP_DDS_SHM_SLOTS || test_hil_shm.lost != 10 ||
+        hil_count != 10 + 1 + ESP_DDS_SHM_SLOTS) {
+        TEST_PRINT("  ❌ SHM FAIL: opened=%d, received=%u (10), echoed=%u, refused=%d, lagged=%u (%d), lost=%lu (10)\n",
+                  opened, received, echoed, refused, lagged, ESP_DDS_SHM_SLOTS, (unsigned long)test_hil_shm.lost);
+        test_passed = false;
+        test_results[27].failures++;
+    }
+    ESP_DDS_SHM_CLOSE(&test_hil_shm);
+    
+    // Two processes - ping-pong through the rings, futex wakeups on both sides
+    test_shm_sample_t pong = {0, 0, 0};
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_sim_domain, "/shm/ping", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_sim_domain, "/shm/pong", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_sim_domain, "/shm/pong", test_shm_pong_callback, &pong);
+    
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0) test_shm_echo_process(group);
+    
+    // The echo process reads only samples written after it mapped the ring
+    uint32_t rtt = 0, start = DDS_MILLIS();
+    bool ready = false;
+    while (child > 0 && !ready && DDS_MILLIS() - start < 2000) {
+        test_shm_sample_t ping = {0, DDS_MICROS(), 0};
+        pong.seq = -2;
+        ESP_DDS_DOMAIN_PUBLISH(&test_sim_domain, "/shm/ping", ping);
+        ready = ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_sim_domain, 10) && pong.seq == 0;
+    }
+    
+    static uint32_t latencies[TEST_TIMING_SAMPLES * TEST_SHM_ROUND_TRIPS];
+    uint32_t count = 0;
+    uint64_t rtt_total = 0;
+    for (int i = 0; ready && i < TEST_TIMING_SAMPLES; i++) {
+        uint64_t round_total = 0;
+        for (int n = 1; n <= TEST_SHM_ROUND_TRIPS; n++) {
+            uint32_t latency = test_shm_round_trip(i * TEST_SHM_ROUND_TRIPS + n, &pong, &rtt);
+            if (latency == UINT32_MAX) {
+                test_results[27].failures++;
+                break;
+            }
+            latencies[count++] = latency;
+            round_total += latency;
+            rtt_total += rtt;
+        }
+        uint32_t duration = (uint32_t)(round_total / TEST_SHM_ROUND_TRIPS);
+        if (duration < test_results[27].min_time_us) test_results[27].min_time_us = duration;
+        if (duration > test_results[27].max_time_us) test_results[27].max_time_us = duration;
+        test_results[27].avg_time_us = (test_results[27].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    test_shm_sample_t stop = {-1, 0, 0};
+    ESP_DDS_DOMAIN_PUBLISH(&test_sim_domain, "/shm/ping", stop);
+    int status = -1;
+    if (child > 0) waitpid(child, &status, 0);
+    
+    if (!ready || count != TEST_TIMING_SAMPLES * TEST_SHM_ROUND_TRIPS || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0) {
+        TEST_PRINT("  ❌ SHM FAIL: ready=%d, round trips=%lu (%d), echo exit=%d\n",
+                  ready, (unsigned long)count, TEST_TIMING_SAMPLES * TEST_SHM_ROUND_TRIPS, status);
+        test_passed = false;
+        test_results[27].failures++;
+    }
+    
+    // A writer lapping a slow reader - samples get lost, none arrive torn
+    test_shm_burst_count_t burst = {0, 0};
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_sim_domain, "/shm/burst", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_sim_domain, "/shm/burst", test_shm_burst_callback, &burst);
+    uint32_t lost_before = test_sim_shm.lost;
+    fflush(stdout);
+    child = fork();
+    if (child == 0) test_shm_burst_process(group);
+    
+    status = -1;
+    bool exited = child <= 0;
+    while (!exited || ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_sim_domain, 0)) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_sim_domain, 10);
+        exited = exited || waitpid(child, &status, WNOHANG) == child;
+    }
+    ESP_DDS_SHM_CLOSE(&test_sim_shm);
+    
+    uint32_t overrun = test_sim_shm.lost - lost_before;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || burst.delivered == 0 || overrun == 0 ||
+        burst.torn != 0) {
+        TEST_PRINT("  ❌ SHM FAIL: burst exit=%d, delivered=%lu, lost=%lu (>0), torn=%lu (0)\n",
+                  status, (unsigned long)burst.delivered, (unsigned long)overrun, (unsigned long)burst.torn);
+        test_passed = false;
+        test_results[27].failures++;
+    }
+    
+    if (test_passed) {
+        qsort(latencies, count, sizeof(latencies[0]), test_compare_u32);
+        TEST_PRINT("  ✅ SHM PASS: One-way latency min=%lu, median=%lu, p99=%lu us, round trip avg=%lu us\n",
+                  (unsigned long)latencies[0], (unsigned long)latencies[count / 2],
+                  (unsigned long)latencies[count * 99 / 100], (unsigned long)(rtt_total / count));
+        test_results[27].passed = true;
+    }
+}
+#else
+void test_shm_transport(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 28: Shared Memory Transport\n");
+    TEST_PRINTLN("  ✅ SHM PASS: Not available on this platform (Linux host builds only)");
+    test_results[27].passed = true;
+}
+#endif
+
+// ===== TEST 29: SERIAL TRANSPORT =====
+
+#ifdef DDS_HOST
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <termios.h>
+
+#define TEST_UART_CALLS 20         // Sync calls per timing sample
+#define TEST_UART_BENCH_SAMPLES 400
+
+typedef struct {
+    uint32_t steps;
+    uint32_t feedback;
+    uint32_t results;
+    esp_dds_action_state_t state;
+    int32_t value;
+} test_uart_action_t;
+
+ESP_DDS_DOMAIN_DEFINE(test_uart_client, 8, 2, 2, 256);
+ESP_DDS_DOMAIN_DEFINE(test_uart_server, 8, 2, 2, 256);
+static esp_dds_uart_t test_client_uart, test_server_uart;
+static volatile bool test_uart_serving;
+
+static bool test_uart_add(const void* request, size_t req_size, void* response, size_t* resp_size, void* context) {
+    const int32_t* operands = (const int32_t*)request;
+    if (req_size != 2 * sizeof(int32_t) || operands[0] < 0) return false;
+    int32_t sum = operands[0] + operands[1];
+    memcpy(response, &sum, sizeof(sum));
+    *resp_size = sizeof(sum);
+    return true;
+}
+
+static void test_uart_sum(const char* service, const void* response, size_t size, void* context) {
+    memcpy(context, response, sizeof(int32_t));
+}
+
+static bool test_uart_goal(const void* goal, size_t size, void* context) {
+    return *(const int32_t*)goal >= 0;
+}
+
+// One feedback step, then done - canceled if the client asked meanwhile
+static esp_dds_action_state_t test_uart_execute(const void* goal, size_t goal_size, void* result,
+                                                 size_t* result_size, void* context) {
+    test_uart_action_t* a = (test_uart_action_t*)context;
+    if (a->steps++ == 0) {
+        ESP_DDS_DOMAIN_SEND_FEEDBACK(&test_uart_server, "/uart/move", a->steps);
+        return ESP_DDS_ACTION_EXECUTING;
+    }
+    int32_t doubled = *(const int32_t*)goal * 2;
+    memcpy(result, &doubled, sizeof(doubled));
+    *result_size = sizeof(doubled);
+    return ESP_DDS_DOMAIN_IS_GOAL_CANCELED(&test_uart_server, "/uart/move") ? ESP_DDS_ACTION_CANCELED
+                                                                            : ESP_DDS_ACTION_SUCCEEDED;
+}
+
+static void test_uart_feedback(const char* action, const void* feedback, size_t size, void* context) {
+    ((test_uart_action_t*)context)->feedback++;
+}
+
+static void test_uart_result(const char* action, const void* result, size_t size, esp_dds_action_state_t state,
+                             void* context) {
+    test_uart_action_t* a = (test_uart_action_t*)context;
+    a->results++;
+    a->state = state;
+    a->value = size == sizeof(int32_t) ? *(const int32_t*)result : -1;
+}
+
+// Client and server take turns until the client's result callback ran
+static void test_uart_run_goal(test_uart_action_t* client) {
+    uint32_t results = client->results;
+    for (int i = 0; i < 100 && client->results == results; i++) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 1);
+        ESP_DDS_DOMAIN_PROCESS_ACTIONS(&test_uart_server);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_client, 1);
+        ESP_DDS_DOMAIN_PROCESS_PENDING(&test_uart_client, 0);
+    }
+}
+
+// Polls the server until a count is reached, frames dropped as noise return nothing
+static void test_uart_wait(uint32_t* count, uint32_t expected) {
+    uint32_t start = DDS_MILLIS();
+    while (*count < expected && DDS_MILLIS() - start < 500) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 10);
+    }
+}
+
+static void* test_uart_server_thread(void* arg) {
+    while (test_uart_serving) ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 5);
+    return NULL;
+}
+
+// Streams small samples over a line paced to the given rate, one publish per sample or
+// batches of 8 sharing a frame. Returns delivered samples per second of line time.
+static uint32_t test_uart_throughput(uint32_t baud, bool batched, uint32_t* received, uint32_t* wire_bytes) {
+    test_client_uart.line_baud = baud;
+    test_client_uart.line_free_us = 0;
+    uint32_t count = 0, sent_bytes = test_client_uart.bytes_sent;
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_uart_server, "/uart/bench", test_topic_callback, &count);
+    
+    uint64_t sample = 0;
+    esp_dds_batch_entry_t entry = ESP_DDS_BATCH_ENTRY("/uart/bench", sample);
+    esp_dds_batch_entry_t batch[8];
+    for (int i = 0; i < 8; i++) batch[i] = entry;
+    uint64_t start = dds_host_time_us();
+    for (int n = 0; n < TEST_UART_BENCH_SAMPLES; n += batched ? 8 : 1) {
+        if (batched) {
+            ESP_DDS_DOMAIN_PUBLISH_BATCH(&test_uart_client, batch);
+        } else {
+            ESP_DDS_DOMAIN_PUBLISH(&test_uart_client, "/uart/bench", sample);
+        }
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 0);
+    }
+    while (dds_host_time_us() < test_client_uart.line_free_us) {
+    }
+    uint64_t elapsed = test_client_uart.line_free_us - start;
+    while (count < TEST_UART_BENCH_SAMPLES && ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 20)) {
+    }
+    
+    ESP_DDS_DOMAIN_UNSUBSCRIBE(&test_uart_server, "/uart/bench", test_topic_callback);
+    test_client_uart.line_baud = 0;
+    *received = count;
+    *wire_bytes = test_client_uart.bytes_sent - sent_bytes;
+    return (uint32_t)((uint64_t)count * 1000000ULL / (elapsed ? elapsed : 1));
+}
+
+void test_uart_transport(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 29: Serial Transport\n");
+    
+    bool test_passed = true;
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    int slave = -1;
+    if (master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0) {
+        slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    }
+    struct termios tio;
+    if (slave >= 0 && tcgetattr(slave, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+    }
+    ESP_DDS_DOMAIN_INIT(&test_uart_client);
+    ESP_DDS_DOMAIN_INIT(&test_uart_server);
+    bool opened = slave >= 0 && ESP_DDS_DOMAIN_UART_OPEN_FD(&test_uart_client, &test_client_uart, master, 0) &&
+                  ESP_DDS_DOMAIN_UART_OPEN_FD(&test_uart_server, &test_server_uart, slave, 0);
+    
+    // Topics - a batch leaves as one frame, local topics stay home
+    uint32_t received = 0;
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_uart_client, "/uart/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_uart_server, "/uart/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_uart_client, "/uart/bench", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_uart_server, "/uart/bench", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_uart_server, "/uart/imu", test_topic_callback, &received);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_uart_server, "/uart/local", test_topic_callback, &received);
+    test_message_t msg = {7, 0};
+    esp_dds_batch_entry_t batch[] = {
+        ESP_DDS_BATCH_ENTRY("/uart/imu", msg), ESP_DDS_BATCH_ENTRY("/uart/imu", msg),
+        ESP_DDS_BATCH_ENTRY("/uart/imu", msg), ESP_DDS_BATCH_ENTRY("/uart/local", msg)
+    };
+    ESP_DDS_DOMAIN_PUBLISH_BATCH(&test_uart_client, batch);
+    ESP_DDS_DOMAIN_PUBLISH(&test_uart_client, "/uart/imu", msg);
+    uint32_t frames = test_client_uart.link.frames_sent;
+    test_uart_wait(&received, 4);
+    
+    // A corrupt frame and line noise cost only themselves
+    static const uint8_t noise[] = {0x13, 0x37, 0x00, 0x05, 0x01, 0xAA, 0xBB, 0xCC, 0x00};
+    bool written = write(master, noise, sizeof(noise)) == (ssize_t)sizeof(noise);
+    ESP_DDS_DOMAIN_PUBLISH(&test_uart_client, "/uart/imu", msg);
+    test_uart_wait(&received, 5);
+    
+    if (!opened || frames != 2 || received != 5 || !written || test_server_uart.link.frame_errors != 2 ||
+        test_server_uart.link.frames_lost != 0) {
+        TEST_PRINT("  ❌ UART FAIL: opened=%d, frames=%lu (2), received=%lu (5), frame errors=%lu (2)\n",
+                  opened, (unsigned long)frames, (unsigned long)received,
+                  (unsigned long)test_server_uart.link.frame_errors);
+        test_passed = false;
+        test_results[28].failures++;
+    }
+    
+    // Services - the client has none, so calls cross the link
+    int32_t operands[2] = {20, 22};
+    int32_t sum = 0;
+    ESP_DDS_DOMAIN_CREATE_SERVICE(&test_uart_server, "/uart/add", test_uart_add, ESP_DDS_SYNC, NULL);
+    bool hidden = !ESP_DDS_DOMAIN_CALL_SERVICE_SYNC(&test_uart_client, "/uart/add", operands, sum, 20);
+    ESP_DDS_DOMAIN_SET_SERVICE_VISIBILITY(&test_uart_server, "/uart/add", ESP_DDS_NETWORK_VISIBLE);
+    bool called = ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_uart_client, "/uart/add", operands, test_uart_sum, &sum, 100);
+    for (int i = 0; i < 100 && sum != 42; i++) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 1);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_client, 1);
+        ESP_DDS_DOMAIN_PROCESS_PENDING(&test_uart_client, 0);
+    }
+    
+    if (hidden != true || !called || sum != 42 || test_uart_client.pending_count != 0) {
+        TEST_PRINT("  ❌ UART FAIL: hidden=%d, async called=%d, sum=%ld (42), pending=%u\n",
+                  hidden, called, (long)sum, (unsigned)test_uart_client.pending_count);
+        test_passed = false;
+        test_results[28].failures++;
+    }
+    
+    // Actions - accepted, feedback, result; canceled; rejected by the server's goal callback
+    test_uart_action_t server = {0, 0, 0, ESP_DDS_ACTION_ACCEPTED, 0};
+    test_uart_action_t client = {0, 0, 0, ESP_DDS_ACTION_ACCEPTED, 0};
+    ESP_DDS_DOMAIN_CREATE_ACTION(&test_uart_server, "/uart/move", test_uart_goal, test_uart_execute, NULL, &server);
+    ESP_DDS_DOMAIN_SET_ACTION_VISIBILITY(&test_uart_server, "/uart/move", ESP_DDS_NETWORK_VISIBLE);
+    int32_t goal = 21;
+    ESP_DDS_DOMAIN_SEND_GOAL(&test_uart_client, "/uart/move", goal, test_uart_feedback, test_uart_result, &client, 100);
+    test_uart_run_goal(&client);
+    bool succeeded = client.results == 1 && client.state == ESP_DDS_ACTION_SUCCEEDED && client.value == 42 &&
+                     client.feedback == 1;
+    
+    server.steps = 0;
+    ESP_DDS_DOMAIN_SEND_GOAL(&test_uart_client, "/uart/move", goal, test_uart_feedback, test_uart_result, &client, 100);
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_uart_server, 100);
+    bool canceling = ESP_DDS_DOMAIN_CANCEL_GOAL(&test_uart_client, "/uart/move", 100);
+    test_uart_run_goal(&client);
+    bool canceled = canceling && client.results == 2 && client.state == ESP_DDS_ACTION_CANCELED;
+    
+    goal = -1;
+    ESP_DDS_DOMAIN_SEND_GOAL(&test_uart_client, "/uart/move", goal, test_uart_feedback, test_uart_result, &client, 100);
+    test_uart_run_goal(&client);
+    bool rejected = client.results == 3 && client.state == ESP_DDS_ACTION_ABORTED;
+    
+    if (!succeeded || !canceled || !rejected || test_uart_client.pending_count != 0) {
+        TEST_PRINT("  ❌ UART FAIL: succeeded=%d, canceled=%d, rejected=%d, feedback=%lu, pending=%u\n",
+                  succeeded, canceled, rejected, (unsigned long)client.feedback,
+                  (unsigned)test_uart_client.pending_count);
+        test_passed = false;
+        test_results[28].failures++;
+    }
+    
+    // Sync calls against a server thread - the waiting client pumps its own link
+    test_uart_serving = true;
+    pthread_t thread;
+    bool threaded = opened && pthread_create(&thread, NULL, test_uart_server_thread, NULL) == 0;
+    for (int i = 0; threaded && i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start = DDS_MICROS();
+        for (int n = 0; n < TEST_UART_CALLS; n++) {
+            operands[1] = n;
+            if (!ESP_DDS_DOMAIN_CALL_SERVICE_SYNC(&test_uart_client, "/uart/add", operands, sum, 100) ||
+                sum != 20 + n) {
+                test_results[28].failures++;
+            }
+        }
+        uint32_t duration = (DDS_MICROS() - start) / TEST_UART_CALLS;
+        if (duration < test_results[28].min_time_us) test_results[28].min_time_us = duration;
+        if (duration > test_results[28].max_time_us) test_results[28].max_time_us = duration;
+        test_results[28].avg_time_us = (test_results[28].avg_time_us * i + duration) / (i + 1);
+    }
+    operands[0] = -1;
+    bool refused = !ESP_DDS_DOMAIN_CALL_SERVICE_SYNC(&test_uart_client, "/uart/add", operands, sum, 100);
+    test_uart_serving = false;
+    if (threaded) pthread_join(thread, NULL);
+    
+    if (!threaded || !refused || test_results[28].failures) {
+        TEST_PRINT("  ❌ UART FAIL: server thread=%d, refused call failed=%d\n", threaded, refused);
+        test_passed = false;
+        test_results[28].failures++;
+    }
+    
+    // Throughput at emulated line rates, 8-byte samples
+    static const uint32_t rates[] = {921600, 3000000};
+    uint32_t rate[2][2], wire[2][2];
+    for (int r = 0; opened && r < 2; r++) {
+        for (int b = 0; b < 2; b++) {
+            uint32_t count = 0;
+            rate[r][b] = test_uart_throughput(rates[r], b == 1, &count, &wire[r][b]);
+            if (count != TEST_UART_BENCH_SAMPLES) {
+                TEST_PRINT("  ❌ UART FAIL: %lu baud %s, received %lu of %d\n", (unsigned long)rates[r],
+                          b ? "batched" : "single", (unsigned long)count, TEST_UART_BENCH_SAMPLES);
+                test_passed = false;
+                test_results[28].failures++;
+            }
+        }
+    }
+    
+    ESP_DDS_UART_CLOSE(&test_client_uart);
+    ESP_DDS_UART_CLOSE(&test_server_uart);
+    
+    if (test_passed) {
+        for (int r = 0; r < 2; r++) {
+            TEST_PRINT("  ✅ UART PASS: %lu baud, %lu samples/s single (%lu B/sample), %lu batched by 8 (%lu B/sample)\n",
+                      (unsigned long)rates[r], (unsigned long)rate[r][0],
+                      (unsigned long)(wire[r][0] / TEST_UART_BENCH_SAMPLES), (unsigned long)rate[r][1],
+                      (unsigned long)(wire[r][1] / TEST_UART_BENCH_SAMPLES));
+        }
+        TEST_PRINT("  ✅ UART PASS: Remote sync call %lu us over the pty, services and actions bridged\n",
+                  (unsigned long)test_results[28].avg_time_us);
+        test_results[28].passed = true;
+    }
+}
+#else
+void test_uart_transport(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 29: Serial Transport\n");
+    TEST_PRINTLN("  ✅ UART PASS: Needs a pseudo-terminal pair (host builds only)");
+    test_results[28].passed = true;
+}
+#endif
+
+// ===== TEST 30: SIMULATED NETWORK =====
+
+#ifdef DDS_HOST
+#define TEST_SIM_NODES 50
+#define TEST_SIM_ANNOUNCE_MS 20         // Each node says hello this often
+#define TEST_SIM_STREAM 500             // Samples in the batching comparison
+
+typedef struct {
+    uint32_t sender;
+    uint32_t sent_us;                   // Virtual time of the publish
+    uint8_t payload[24];
+} test_sim_sample_t;
+
+typedef struct {
+    uint32_t count;
+    uint64_t latency_us;
+} test_sim_stream_t;
+
+static esp_dds_sim_net_t test_sim_net;
+static esp_dds_sim_node_t test_sim_nodes[TEST_SIM_NODES];
+static test_node_context_t test_sim_contexts[TEST_SIM_NODES];
+static uint64_t test_sim_heard[TEST_SIM_NODES];  // Nodes each node has heard from
+
+static void test_sim_hello(const char* topic, const void* data, size_t size, void* context) {
+    *(uint64_t*)context |= 1ULL << ((const test_sim_sample_t*)data)->sender;
+}
+
+static void test_sim_stream(const char* topic, const void* data, size_t size, void* context) {
+    test_sim_stream_t* s = (test_sim_stream_t*)context;
+    s->count++;
+    s->latency_us += test_sim_net.now_us - ((const test_sim_sample_t*)data)->sent_us;
+}
+
+static void test_sim_build(const esp_dds_sim_config_t* config) {
+    ESP_DDS_SIM_INIT(&test_sim_net, config);
+    for (int i = 0; i < TEST_SIM_NODES; i++) {
+        test_sim_contexts[i].init();
+        esp_dds_domain_t* d = test_sim_contexts[i].domain();
+        ESP_DDS_SIM_ADD_NODE(&test_sim_net, &test_sim_nodes[i], d);
+        ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(d, "/sim/hello", ESP_DDS_NETWORK_VISIBLE);
+        ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(d, "/sim/stream", ESP_DDS_NETWORK_VISIBLE);
+    }
+}
+
+// Every node announces itself on /sim/hello, staggered by node, until all have heard
+// from all. Returns the virtual time that took, 0 if not done within a second.
+static uint32_t test_sim_discover(void) {
+    const uint64_t everyone = (1ULL << TEST_SIM_NODES) - 1;
+    for (int i = 0; i < TEST_SIM_NODES; i++) {
+        test_sim_heard[i] = 1ULL << i;
+        ESP_DDS_DOMAIN_SUBSCRIBE(test_sim_contexts[i].domain(), "/sim/hello", test_sim_hello, &test_sim_heard[i]);
+    }
+    for (uint32_t ms = 0; ms < 1000; ms++) {
+        int done = 0;
+        while (done < TEST_SIM_NODES && test_sim_heard[done] == everyone) done++;
+        if (done == TEST_SIM_NODES) return test_sim_net.now_us;
+        
+        for (int i = ms % TEST_SIM_ANNOUNCE_MS; i < TEST_SIM_NODES; i += TEST_SIM_ANNOUNCE_MS) {
+            test_sim_sample_t hello = {(uint32_t)i, test_sim_net.now_us, {0}};
+            ESP_DDS_DOMAIN_PUBLISH(test_sim_contexts[i].domain(), "/sim/hello", hello);
+        }
+        ESP_DDS_SIM_RUN(&test_sim_net, 1000, 250);
+    }
+    return 0;
+}
+
+// Node 0 streams a sample every 200 us to the last node over a 2 Mbit/s medium, which
+// one frame per sample overloads and 2 ms batches do not
+static void test_sim_stream_run(uint32_t batch_us, test_sim_stream_t* result) {
+    esp_dds_domain_t* sink = test_sim_contexts[TEST_SIM_NODES - 1].domain();
+    esp_dds_domain_t* source = test_sim_contexts[0].domain();
+    *result = {0, 0};
+    ESP_DDS_DOMAIN_SUBSCRIBE(sink, "/sim/stream", test_sim_stream, result);
+    ESP_DDS_LINK_SET_BATCHING(&test_sim_nodes[0].link, batch_us);
+    for (int n = 0; n < TEST_SIM_STREAM; n++) {
+        test_sim_sample_t sample = {0, test_sim_net.now_us, {0}};
+        ESP_DDS_DOMAIN_PUBLISH(source, "/sim/stream", sample);
+        ESP_DDS_SIM_RUN(&test_sim_net, 200, 200);
+    }
+    ESP_DDS_SIM_RUN(&test_sim_net, 200000, 1000);
+    ESP_DDS_LINK_SET_BATCHING(&test_sim_nodes[0].link, 0);
+    ESP_DDS_DOMAIN_UNSUBSCRIBE(sink, "/sim/stream", test_sim_stream);
+}
+
+void test_sim_network(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 30: Simulated Network\n");
+    
+    bool test_passed = true;
+    esp_dds_sim_config_t config = {500, 200, 10000000, 10, 30, 42};  // 1% loss at 10 Mbit/s
+    
+    // Discovery - the same seed gives the same run, down to the last lost frame
+    uint32_t discovered = 0, frames = 0, lost = 0;
+    bool repeated = true;
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start = DDS_MICROS();
+        test_sim_build(&config);
+        uint32_t took = test_sim_discover();
+        uint32_t duration = DDS_MICROS() - start;
+        if (i == 0) {
+            discovered = took;
+            frames = test_sim_net.frames_sent;
+            lost = test_sim_net.frames_lost;
+        } else if (took != discovered || test_sim_net.frames_sent != frames || test_sim_net.frames_lost != lost) {
+            repeated = false;
+        }
+        ESP_DDS_SIM_CLOSE(&test_sim_net);
+        if (duration < test_results[29].min_time_us) test_results[29].min_time_us = duration;
+        if (duration > test_results[29].max_time_us) test_results[29].max_time_us = duration;
+        test_results[29].avg_time_us = (test_results[29].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    if (!discovered || !repeated || !lost) {
+        TEST_PRINT("  ❌ SIM FAIL: discovered after %lu us, repeated=%d, frames=%lu, lost=%lu\n",
+                  (unsigned long)discovered, repeated, (unsigned long)frames, (unsigned long)lost);
+        test_passed = false;
+        test_results[29].failures++;
+    }
+    
+    // A service on one node, called from another - the other 48 stay silent
+    test_sim_build(&config);
+    esp_dds_domain_t* client = test_sim_contexts[0].domain();
+    esp_dds_domain_t* server = test_sim_contexts[37].domain();
+    ESP_DDS_DOMAIN_CREATE_SERVICE(server, "/sim/double", test_service_callback, ESP_DDS_SYNC, NULL);
+    ESP_DDS_DOMAIN_SET_SERVICE_VISIBILITY(server, "/sim/double", ESP_DDS_NETWORK_VISIBLE);
+    uint32_t answers = 0;
+    int32_t value = 21;
+    bool called = ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(client, "/sim/double", value, test_async_callback, &answers, 100);
+    uint32_t call_start = test_sim_net.now_us;
+    for (int i = 0; i < 20 && !answers; i++) {
+        ESP_DDS_SIM_RUN(&test_sim_net, 250, 250);
+        ESP_DDS_DOMAIN_PROCESS_PENDING(client, 0);
+    }
+    uint32_t round_trip = test_sim_net.now_us - call_start;
+    ESP_DDS_SIM_CLOSE(&test_sim_net);
+    
+    if (!called || answers != 1 || test_sim_contexts[0].domain()->pending_count != 0) {
+        TEST_PRINT("  ❌ SIM FAIL: call sent=%d, answers=%lu (1), pending=%u\n", called,
+                  (unsigned long)answers, (unsigned)test_sim_contexts[0].domain()->pending_count);
+        test_passed = false;
+        test_results[29].failures++;
+    }
+    
+    // Batching on an overloaded medium - lossless here, so only capacity limits delivery
+    config = {500, 200, 2000000, 0, 30, 42};
+    test_sim_stream_t single, batched;
+    test_sim_build(&config);
+    test_sim_stream_run(0, &single);
+    uint32_t single_frames = test_sim_net.frames_sent;
+    uint32_t overruns = test_sim_net.overruns + test_sim_nodes[TEST_SIM_NODES - 1].overruns;
+    ESP_DDS_SIM_CLOSE(&test_sim_net);
+    test_sim_build(&config);
+    test_sim_stream_run(2000, &batched);
+    uint32_t batched_frames = test_sim_net.frames_sent;
+    ESP_DDS_SIM_CLOSE(&test_sim_net);
+    
+    if (batched.count != TEST_SIM_STREAM || single.count >= TEST_SIM_STREAM || !overruns ||
+        batched_frames * 5 > single_frames) {
+        TEST_PRINT("  ❌ SIM FAIL: delivered %lu single, %lu batched of %d, frames %lu / %lu\n",
+                  (unsigned long)single.count, (unsigned long)batched.count, TEST_SIM_STREAM,
+                  (unsigned long)single_frames, (unsigned long)batched_frames);
+        test_passed = false;
+        test_results[29].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ SIM PASS: %d nodes discovered each other in %lu ms at 1%% loss (%lu frames, %lu lost), "
+                  "identical over %d runs of %lu us\n", TEST_SIM_NODES, (unsigned long)(discovered / 1000),
+                  (unsigned long)frames, (unsigned long)lost, TEST_TIMING_SAMPLES,
+                  (unsigned long)test_results[29].avg_time_us);
+        TEST_PRINT("  ✅ SIM PASS: Remote call answered in %lu us, only by the server\n", (unsigned long)round_trip);
+        TEST_PRINT("  ✅ SIM PASS: 5000 samples/s at 2 Mbit/s: %lu of %d arrive one per frame (%lu us mean), "
+                  "all %d in 2 ms batches (%lu us mean, %lu frames)\n",
+                  (unsigned long)single.count, TEST_SIM_STREAM,
+                  (unsigned long)(single.count ? single.latency_us / single.count : 0), TEST_SIM_STREAM,
+                  (unsigned long)(batched.latency_us / TEST_SIM_STREAM), (unsigned long)batched_frames);
+        test_results[29].passed = true;
+    }
+}
+#else
+void test_sim_network(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 30: Simulated Network\n");
+    TEST_PRINTLN("  ✅ SIM PASS: Sized for host builds, 50 simulated domains");
+    test_results[29].passed = true;
+}
+#endif
+
+// ===== TEST 31: RELIABLE DELIVERY =====
+
+#ifdef DDS_HOST
+#define TEST_UDP_SAMPLES 1000           // Per loss rate
+#define TEST_UDP_BURST 100              // Samples per timing sample
+
+typedef struct {
+    uint32_t index;
+    uint8_t payload[28];
+} test_udp_sample_t;
+
+typedef struct {
+    uint32_t delivered;
+    uint32_t repeated;                  // Delivered more than once
+    uint8_t seen[TEST_UDP_SAMPLES];
+} test_udp_reader_t;
+
+ESP_DDS_DOMAIN_DEFINE(test_udp_writer, 4, 1, 1, 128);
+ESP_DDS_DOMAIN_DEFINE(test_udp_reader, 4, 1, 1, 128);
+static esp_dds_udp_t test_writer_udp, test_reader_udp;
+static test_udp_reader_t test_udp_received;
+
+static void test_udp_sample(const char* topic, const void* data, size_t size, void* context) {
+    test_udp_reader_t* r = (test_udp_reader_t*)context;
+    uint32_t index = ((const test_udp_sample_t*)data)->index;
+    if (index >= TEST_UDP_SAMPLES) return;
+    if (r->seen[index]++) {
+        r->repeated++;
+    } else {
+        r->delivered++;
+    }
+}
+
+// Each publish is followed by one receive on both sides, the tail by heartbeats
+static void test_udp_stream(const char* topic, uint32_t count, uint32_t drain_ms) {
+    memset(&test_udp_received, 0, sizeof(test_udp_received));
+    test_udp_sample_t sample = {0, {0}};
+    for (sample.index = 0; sample.index < count; sample.index++) {
+        ESP_DDS_DOMAIN_PUBLISH(&test_udp_writer, topic, sample);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_writer, 0);
+    }
+    uint32_t start = DDS_MILLIS();
+    while (test_udp_received.delivered < count && DDS_MILLIS() - start < drain_ms) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 1);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_writer, 1);
+    }
+}
+
+void test_reliable_delivery(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 31: Reliable Delivery\n");
+    
+    bool test_passed = true;
+    ESP_DDS_DOMAIN_INIT(&test_udp_writer);
+    ESP_DDS_DOMAIN_INIT(&test_udp_reader);
+    bool opened = ESP_DDS_DOMAIN_UDP_OPEN(&test_udp_reader, &test_reader_udp, 0, NULL, 0) &&
+                  ESP_DDS_DOMAIN_UDP_OPEN(&test_udp_writer, &test_writer_udp, 0, "127.0.0.1",
+                                          test_reader_udp.local_port);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_writer, "/udp/cmd", ESP_DDS_NETWORK_RELIABLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_reader, "/udp/cmd", ESP_DDS_NETWORK_RELIABLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_writer, "/udp/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_reader, "/udp/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_udp_reader, "/udp/cmd", test_udp_sample, &test_udp_received);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_udp_reader, "/udp/imu", test_udp_sample, &test_udp_received);
+    
+    // Best effort at 20% loss for comparison, then reliable at each loss rate
+    ESP_DDS_UDP_SET_LOSS(&test_writer_udp, 200, 7);
+    test_udp_stream("/udp/imu", 200, 20);
+    uint32_t best_effort = test_udp_received.delivered;
+    
+    static const uint16_t losses[] = {10, 50, 200};
+    uint32_t goodput[3], overhead[3], resent[3];
+    for (int l = 0; opened && l < 3; l++) {
+        ESP_DDS_UDP_SET_LOSS(&test_writer_udp, losses[l], 11 + l);
+        ESP_DDS_UDP_SET_LOSS(&test_reader_udp, losses[l], 23 + l);
+        uint32_t wire = test_writer_udp.bytes_sent + test_reader_udp.bytes_sent;
+        uint32_t resends = test_writer_udp.link.resent;
+        uint32_t start = DDS_MICROS();
+        test_udp_stream("/udp/cmd", TEST_UDP_SAMPLES, 1000);
+        uint32_t elapsed = DDS_MICROS() - start;
+        
+        uint32_t payload = test_udp_received.delivered * sizeof(test_udp_sample_t);
+        wire = test_writer_udp.bytes_sent + test_reader_udp.bytes_sent - wire;
+        goodput[l] = (uint32_t)((uint64_t)payload * 1000 / (elapsed ? elapsed : 1));  // KB/s
+        overhead[l] = payload ? (uint32_t)((uint64_t)(wire - payload) * 100 / payload) : 0;
+        resent[l] = test_writer_udp.link.resent - resends;
+        if (test_udp_received.delivered != TEST_UDP_SAMPLES || test_udp_received.repeated) {
+            TEST_PRINT("  ❌ RELIABLE FAIL: %u%% loss, delivered %lu of %d, %lu twice, %lu unrecovered\n",
+                      losses[l] / 10, (unsigned long)test_udp_received.delivered, TEST_UDP_SAMPLES,
+                      (unsigned long)test_udp_received.repeated, (unsigned long)test_reader_udp.link.unrecovered);
+            test_passed = false;
+            test_results[30].failures++;
+        }
+    }
+    
+    // Per-sample cost of a reliable burst at 1% loss, drained by heartbeats
+    ESP_DDS_UDP_SET_LOSS(&test_writer_udp, 10, 5);
+    ESP_DDS_UDP_SET_LOSS(&test_reader_udp, 10, 6);
+    for (int i = 0; opened && i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t start = DDS_MICROS();
+        test_udp_stream("/udp/cmd", TEST_UDP_BURST, 1000);
+        uint32_t duration = (DDS_MICROS() - start) / TEST_UDP_BURST;
+        if (test_udp_received.delivered != TEST_UDP_BURST) test_results[30].failures++;
+        if (duration < test_results[30].min_time_us) test_results[30].min_time_us = duration;
+        if (duration > test_results[30].max_time_us) test_results[30].max_time_us = duration;
+        test_results[30].avg_time_us = (test_results[30].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    // A repeated and a late frame count as reordered, not as 65535 frames lost
+    esp_dds_link_t* rx = &test_reader_udp.link;
+    uint32_t lost = rx->frames_lost, reordered = rx->frames_reordered;
+    uint16_t expected = rx->rx_sequence;
+    uint8_t repeated[ESP_DDS_LINK_FRAME_HEADER] = {ESP_DDS_LINK_VERSION, 0, (uint8_t)(expected - 1),
+                                                   (uint8_t)((uint16_t)(expected - 1) >> 8)};
+    uint8_t late[ESP_DDS_LINK_FRAME_HEADER] = {ESP_DDS_LINK_VERSION, 0, (uint8_t)(expected - 5),
+                                               (uint8_t)((uint16_t)(expected - 5) >> 8)};
+    esp_dds_link_input(rx, repeated, sizeof(repeated));
+    esp_dds_link_input(rx, late, sizeof(late));
+    if (rx->frames_lost != lost || rx->frames_reordered != reordered + 2 || rx->rx_sequence != expected) {
+        TEST_PRINT("  ❌ RELIABLE FAIL: old frames counted %lu lost (0), %lu reordered (2)\n",
+                  (unsigned long)(rx->frames_lost - lost), (unsigned long)(rx->frames_reordered - reordered));
+        test_results[30].failures++;
+    }
+    
+    ESP_DDS_UDP_CLOSE(&test_writer_udp);
+    ESP_DDS_UDP_CLOSE(&test_reader_udp);
+    
+    if (!opened || best_effort >= 200 || test_results[30].failures) {
+        TEST_PRINT("  ❌ RELIABLE FAIL: opened=%d, best effort delivered %lu of 200 at 20%% loss\n", opened,
+                  (unsigned long)best_effort);
+        test_passed = false;
+        test_results[30].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ RELIABLE PASS: Best effort delivers %lu of 200 at 20%% loss, reliable all of %d:\n",
+                  (unsigned long)best_effort, TEST_UDP_SAMPLES);
+        for (int l = 0; l < 3; l++) {
+            TEST_PRINT("  ✅ RELIABLE PASS: %2u%% loss, goodput %lu KB/s, %lu resent, wire overhead %lu%%\n",
+                      losses[l] / 10, (unsigned long)goodput[l], (unsigned long)resent[l],
+                      (unsigned long)overhead[l]);
+        }
+        test_results[30].passed = true;
+    }
+}
+#else
+void test_reliable_delivery(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 31: Reliable Delivery\n");
+    TEST_PRINTLN("  ✅ RELIABLE PASS: Needs UDP loopback (host builds only)");
+    test_results[30].passed = true;
+}
+#endif
+
+// ===== TEST 32: LARGE SAMPLES =====
+
+#if defined(DDS_HOST) && ESP_DDS_MAX_SAMPLE_SIZE >= 65536
+#define TEST_LARGE_BYTES 1048576        // Per sample size in the benchmark
+
+typedef struct {
+    uint32_t delivered;
+    uint32_t corrupt;                   // Wrong size or content
+    uint32_t small_during;              // Small samples delivered while a large one was in flight
+    uint32_t small;
+    bool large_pending;
+} test_large_reader_t;
+
+static uint8_t test_large_data[65536];
+static test_large_reader_t test_large_received;
+
+// Byte i of sample n is n + i, the size travels in the first word
+static void test_large_fill(uint32_t n, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) test_large_data[i] = (uint8_t)(n + i);
+    memcpy(test_large_data, &size, sizeof(size));
+}
+
+static void test_large_sample(const char* topic, const void* data, size_t size, void* context) {
+    test_large_reader_t* r = (test_large_reader_t*)context;
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t expected;
+    memcpy(&expected, bytes, sizeof(expected));
+    bool intact = expected == size;
+    for (uint32_t i = sizeof(expected); intact && i < size; i++) {
+        intact = bytes[i] == (uint8_t)(bytes[sizeof(expected)] + i - sizeof(expected));
+    }
+    if (intact) {
+        r->delivered++;
+    } else {
+        r->corrupt++;
+    }
+    r->large_pending = false;
+}
+
+static void test_small_sample(const char* topic, const void* data, size_t size, void* context) {
+    test_large_reader_t* r = (test_large_reader_t*)context;
+    r->small++;
+    if (r->large_pending) r->small_during++;
+}
+
+// Publishes a large sample and moves fragments until it arrived, a small sample per round
+static bool test_large_transfer(const char* topic, uint32_t n, uint32_t size, bool with_small) {
+    uint32_t delivered = test_large_received.delivered;
+    test_large_fill(n, size);
+    test_large_received.large_pending = true;
+    if (!esp_dds_domain_publish(&test_udp_writer, topic, test_large_data, size)) return false;
+    uint32_t start = DDS_MILLIS();
+    while (test_large_received.delivered == delivered && DDS_MILLIS() - start < 200) {
+        if (with_small) ESP_DDS_DOMAIN_PUBLISH(&test_udp_writer, "/udp/imu", n);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_writer, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 0);
+    }
+    return test_large_received.delivered != delivered;
+}
+
+void test_large_samples(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 32: Large Samples\n");
+    
+    bool test_passed = true;
+    memset(&test_large_received, 0, sizeof(test_large_received));
+    ESP_DDS_DOMAIN_INIT(&test_udp_writer);
+    ESP_DDS_DOMAIN_INIT(&test_udp_reader);
+    bool opened = ESP_DDS_DOMAIN_UDP_OPEN(&test_udp_reader, &test_reader_udp, 0, NULL, 0) &&
+                  ESP_DDS_DOMAIN_UDP_OPEN(&test_udp_writer, &test_writer_udp, 0, "127.0.0.1",
+                                          test_reader_udp.local_port);
+    static const char* topics[] = {"/udp/tile", "/udp/calib", "/udp/imu"};
+    for (int i = 0; i < 3; i++) {
+        ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_writer, topics[i], ESP_DDS_NETWORK_VISIBLE);
+        ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_reader, topics[i], ESP_DDS_NETWORK_VISIBLE);
+    }
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_udp_reader, "/udp/tile", test_large_sample, &test_large_received);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_udp_reader, "/udp/calib", test_large_sample, &test_large_received);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_udp_reader, "/udp/imu", test_small_sample, &test_large_received);
+    
+    // Throughput over loopback, one sample in flight
+    static const uint32_t sizes[] = {4096, 16384, 65536};
+    uint32_t throughput[3] = {0}, frames[3] = {0};
+    for (int s = 0; opened && s < 3; s++) {
+        uint32_t count = TEST_LARGE_BYTES / sizes[s];
+        uint32_t sent = test_writer_udp.link.frames_sent;
+        uint32_t start = DDS_MICROS();
+        for (uint32_t n = 0; n < count; n++) {
+            if (!test_large_transfer("/udp/tile", n, sizes[s], false)) test_results[31].failures++;
+        }
+        uint32_t elapsed = DDS_MICROS() - start;
+        throughput[s] = (uint32_t)((uint64_t)TEST_LARGE_BYTES * 1000 / (elapsed ? elapsed : 1));  // KB/s
+        frames[s] = (test_writer_udp.link.frames_sent - sent) / count;
+    }
+    
+    // Small samples keep flowing between fragments, two large ones share the link
+    memset(&test_large_received, 0, sizeof(test_large_received));
+    bool interleaved = opened && test_large_transfer("/udp/tile", 1, 65536, true);
+    test_large_fill(2, 65536);
+    esp_dds_domain_publish(&test_udp_writer, "/udp/tile", test_large_data, 65536);
+    test_large_fill(3, 30000);
+    esp_dds_domain_publish(&test_udp_writer, "/udp/calib", test_large_data, 30000);
+    uint32_t start = DDS_MILLIS();
+    while (opened && test_large_received.delivered < 3 && DDS_MILLIS() - start < 200) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_writer, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 0);
+    }
+    if (!interleaved || !test_large_received.small_during || test_large_received.delivered != 3) {
+        TEST_PRINT("  ❌ LARGE FAIL: interleaved=%d, %lu small samples during transfer, %lu of 3 delivered\n",
+                  interleaved, (unsigned long)test_large_received.small_during,
+                  (unsigned long)test_large_received.delivered);
+        test_passed = false;
+        test_results[31].failures++;
+    }
+    
+    // Samples missing a fragment expire, their slots take new samples afterwards
+    ESP_DDS_UDP_SET_LOSS(&test_writer_udp, 100, 3);
+    for (uint32_t n = 0; opened && n < 20; n++) {
+        test_large_fill(n, 4096);
+        esp_dds_domain_publish(&test_udp_writer, "/udp/tile", test_large_data, 4096);
+        for (int round = 0; round < 10; round++) {
+            ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_writer, 0);
+            ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 0);
+        }
+    }
+    ESP_DDS_UDP_SET_LOSS(&test_writer_udp, 0, 1);
+    DDS_DELAY(ESP_DDS_LINK_REASSEMBLY_US / 1000 + 10);
+    uint32_t expired = test_reader_udp.link.reassembly_expired;
+    bool recovered = opened && test_large_transfer("/udp/tile", 21, 4096, false) &&
+                     test_large_transfer("/udp/calib", 22, 4096, false);
+    if (!recovered || test_reader_udp.link.reassembly_expired == expired || test_large_received.corrupt) {
+        TEST_PRINT("  ❌ LARGE FAIL: recovered=%d, %lu expired, %lu corrupt\n", recovered,
+                  (unsigned long)test_reader_udp.link.reassembly_expired,
+                  (unsigned long)test_large_received.corrupt);
+        test_passed = false;
+        test_results[31].failures++;
+    }
+    
+    // Round trip of one 16 KB sample
+    for (int i = 0; opened && i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t begin = DDS_MICROS();
+        if (!test_large_transfer("/udp/tile", i, 16384, false)) test_results[31].failures++;
+        uint32_t duration = DDS_MICROS() - begin;
+        if (duration < test_results[31].min_time_us) test_results[31].min_time_us = duration;
+        if (duration > test_results[31].max_time_us) test_results[31].max_time_us = duration;
+        test_results[31].avg_time_us = (test_results[31].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    ESP_DDS_UDP_CLOSE(&test_writer_udp);
+    ESP_DDS_UDP_CLOSE(&test_reader_udp);
+    
+    if (!opened || test_results[31].failures) {
+        TEST_PRINT("  ❌ LARGE FAIL: opened=%d, %lu failures\n", opened, (unsigned long)test_results[31].failures);
+        test_passed = false;
+        test_results[31].failures++;
+    }
+    
+    if (test_passed) {
+        for (int s = 0; s < 3; s++) {
+            TEST_PRINT("  ✅ LARGE PASS: %2lu KB samples, %lu KB/s over loopback, %lu frames each\n",
+                      (unsigned long)(sizes[s] / 1024), (unsigned long)throughput[s], (unsigned long)frames[s]);
+        }
+        TEST_PRINT("  ✅ LARGE PASS: %lu small samples between fragments, incomplete samples expire\n",
+                  (unsigned long)test_large_received.small_during);
+        test_results[31].passed = true;
+    }
+}
+#else
+void test_large_samples(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 32: Large Samples\n");
+    TEST_PRINTLN("  ✅ LARGE PASS: Needs UDP loopback and ESP_DDS_MAX_SAMPLE_SIZE=65536 (native env)");
+    test_results[31].passed = true;
+}
+#endif
+
+// ===== TEST 33: REMOTE SERVICES =====
+
+#ifdef DDS_HOST
+#define TEST_RPC_CALLS 2000             // Per concurrency level
+#define TEST_RPC_SLOTS 64               // Start times by call index
+
+typedef struct {
+    uint32_t answered;
+    uint32_t wrong;                     // Response for another request
+    uint64_t latency_us;                // Sum over answered calls
+    uint32_t start_us[TEST_RPC_SLOTS];
+} test_rpc_client_t;
+
+ESP_DDS_DOMAIN_DEFINE(test_rpc_client, 4, 2, 32, 256);
+ESP_DDS_DOMAIN_DEFINE(test_rpc_server, 4, 2, 1, 256);
+static test_rpc_client_t test_rpc;
+static uint8_t test_rpc_executor;
+
+static bool test_rpc_echo(const void* request, size_t req_size, void* response, size_t* resp_size, void* context) {
+    memcpy(response, request, req_size);
+    *resp_size = req_size;
+    return true;
+}
+
+static void test_rpc_answer(const char* service, const void* response, size_t size, void* context) {
+    test_rpc_client_t* c = (test_rpc_client_t*)context;
+    uint32_t index;
+    memcpy(&index, response, sizeof(index));
+    if (size != sizeof(index)) {
+        c->wrong++;
+        return;
+    }
+    c->latency_us += DDS_MICROS() - c->start_us[index % TEST_RPC_SLOTS];
+    c->answered++;
+}
+
+// One round of both nodes: the server receives and serves, the client collects
+static void test_rpc_pump(bool serve) {
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_rpc_server, 0);
+    if (serve) while (ESP_DDS_DOMAIN_EXECUTOR_SPIN_SOME(&test_rpc_server, test_rpc_executor)) {}
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_rpc_client, 0);
+    ESP_DDS_DOMAIN_PROCESS_PENDING(&test_rpc_client, 0);
+}
+
+// Keeps up to window calls in flight until count are answered, returns calls/s. Calls
+// the server refuses leave the pending table without an answer and are made again.
+static uint32_t test_rpc_run(uint8_t window, uint32_t count, uint32_t* issued) {
+    memset(&test_rpc, 0, sizeof(test_rpc));
+    ESP_DDS_DOMAIN_SET_REMOTE_WINDOW(&test_rpc_client, window);
+    *issued = 0;
+    uint32_t start = DDS_MICROS();
+    uint32_t start_ms = DDS_MILLIS();
+    while (test_rpc.answered < count && DDS_MILLIS() - start_ms < 5000) {
+        while (test_rpc_client.pending_count < window && test_rpc.answered + test_rpc_client.pending_count < count) {
+            test_rpc.start_us[*issued % TEST_RPC_SLOTS] = DDS_MICROS();
+            if (!ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/echo", *issued, test_rpc_answer,
+                                                   &test_rpc, 1000)) {
+                break;
+            }
+            (*issued)++;
+        }
+        test_rpc_pump(true);
+    }
+    uint32_t elapsed = DDS_MICROS() - start;
+    return (uint32_t)((uint64_t)test_rpc.answered * 1000000 / (elapsed ? elapsed : 1));
+}
+
+void test_remote_services(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 33: Remote Services\n");
+    
+    bool test_passed = true;
+    ESP_DDS_DOMAIN_INIT(&test_rpc_client);
+    ESP_DDS_DOMAIN_INIT(&test_rpc_server);
+    bool opened = ESP_DDS_DOMAIN_UDP_OPEN(&test_rpc_server, &test_reader_udp, 0, NULL, 0) &&
+                  ESP_DDS_DOMAIN_UDP_OPEN(&test_rpc_client, &test_writer_udp, 0, "127.0.0.1",
+                                          test_reader_udp.local_port);
+    test_rpc_executor = ESP_DDS_DOMAIN_CREATE_EXECUTOR(&test_rpc_server, ESP_DDS_EXECUTOR_SINGLE_THREADED, 1);
+    uint8_t group = ESP_DDS_DOMAIN_CREATE_CALLBACK_GROUP(&test_rpc_server, test_rpc_executor,
+                                                         ESP_DDS_GROUP_REENTRANT);
+    ESP_DDS_DOMAIN_CREATE_SERVICE(&test_rpc_server, "/rpc/echo", test_rpc_echo, ESP_DDS_SYNC, NULL);
+    ESP_DDS_DOMAIN_SET_SERVICE_GROUP(&test_rpc_server, "/rpc/echo", group);
+    ESP_DDS_DOMAIN_SET_SERVICE_VISIBILITY(&test_rpc_server, "/rpc/echo", ESP_DDS_NETWORK_VISIBLE);
+    
+    // Round trips at 1, 8 and 32 calls in flight
+    static const uint8_t windows[] = {1, 8, 32};
+    uint32_t rate[3] = {0}, latency[3] = {0}, refused_calls[3] = {0};
+    for (int w = 0; opened && w < 3; w++) {
+        uint32_t issued;
+        rate[w] = test_rpc_run(windows[w], TEST_RPC_CALLS, &issued);
+        latency[w] = test_rpc.answered ? (uint32_t)(test_rpc.latency_us / test_rpc.answered) : 0;
+        refused_calls[w] = issued - test_rpc.answered;
+        if (test_rpc.answered != TEST_RPC_CALLS || test_rpc.wrong) test_results[32].failures++;
+    }
+    
+    // The window holds back the third call, a full work queue answers the rest at once
+    memset(&test_rpc, 0, sizeof(test_rpc));
+    ESP_DDS_DOMAIN_SET_REMOTE_WINDOW(&test_rpc_client, 2);
+    uint32_t index = 0;
+    bool first = ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/echo", index, test_rpc_answer,
+                                                   &test_rpc, 1000);
+    bool second = ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/echo", index, test_rpc_answer,
+                                                    &test_rpc, 1000);
+    bool third = ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/echo", index, test_rpc_answer,
+                                                   &test_rpc, 1000);
+    for (int i = 0; i < 20 && test_rpc.answered < 2; i++) {
+        test_rpc_pump(true);
+        DDS_DELAY(1);
+    }
+    bool windowed = first && second && !third && test_rpc.answered == 2;
+    
+    memset(&test_rpc, 0, sizeof(test_rpc));
+    ESP_DDS_DOMAIN_SET_REMOTE_WINDOW(&test_rpc_client, 32);
+    for (index = 0; index < 20; index++) {
+        ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/echo", index, test_rpc_answer, &test_rpc, 1000);
+    }
+    for (int i = 0; i < 20 && test_rpc_client.pending_count > ESP_DDS_MAX_QUEUED_WORK; i++) {
+        test_rpc_pump(false);
+        DDS_DELAY(1);
+    }
+    esp_dds_index_t refused = (esp_dds_index_t)(20 - test_rpc_client.pending_count);
+    for (int i = 0; i < 20 && test_rpc.answered < ESP_DDS_MAX_QUEUED_WORK; i++) {
+        test_rpc_pump(true);
+        DDS_DELAY(1);
+    }
+    bool busy = refused == 20 - ESP_DDS_MAX_QUEUED_WORK && test_rpc.answered == ESP_DDS_MAX_QUEUED_WORK;
+    
+    // A timeout of 0 is the default remote timeout, not an immediate expiry
+    memset(&test_rpc, 0, sizeof(test_rpc));
+    bool defaulted = ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/echo", index, test_rpc_answer,
+                                                       &test_rpc, 0);
+    for (int i = 0; i < 20 && !test_rpc.answered; i++) {
+        test_rpc_pump(true);
+        DDS_DELAY(1);
+    }
+    defaulted = defaulted && test_rpc.answered == 1;
+    
+    // Nobody serves /rpc/missing: async calls time out and free the window, sync ones return
+    ESP_DDS_DOMAIN_SET_REMOTE_WINDOW(&test_rpc_client, 4);
+    uint32_t called = 0;
+    for (index = 0; index < 6; index++) {
+        called += ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/missing", index, test_rpc_answer,
+                                                    &test_rpc, 20);
+    }
+    DDS_DELAY(25);
+    test_rpc_pump(false);
+    bool expired = called == 4 && test_rpc_client.pending_count == 0 &&
+                   ESP_DDS_DOMAIN_CALL_SERVICE_ASYNC(&test_rpc_client, "/rpc/missing", index, test_rpc_answer,
+                                                     &test_rpc, 20);
+    uint32_t reply = 0;
+    uint32_t sync_start = DDS_MILLIS();
+    bool sync_answered = ESP_DDS_DOMAIN_CALL_SERVICE_SYNC(&test_rpc_client, "/rpc/missing", index, reply, 30);
+    uint32_t sync_ms = DDS_MILLIS() - sync_start;
+    if (!opened || !windowed || !busy || !defaulted || !expired || sync_answered || sync_ms < 30 || sync_ms > 200) {
+        TEST_PRINT("  ❌ REMOTE FAIL: opened=%d, window=%d, busy=%d (%u refused), default timeout=%d, timeout=%d, "
+                  "sync %d after %lu ms\n", opened, windowed, busy, (unsigned)refused, defaulted, expired,
+                  sync_answered, (unsigned long)sync_ms);
+        test_passed = false;
+        test_results[32].failures++;
+    }
+    DDS_DELAY(25);
+    test_rpc_pump(false);
+    
+    // Round trip of one call
+    ESP_DDS_DOMAIN_SET_REMOTE_WINDOW(&test_rpc_client, 1);
+    for (int i = 0; opened && i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t begin = DDS_MICROS();
+        uint32_t issued;
+        test_rpc_run(1, 1, &issued);
+        uint32_t duration = DDS_MICROS() - begin;
+        if (test_rpc.answered != 1) test_results[32].failures++;
+        if (duration < test_results[32].min_time_us) test_results[32].min_time_us = duration;
+        if (duration > test_results[32].max_time_us) test_results[32].max_time_us = duration;
+        test_results[32].avg_time_us = (test_results[32].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    ESP_DDS_UDP_CLOSE(&test_writer_udp);
+    ESP_DDS_UDP_CLOSE(&test_reader_udp);
+    
+    if (test_results[32].failures && test_passed) {
+        TEST_PRINT("  ❌ REMOTE FAIL: %lu failures in the benchmark\n", (unsigned long)test_results[32].failures);
+        test_passed = false;
+    }
+    
+    if (test_passed) {
+        for (int w = 0; w < 3; w++) {
+            TEST_PRINT("  ✅ REMOTE PASS: %2u in flight, %lu calls/s, %lu us round trip, %lu refused busy\n",
+                      windows[w], (unsigned long)rate[w], (unsigned long)latency[w],
+                      (unsigned long)refused_calls[w]);
+        }
+        TEST_PRINTLN("  ✅ REMOTE PASS: Window holds back calls, busy server refuses, timeouts free the window");
+        test_results[32].passed = true;
+    }
+}
+#else
+void test_remote_services(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 33: Remote Services\n");
+    TEST_PRINTLN("  ✅ REMOTE PASS: Needs UDP loopback (host builds only)");
+    test_results[32].passed = true;
+}
+#endif
+
+// ===== TEST 34: REMOTE ACTIONS =====
+
+#ifdef DDS_HOST
+#define TEST_GOAL_FEEDBACK 50           // Feedback per execute step
+
+typedef struct {
+    uint32_t goals;                     // Goal callback calls
+    uint32_t feedback_sent;
+    uint32_t steps;
+} test_goal_server_t;
+
+typedef struct {
+    uint32_t feedback;
+    uint32_t last_feedback;
+    uint32_t results;
+    esp_dds_action_state_t state;
+    int32_t value;
+} test_goal_client_t;
+
+ESP_DDS_DOMAIN_DEFINE(test_goal_client, 4, 2, 4, 256);
+ESP_DDS_DOMAIN_DEFINE(test_goal_server, 4, 2, 2, 256);
+static test_goal_server_t test_goal_served;
+
+static bool test_goal_accept(const void* goal, size_t size, void* context) {
+    ((test_goal_server_t*)context)->goals++;
+    return *(const int32_t*)goal >= 0;
+}
+
+// Runs for as many steps as the goal asks, each flooding the client with feedback
+static esp_dds_action_state_t test_goal_execute(const void* goal, size_t goal_size, void* result,
+                                                size_t* result_size, void* context) {
+    test_goal_server_t* s = (test_goal_server_t*)context;
+    for (int i = 0; i < TEST_GOAL_FEEDBACK; i++) {
+        s->feedback_sent++;
+        ESP_DDS_DOMAIN_SEND_FEEDBACK(&test_goal_server, "/goal/move", s->feedback_sent);
+    }
+    int32_t steps = *(const int32_t*)goal;
+    memcpy(result, &steps, sizeof(steps));
+    *result_size = sizeof(steps);
+    if (ESP_DDS_DOMAIN_IS_GOAL_CANCELED(&test_goal_server, "/goal/move")) return ESP_DDS_ACTION_CANCELED;
+    return ++s->steps >= (uint32_t)steps ? ESP_DDS_ACTION_SUCCEEDED : ESP_DDS_ACTION_EXECUTING;
+}
+
+static void test_goal_feedback(const char* action, const void* feedback, size_t size, void* context) {
+    test_goal_client_t* c = (test_goal_client_t*)context;
+    c->feedback++;
+    memcpy(&c->last_feedback, feedback, sizeof(c->last_feedback));
+}
+
+static void test_goal_result(const char* action, const void* result, size_t size, esp_dds_action_state_t state,
+                             void* context) {
+    test_goal_client_t* c = (test_goal_client_t*)context;
+    c->results++;
+    c->state = state;
+    c->value = size == sizeof(int32_t) ? *(const int32_t*)result : -1;
+}
+
+// One round of both nodes, the server executes only when asked to
+static void test_goal_pump(bool execute) {
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_goal_server, 0);
+    if (execute) ESP_DDS_DOMAIN_PROCESS_ACTIONS(&test_goal_server);
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_goal_client, 0);
+    ESP_DDS_DOMAIN_PROCESS_PENDING(&test_goal_client, 0);
+}
+
+// Sends a goal and pumps until its result or a second passed
+static bool test_goal_run(test_goal_client_t* c, const char* action, int32_t goal, uint32_t timeout_ms) {
+    memset(c, 0, sizeof(*c));
+    test_goal_served.steps = 0;
+    if (!esp_dds_domain_send_goal(&test_goal_client, action, &goal, sizeof(goal), test_goal_feedback,
+                                  test_goal_result, c, timeout_ms)) {
+        return false;
+    }
+    uint32_t start = DDS_MILLIS();
+    while (!c->results && DDS_MILLIS() - start < 1000) test_goal_pump(true);
+    return c->results == 1;
+}
+
+void test_remote_actions(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 34: Remote Actions\n");
+    
+    bool test_passed = true;
+    ESP_DDS_DOMAIN_INIT(&test_goal_client);
+    ESP_DDS_DOMAIN_INIT(&test_goal_server);
+    memset(&test_goal_served, 0, sizeof(test_goal_served));
+    bool opened = ESP_DDS_DOMAIN_UDP_OPEN(&test_goal_server, &test_reader_udp, 0, NULL, 0) &&
+                  ESP_DDS_DOMAIN_UDP_OPEN(&test_goal_client, &test_writer_udp, 0, "127.0.0.1",
+                                          test_reader_udp.local_port);
+    ESP_DDS_DOMAIN_CREATE_ACTION(&test_goal_server, "/goal/move", test_goal_accept, test_goal_execute, NULL,
+                                 &test_goal_served);
+    ESP_DDS_DOMAIN_SET_ACTION_VISIBILITY(&test_goal_server, "/goal/move", ESP_DDS_NETWORK_VISIBLE);
+    
+    // Twenty steps of feedback floods: coalesced, the latest value and the result arrive
+    test_goal_client_t client;
+    bool succeeded = opened && test_goal_run(&client, "/goal/move", 20, 100) &&
+                     client.state == ESP_DDS_ACTION_SUCCEEDED && client.value == 20;
+    uint32_t flooded = test_goal_served.feedback_sent;
+    uint32_t delivered = client.feedback;
+    bool coalesced = delivered > 0 && delivered < flooded / 4 && client.last_feedback == flooded &&
+                     test_reader_udp.link.feedback_coalesced > 0;
+    
+    // The server rejects, nobody serves /goal/missing: both end as aborted
+    test_goal_client_t rejected_client, missing_client;
+    uint32_t missing_start = DDS_MILLIS();
+    bool rejected = opened && test_goal_run(&rejected_client, "/goal/move", -1, 100) &&
+                    rejected_client.state == ESP_DDS_ACTION_ABORTED;
+    bool missing = test_goal_run(&missing_client, "/goal/missing", 1, 40) &&
+                   missing_client.state == ESP_DDS_ACTION_ABORTED;
+    uint32_t missing_ms = DDS_MILLIS() - missing_start;
+    
+    // The server's answers get lost: the goal goes out again and is accepted only once
+    uint32_t goals = test_goal_served.goals;
+    memset(&client, 0, sizeof(client));
+    test_goal_served.steps = 0;
+    int32_t goal = 1;
+    ESP_DDS_UDP_SET_LOSS(&test_reader_udp, 1000, 7);
+    bool sent = ESP_DDS_DOMAIN_SEND_GOAL(&test_goal_client, "/goal/move", goal, test_goal_feedback,
+                                         test_goal_result, &client, 500);
+    for (uint32_t start = DDS_MILLIS(); DDS_MILLIS() - start < 5 * ESP_DDS_REMOTE_RETRY_MS;) test_goal_pump(false);
+    ESP_DDS_UDP_SET_LOSS(&test_reader_udp, 0, 0);
+    for (uint32_t start = DDS_MILLIS(); !client.results && DDS_MILLIS() - start < 1000;) test_goal_pump(true);
+    bool repeated = sent && client.results == 1 && client.state == ESP_DDS_ACTION_SUCCEEDED &&
+                    test_goal_served.goals == goals + 1 && test_reader_udp.datagrams_dropped >= 3;
+    
+    // Canceled in the middle of a feedback flood, the result is not held up
+    memset(&client, 0, sizeof(client));
+    test_goal_served.steps = 0;
+    goal = 1000000;
+    ESP_DDS_DOMAIN_SEND_GOAL(&test_goal_client, "/goal/move", goal, test_goal_feedback, test_goal_result,
+                             &client, 100);
+    while (client.feedback < 3 && test_goal_served.steps < 1000) test_goal_pump(true);
+    uint32_t cancel_start = DDS_MICROS();
+    bool canceling = ESP_DDS_DOMAIN_CANCEL_GOAL(&test_goal_client, "/goal/move", 100);
+    for (int i = 0; i < 1000 && !client.results; i++) test_goal_pump(true);
+    uint32_t cancel_us = DDS_MICROS() - cancel_start;
+    bool canceled = canceling && client.results == 1 && client.state == ESP_DDS_ACTION_CANCELED;
+    
+    if (!opened || !succeeded || !coalesced || !rejected || !missing || missing_ms > 300 || !repeated ||
+        !canceled || test_goal_client.pending_count != 0) {
+        TEST_PRINT("  ❌ ACTIONS FAIL: opened=%d, succeeded=%d, feedback %lu of %lu (coalesced=%d), rejected=%d, "
+                  "missing=%d after %lu ms, repeated=%d (%lu goals), canceled=%d, pending=%u\n",
+                  opened, succeeded, (unsigned long)delivered, (unsigned long)flooded, coalesced,
+                  rejected, missing, (unsigned long)missing_ms, repeated,
+                  (unsigned long)(test_goal_served.goals - goals), canceled,
+                  (unsigned)test_goal_client.pending_count);
+        test_passed = false;
+        test_results[33].failures++;
+    }
+    
+    // Goal to result of a one-step goal
+    for (int i = 0; opened && i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t begin = DDS_MICROS();
+        if (!test_goal_run(&client, "/goal/move", 1, 100) || client.state != ESP_DDS_ACTION_SUCCEEDED) {
+            test_results[33].failures++;
+        }
+        uint32_t duration = DDS_MICROS() - begin;
+        if (duration < test_results[33].min_time_us) test_results[33].min_time_us = duration;
+        if (duration > test_results[33].max_time_us) test_results[33].max_time_us = duration;
+        test_results[33].avg_time_us = (test_results[33].avg_time_us * i + duration) / (i + 1);
+    }
+    
+    ESP_DDS_UDP_CLOSE(&test_writer_udp);
+    ESP_DDS_UDP_CLOSE(&test_reader_udp);
+    
+    if (test_results[33].failures && test_passed) {
+        TEST_PRINT("  ❌ ACTIONS FAIL: %lu failures in the benchmark\n", (unsigned long)test_results[33].failures);
+        test_passed = false;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ ACTIONS PASS: %lu feedback sent, %lu delivered, latest value kept\n",
+                  (unsigned long)flooded, (unsigned long)delivered);
+        TEST_PRINT("  ✅ ACTIONS PASS: Cancel to result %lu us during a feedback flood\n", (unsigned long)cancel_us);
+        TEST_PRINTLN("  ✅ ACTIONS PASS: Lost accepts repeated, rejected and unanswered goals abort");
+        test_results[33].passed = true;
+    }
+}
+#else
+void test_remote_actions(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 34: Remote Actions\n");
+    TEST_PRINTLN("  ✅ ACTIONS PASS: Needs UDP loopback (host builds only)");
+    test_results[33].passed = true;
+}
+#endif
+
+// ===== TEST 35: CLOCK SYNC =====
+
+#ifdef DDS_HOST
+#define TEST_CLOCK_FRAMES 16
+#define TEST_CLOCK_DELAY_US 300         // One way, plus up to TEST_CLOCK_JITTER_US
+#define TEST_CLOCK_JITTER_US 100
+#define TEST_CLOCK_STEP_US 500
+#define TEST_CLOCK_DRIFT_PPM 150        // The second node's clock runs this much fast
+
+// Two links wired back to back, each reading its own clock off virtual time
+typedef struct test_clock_end_s test_clock_end_t;
+struct test_clock_end_s {
+    esp_dds_link_t link;
+    test_clock_end_t* peer;
+    uint32_t offset_us;
+    int32_t drift_ppm;
+    uint16_t queued;
+    uint64_t due_us[TEST_CLOCK_FRAMES];
+    uint16_t size[TEST_CLOCK_FRAMES];
+    uint8_t frames[TEST_CLOCK_FRAMES][ESP_DDS_LINK_MTU] __attribute__((aligned(4)));
+};
+
+ESP_DDS_DOMAIN_DEFINE(test_clock_a, 4, 1, 1, 128);
+ESP_DDS_DOMAIN_DEFINE(test_clock_b, 4, 1, 1, 128);
+static test_clock_end_t test_clock_ends[2];
+static uint64_t test_clock_now_us;
+static uint32_t test_clock_random = 1;
+
+static uint32_t test_clock_read(esp_dds_link_t* link) {
+    const test_clock_end_t* e = (const test_clock_end_t*)link;
+    return (uint32_t)(test_clock_now_us + (int64_t)test_clock_now_us * e->drift_ppm / 1000000 + e->offset_us);
+}
+
+static bool test_clock_write(esp_dds_link_t* link, const uint8_t* frame, size_t size) {
+    test_clock_end_t* to = ((test_clock_end_t*)link)->peer;
+    if (to->queued == TEST_CLOCK_FRAMES) return false;
+    test_clock_random ^= test_clock_random << 13;
+    test_clock_random ^= test_clock_random >> 17;
+    test_clock_random ^= test_clock_random << 5;
+    to->due_us[to->queued] = test_clock_now_us + TEST_CLOCK_DELAY_US + test_clock_random % (TEST_CLOCK_JITTER_US + 1);
+    to->size[to->queued] = (uint16_t)size;
+    memcpy(to->frames[to->queued++], frame, size);
+    return true;
+}
+
+// Frames arrive in send order once due
+static uint16_t test_clock_poll(esp_dds_link_t* link, uint32_t timeout_ms) {
+    test_clock_end_t* e = (test_clock_end_t*)link;
+    uint16_t handled = 0;
+    uint16_t taken = 0;
+    while (taken < e->queued && e->due_us[taken] <= test_clock_now_us) {
+        handled += esp_dds_link_input(link, e->frames[taken], e->size[taken]);
+        taken++;
+    }
+    e->queued -= taken;
+    memmove(e->due_us, &e->due_us[taken], e->queued * sizeof(e->due_us[0]));
+    memmove(e->size, &e->size[taken], e->queued * sizeof(e->size[0]));
+    memmove(e->frames, &e->frames[taken], e->queued * sizeof(e->frames[0]));
+    return handled;
+}
+
+static const esp_dds_link_port_t test_clock_port = { test_clock_write, test_clock_poll, test_clock_read };
+
+static void test_clock_sample(const char* topic, const void* data, size_t size, void* context) {
+    (*(uint32_t*)context)++;
+}
+
+// Publishes on the first node every step and lets both receive
+static void test_clock_run(uint32_t duration_us) {
+    for (uint32_t t = 0; t < duration_us; t += TEST_CLOCK_STEP_US) {
+        test_clock_now_us += TEST_CLOCK_STEP_US;
+        uint32_t sample = (uint32_t)test_clock_now_us;
+        ESP_DDS_DOMAIN_PUBLISH(&test_clock_a, "/clock/imu", sample);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_a, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_b, 0);
+    }
+}
+
+void test_clock_sync(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 35: Clock Sync\n");
+    
+    bool test_passed = true;
+    uint32_t received = 0;
+    ESP_DDS_DOMAIN_INIT(&test_clock_a);
+    ESP_DDS_DOMAIN_INIT(&test_clock_b);
+    memset(test_clock_ends, 0, sizeof(test_clock_ends));
+    test_clock_now_us = 0;
+    test_clock_ends[0].peer = &test_clock_ends[1];
+    test_clock_ends[1].peer = &test_clock_ends[0];
+    test_clock_ends[1].offset_us = 0xFFFF0000u;  // Wraps 65 ms in
+    test_clock_ends[1].drift_ppm = TEST_CLOCK_DRIFT_PPM;
+    esp_dds_link_t* a = &test_clock_ends[0].link;
+    esp_dds_link_t* b = &test_clock_ends[1].link;
+    esp_dds_link_init(a, &test_clock_port);
+    esp_dds_link_init(b, &test_clock_port);
+    ESP_DDS_DOMAIN_ATTACH_TRANSPORT(&test_clock_a, &a->base);
+    ESP_DDS_DOMAIN_ATTACH_TRANSPORT(&test_clock_b, &b->base);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_clock_a, "/clock/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_clock_b, "/clock/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_clock_b, "/clock/imu", test_clock_sample, &received);
+    ESP_DDS_LINK_SET_CLOCK_SYNC(a, 100000);
+    ESP_DDS_LINK_SET_CLOCK_SYNC(b, 100000);
+    
+    // Three seconds to learn offset and drift, then one to measure
+    test_clock_run(3000000);
+    esp_dds_link_latency_t latency;
+    ESP_DDS_LINK_GET_LATENCY(b, &latency, true);
+    test_clock_run(1000000);
+    ESP_DDS_LINK_GET_LATENCY(b, &latency, false);
+    
+    // Expected: half a step on average for the delivery, the link delay is inside the step
+    uint32_t local = 0;
+    bool translated = ESP_DDS_LINK_TO_LOCAL_TIME(b, test_clock_read(a), &local);
+    int32_t error_us = (int32_t)(local - test_clock_read(b));
+    int32_t drift_error = b->clock.drift_ppb + TEST_CLOCK_DRIFT_PPM * 1000;
+    uint32_t mean_us = latency.count ? (uint32_t)(latency.sum_us / latency.count) : 0;
+    uint32_t p99_us = esp_dds_link_latency_percentile(&latency, 99);
+    if (!translated || error_us < -50 || error_us > 50 || drift_error < -15000 || drift_error > 15000 ||
+        a->clock.drift_ppb < TEST_CLOCK_DRIFT_PPM * 850 || latency.count != 2000 || latency.early ||
+        mean_us < TEST_CLOCK_STEP_US - 50 || mean_us > TEST_CLOCK_STEP_US + 50 || p99_us > 1024) {
+        TEST_PRINT("  ❌ CLOCK FAIL: translated=%d, error %ld us, drift %ld / %ld ppb, %lu latencies "
+                  "(%lu early), mean %lu us, p99 %lu us\n", translated, (long)error_us, (long)b->clock.drift_ppb,
+                  (long)a->clock.drift_ppb, (unsigned long)latency.count, (unsigned long)latency.early,
+                  (unsigned long)mean_us, (unsigned long)p99_us);
+        test_passed = false;
+        test_results[34].failures++;
+    }
+    
+    // Translating a timestamp
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t begin = DDS_MICROS();
+        for (int n = 0; n < 1000; n++) ESP_DDS_LINK_TO_LOCAL_TIME(b, (uint32_t)n, &local);
+        uint32_t duration = DDS_MICROS() - begin;
+        if (duration < test_results[34].min_time_us) test_results[34].min_time_us = duration;
+        if (duration > test_results[34].max_time_us) test_results[34].max_time_us = duration;
+        test_results[34].avg_time_us = (test_results[34].avg_time_us * i + duration) / (i + 1);
+    }
+    esp_dds_detach_transport(&a->base);
+    esp_dds_detach_transport(&b->base);
+    
+    // Real clocks over UDP loopback: the histogram a host would read off a board
+    ESP_DDS_DOMAIN_INIT(&test_clock_a);
+    ESP_DDS_DOMAIN_INIT(&test_clock_b);
+    bool opened = ESP_DDS_DOMAIN_UDP_OPEN(&test_clock_b, &test_reader_udp, 0, NULL, 0) &&
+                  ESP_DDS_DOMAIN_UDP_OPEN(&test_clock_a, &test_writer_udp, 0, "127.0.0.1",
+                                          test_reader_udp.local_port);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_clock_a, "/clock/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_clock_b, "/clock/imu", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_clock_b, "/clock/imu", test_clock_sample, &received);
+    ESP_DDS_LINK_SET_CLOCK_SYNC(&test_writer_udp.link, 5000);
+    ESP_DDS_LINK_SET_CLOCK_SYNC(&test_reader_udp.link, 5000);
+    for (uint32_t start = DDS_MILLIS(); opened && DDS_MILLIS() - start < 50;) {
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_a, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_b, 0);
+    }
+    esp_dds_link_latency_t udp;
+    ESP_DDS_LINK_GET_LATENCY(&test_reader_udp.link, &udp, true);
+    for (uint32_t n = 0; opened && n < 2000; n++) {
+        ESP_DDS_DOMAIN_PUBLISH(&test_clock_a, "/clock/imu", n);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_a, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_b, 0);
+    }
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_b, 10);
+    ESP_DDS_LINK_GET_LATENCY(&test_reader_udp.link, &udp, false);
+    int32_t udp_offset = (int32_t)test_reader_udp.link.clock.offset_us;  // Same clock on both ends
+    bool synced = test_reader_udp.link.clock.synced && test_writer_udp.link.clock.synced &&
+                  udp_offset > -50 && udp_offset < 50;
+    ESP_DDS_UDP_CLOSE(&test_writer_udp);
+    ESP_DDS_UDP_CLOSE(&test_reader_udp);
+    if (!opened || !synced || udp.count < 1900) {
+        TEST_PRINT("  ❌ CLOCK FAIL: UDP opened=%d, synced=%d (offset %ld us), %lu latencies\n", opened, synced,
+                  (long)udp_offset, (unsigned long)udp.count);
+        test_passed = false;
+        test_results[34].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ CLOCK PASS: Offset across the wrap within %ld us, drift %ld ppb for %d ppm, "
+                  "mean latency %lu us (%d expected)\n", (long)error_us, (long)b->clock.drift_ppb,
+                  -TEST_CLOCK_DRIFT_PPM, (unsigned long)mean_us, TEST_CLOCK_STEP_US);
+        TEST_PRINT("  ✅ CLOCK PASS: UDP loopback latency p50 %lu us, p99 %lu us, max %lu us over %lu samples (%lu early)\n",
+                  (unsigned long)esp_dds_link_latency_percentile(&udp, 50),
+                  (unsigned long)esp_dds_link_latency_percentile(&udp, 99), (unsigned long)udp.max_us,
+                  (unsigned long)udp.count, (unsigned long)udp.early);
+        test_results[34].passed = true;
+    }
+}
+#else
+void test_clock_sync(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 35: Clock Sync\n");
+    TEST_PRINTLN("  ✅ CLOCK PASS: Needs UDP loopback (host builds only)");
+    test_results[34].passed = true;
+}
+#endif
+
+// ===== TEST 36: TYPED MESSAGES =====
+
+#define TEST_TYPED_ROUNDS 10000
+
+static uint32_t test_typed_received;
+static imu_t test_typed_last;
+
+static void test_typed_imu(const char* topic, const imu_t& imu, void* context) {
+    test_typed_last = imu;
+    (*(uint32_t*)context)++;
+}
+
+static void test_typed_status(const char* topic, const status_t& status, void* context) {
+    (*(uint32_t*)context)++;
+}
+
+static void test_typed_fill(status_t* s) {
+    memset(s, 0, sizeof(*s));
+    s->level = STATUS_LEVEL_WARN;
+    s->charging = true;
+    s->uptime_ms = 0x12345678;
+    s->battery_v = 3.7f;
+    s->imu.stamp_us = 0x0102030405060708ULL;
+    s->imu.accel[2] = -9.81f;
+    s->imu.gyro[0] = 0.5f;
+    strcpy(s->name, "motor_left");
+    s->temperatures_count = 3;
+    s->temperatures[0] = -40;
+    s->temperatures[1] = 25;
+    s->temperatures[2] = 85;
+}
+
+// Best of TEST_TIMING_SAMPLES runs, ns per call; the sink keeps the work from being optimized out
+#define TEST_TYPED_BENCH(ns, statement) do { \
+    uint32_t best = UINT32_MAX; \
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) { \
+        uint32_t begin = DDS_MICROS(); \
+        for (uint32_t n = 0; n < TEST_TYPED_ROUNDS; n++) { statement; } \
+        uint32_t duration = DDS_MICROS() - begin; \
+        if (duration < best) best = duration; \
+        if (duration < test_results[35].min_time_us) test_results[35].min_time_us = duration; \
+        if (duration > test_results[35].max_time_us) test_results[35].max_time_us = duration; \
+    } \
+    ns = (uint32_t)((uint64_t)best * 1000 / TEST_TYPED_ROUNDS); \
+} while (0)
+
+void test_typed_messages(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 36: Typed Messages\n");
+    
+    bool test_passed = true;
+    status_t status, back;
+    uint8_t wire[STATUS_WIRE_SIZE + 8] __attribute__((aligned(8)));
+    test_typed_fill(&status);
+    
+    // Little-endian, unpadded, counted; 42 fixed bytes + 2 + 10 name + 2 + 3 temperatures
+    size_t size = status_serialize(&status, wire);
+    memset(&back, 0x55, sizeof(back));
+    bool round_trip = size == 42 + 2 + 10 + 2 + 6 && status_deserialize(&back, wire, size) &&
+                      back.level == status.level && back.charging && back.uptime_ms == status.uptime_ms &&
+                      back.battery_v == status.battery_v && memcmp(&back.imu, &status.imu, sizeof(imu_t)) == 0 &&
+                      strcmp(back.name, status.name) == 0 && back.temperatures_count == 3 &&
+                      back.temperatures[0] == -40 && back.temperatures[2] == 85;
+    bool layout = wire[0] == STATUS_LEVEL_WARN && wire[1] == 1 && wire[2] == 0x78 && wire[5] == 0x12 &&
+                  wire[10] == 0x08 && wire[17] == 0x01 && wire[42] == 10 && wire[43] == 0 &&
+                  memcmp(&wire[44], "motor_left", 10) == 0 && wire[54] == 3 && wire[56] == 0xD8 && wire[57] == 0xFF;
+    
+    // Everything short or over a bound is refused
+    bool refused = !status_deserialize(&back, wire, size - 1) && !status_deserialize(&back, wire, 41) &&
+                   !status_deserialize(&back, wire, size + 1) && !imu_deserialize(&back.imu, wire, IMU_WIRE_SIZE - 1);
+    wire[54] = 9;
+    refused = refused && !status_deserialize(&back, wire, size);
+    wire[54] = 3;
+    wire[42] = 24;
+    refused = refused && !status_deserialize(&back, wire, size);
+    wire[42] = 10;
+    
+    // The IMU struct is its own wire form here, so the fast path must agree with the field by field one
+    uint8_t fields[IMU_WIRE_SIZE];
+    imu_put(&status.imu, fields);
+    bool dense = IMU_DENSE && imu_serialize(&status.imu, wire) == IMU_WIRE_SIZE &&
+                 memcmp(wire, fields, IMU_WIRE_SIZE) == 0 && !STATUS_FIXED;
+    if (!round_trip || !layout || !refused || !dense) {
+        TEST_PRINT("  ❌ TYPED FAIL: round_trip=%d, layout=%d, refused=%d, dense=%d (%lu bytes)\n",
+                  round_trip, layout, refused, dense, (unsigned long)size);
+        test_passed = false;
+        test_results[35].failures++;
+    }
+    
+    // Typed topics: the first typed use binds the type, a different one is refused either way
+    uint32_t imu_count = 0;
+    uint32_t wrong_count = 0;
+    test_typed_received = 0;
+    bool subscribed = ESP_DDS_SUBSCRIBE_TYPED("/typed/imu", imu_t, test_typed_imu, &imu_count);
+    bool published = ESP_DDS_PUBLISH_TYPED("/typed/imu", status.imu);
+    bool mismatch = !ESP_DDS_SUBSCRIBE_TYPED("/typed/imu", status_t, test_typed_status, &wrong_count) &&
+                    !ESP_DDS_PUBLISH_TYPED("/typed/imu", status) &&
+                    !esp_dds_publish_typed(ESP_DDS_NAME("/typed/imu"), 0, &status.imu, sizeof(imu_t));
+    uint8_t runt[IMU_WIRE_SIZE - 4] = {0};
+    ESP_DDS_PUBLISH("/typed/imu", runt);  // Untyped, dropped by the deserializer
+    bool variable = ESP_DDS_SUBSCRIBE_TYPED("/typed/status", status_t, test_typed_status, &test_typed_received) &&
+                    ESP_DDS_PUBLISH_TYPED("/typed/status", status);
+    if (!subscribed || !published || !mismatch || !variable || imu_count != 1 || wrong_count != 0 ||
+        test_typed_received != 1 || memcmp(&test_typed_last, &status.imu, sizeof(imu_t)) != 0) {
+        TEST_PRINT("  ❌ TYPED FAIL: subscribed=%d, published=%d, mismatch refused=%d, variable=%d, "
+                  "%lu/%lu/%lu delivered (1/0/1)\n", subscribed, published, mismatch, variable,
+                  (unsigned long)imu_count, (unsigned long)wrong_count, (unsigned long)test_typed_received);
+        test_passed = false;
+        test_results[35].failures++;
+    }
+    ESP_DDS_UNSUBSCRIBE_TYPED("/typed/imu", imu_t, test_typed_imu);
+    
+    // Cost per message against copying the struct
+    volatile uint8_t sink = 0;
+    imu_t imu = status.imu;
+    uint32_t memcpy_ns, imu_out_ns, imu_in_ns, imu_fields_ns, status_out_ns, status_in_ns;
+    TEST_TYPED_BENCH(memcpy_ns, imu.stamp_us = n; memcpy(wire, &imu, sizeof(imu)); sink = sink + wire[n % IMU_WIRE_SIZE]);
+    TEST_TYPED_BENCH(imu_out_ns, imu.stamp_us = n; imu_serialize(&imu, wire); sink = sink + wire[n % IMU_WIRE_SIZE]);
+    TEST_TYPED_BENCH(imu_in_ns, wire[0] = (uint8_t)n; imu_deserialize(&imu, wire, IMU_WIRE_SIZE);
+                     sink = sink + ((const uint8_t*)&imu)[n % sizeof(imu)]);
+    TEST_TYPED_BENCH(imu_fields_ns, imu.stamp_us = n; imu_put(&imu, wire); sink = sink + wire[n % IMU_WIRE_SIZE]);
+    TEST_TYPED_BENCH(status_out_ns, status.uptime_ms = n; size = status_serialize(&status, wire);
+                     sink = sink + wire[n % size]);
+    TEST_TYPED_BENCH(status_in_ns, wire[2] = (uint8_t)n; status_deserialize(&back, wire, size);
+                     sink = sink + ((const uint8_t*)&back)[n % sizeof(back)]);
+    (void)sink;
+    
+    if (test_passed) {
+        test_results[35].avg_time_us = (status_out_ns + status_in_ns) / 1000;
+        TEST_PRINT("  ✅ TYPED PASS: Wire format, bounds and type hashes checked (imu 0x%08lX, status 0x%08lX)\n",
+                  (unsigned long)IMU_TYPE_HASH, (unsigned long)STATUS_TYPE_HASH);
+        TEST_PRINT("  ✅ TYPED PASS: %d byte IMU - memcpy %lu ns, serialize %lu ns, deserialize %lu ns, "
+                  "field by field %lu ns\n", IMU_WIRE_SIZE, (unsigned long)memcpy_ns, (unsigned long)imu_out_ns,
+                  (unsigned long)imu_in_ns, (unsigned long)imu_fields_ns);
+        TEST_PRINT("  ✅ TYPED PASS: %lu byte status - serialize %lu ns, deserialize %lu ns\n",
+                  (unsigned long)size, (unsigned long)status_out_ns, (unsigned long)status_in_ns);
+        test_results[35].passed = true;
+    }
+}
+
+// ===== TEST 37: DELTA COMPRESSION =====
+
+#ifdef DDS_HOST
+#define TEST_DELTA_SAMPLES 2000
+#define TEST_DELTA_KEYFRAMES 100        // Samples per keyframe
+#define TEST_DELTA_BURST 500            // Publishes per timing sample
+
+// Telemetry as it tends to look: a counter, a few slow readings and a static table
+typedef struct {
+    uint32_t sequence;
+    uint32_t uptime_ms;
+    int16_t temperature_c10;
+    uint16_t faults;
+    float battery_v;
+    float calibration[24];
+    char name[16];
+} test_status_t;
+
+typedef struct {
+    uint32_t delivered;
+    uint32_t corrupt;                   // Did not match what was published
+} test_delta_reader_t;
+
+static test_delta_reader_t test_delta_received;
+
+static void test_delta_fill(test_status_t* s, uint32_t n) {
+    memset(s, 0, sizeof(*s));
+    s->sequence = n;
+    s->uptime_ms = n * 10;
+    s->temperature_c10 = (int16_t)(250 + (n / 100) % 7);
+    s->faults = (uint16_t)((n / 500) & 1);
+    s->battery_v = 4.2f - (float)(n / 50) * 0.001f;
+    for (int k = 0; k < 24; k++) s->calibration[k] = 1.0f + k * 0.125f;
+    strcpy(s->name, "left_drive");
+}
+
+static void test_delta_sample(const char* topic, const void* data, size_t size, void* context) {
+    test_status_t sample, expected;
+    if (size != sizeof(sample)) {
+        test_delta_received.corrupt++;
+        return;
+    }
+    memcpy(&sample, data, size);
+    test_delta_fill(&expected, sample.sequence);
+    if (memcmp(&sample, &expected, size) == 0) {
+        test_delta_received.delivered++;
+    } else {
+        test_delta_received.corrupt++;
+    }
+}
+
+// Streams the status over UDP loopback, returns the bytes the writer put on the wire
+static uint32_t test_delta_stream(uint16_t keyframe_every, uint16_t loss_permille, uint32_t* deltas) {
+    memset(&test_delta_received, 0, sizeof(test_delta_received));
+    ESP_DDS_DOMAIN_INIT(&test_udp_writer);
+    ESP_DDS_DOMAIN_INIT(&test_udp_reader);
+    bool opened = ESP_DDS_DOMAIN_UDP_OPEN(&test_udp_reader, &test_reader_udp, 0, NULL, 0) &&
+                  ESP_DDS_DOMAIN_UDP_OPEN(&test_udp_writer, &test_writer_udp, 0, "127.0.0.1",
+                                          test_reader_udp.local_port);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_writer, "/delta/status", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_udp_reader, "/delta/status", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_udp_reader, "/delta/status", test_delta_sample, NULL);
+    if (keyframe_every) ESP_DDS_LINK_SET_DELTA(&test_writer_udp.link, "/delta/status", keyframe_every);
+    ESP_DDS_UDP_SET_LOSS(&test_writer_udp, loss_permille, 7);
+    ESP_DDS_UDP_SET_LOSS(&test_reader_udp, loss_permille, 11);
+    
+    test_status_t status;
+    for (uint32_t n = 0; opened && n < TEST_DELTA_SAMPLES; n++) {
+        test_delta_fill(&status, n);
+        ESP_DDS_DOMAIN_PUBLISH(&test_udp_writer, "/delta/status", status);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 0);
+        ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_writer, 0);
+    }
+    ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_udp_reader, 10);
+    uint32_t bytes = opened ? test_writer_udp.bytes_sent : 0;
+    *deltas = test_writer_udp.link.deltas_sent;
+    ESP_DDS_UDP_CLOSE(&test_writer_udp);
+    ESP_DDS_UDP_CLOSE(&test_reader_udp);
+    return bytes;
+}
+
+// Nanoseconds per publish over the back to back links, nothing but the frame layer below
+static uint32_t test_delta_cost(uint16_t keyframe_every) {
+    ESP_DDS_DOMAIN_INIT(&test_clock_a);
+    ESP_DDS_DOMAIN_INIT(&test_clock_b);
+    memset(test_clock_ends, 0, sizeof(test_clock_ends));
+    test_clock_ends[0].peer = &test_clock_ends[1];
+    test_clock_ends[1].peer = &test_clock_ends[0];
+    esp_dds_link_t* a = &test_clock_ends[0].link;
+    esp_dds_link_t* b = &test_clock_ends[1].link;
+    esp_dds_link_init(a, &test_clock_port);
+    esp_dds_link_init(b, &test_clock_port);
+    ESP_DDS_DOMAIN_ATTACH_TRANSPORT(&test_clock_a, &a->base);
+    ESP_DDS_DOMAIN_ATTACH_TRANSPORT(&test_clock_b, &b->base);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_clock_a, "/delta/status", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SET_TOPIC_VISIBILITY(&test_clock_b, "/delta/status", ESP_DDS_NETWORK_VISIBLE);
+    ESP_DDS_DOMAIN_SUBSCRIBE(&test_clock_b, "/delta/status", test_delta_sample, NULL);
+    if (keyframe_every) ESP_DDS_LINK_SET_DELTA(a, "/delta/status", keyframe_every);
+    
+    uint32_t best = UINT32_MAX;
+    test_status_t status;
+    for (int i = 0; i < TEST_TIMING_SAMPLES; i++) {
+        uint32_t spent = 0;
+        for (uint32_t n = 0; n < TEST_DELTA_BURST; n++) {
+            test_delta_fill(&status, i * TEST_DELTA_BURST + n);
+            uint32_t begin = DDS_MICROS();
+            ESP_DDS_DOMAIN_PUBLISH(&test_clock_a, "/delta/status", status);
+            spent += DDS_MICROS() - begin;
+            test_clock_now_us += TEST_CLOCK_STEP_US;
+            ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_b, 0);
+            ESP_DDS_DOMAIN_PROCESS_TRANSPORTS(&test_clock_a, 0);
+        }
+        if (spent < best) best = spent;
+        if (keyframe_every) {
+            if (spent < test_results[36].min_time_us) test_results[36].min_time_us = spent;
+            if (spent > test_results[36].max_time_us) test_results[36].max_time_us = spent;
+            test_results[36].avg_time_us = (test_results[36].avg_time_us * i + spent) / (i + 1);
+        }
+    }
+    esp_dds_detach_transport(&a->base);
+    esp_dds_detach_transport(&b->base);
+    return (uint32_t)((uint64_t)best * 1000 / TEST_DELTA_BURST);
+}
+
+void test_delta_compression(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 37: Delta Compression\n");
+    
+    bool test_passed = true;
+    uint32_t deltas = 0;
+    uint32_t plain_bytes = test_delta_stream(0, 0, &deltas);
+    bool plain_ok = test_delta_received.delivered == TEST_DELTA_SAMPLES && !test_delta_received.corrupt;
+    uint32_t delta_bytes = test_delta_stream(TEST_DELTA_KEYFRAMES, 0, &deltas);
+    bool delta_ok = test_delta_received.delivered == TEST_DELTA_SAMPLES && !test_delta_received.corrupt &&
+                    deltas > TEST_DELTA_SAMPLES * 9 / 10 && delta_bytes * 3 < plain_bytes;
+    uint32_t delta_deltas = deltas;
+    if (!plain_ok || !delta_ok) {
+        TEST_PRINT("  ❌ DELTA FAIL: plain=%d, delta=%d (%lu delivered, %lu corrupt, %lu deltas), %lu vs %lu bytes\n",
+                  plain_ok, delta_ok, (unsigned long)test_delta_received.delivered,
+                  (unsigned long)test_delta_received.corrupt, (unsigned long)deltas,
+                  (unsigned long)delta_bytes, (unsigned long)plain_bytes);
+        test_passed = false;
+        test_results[36].failures++;
+    }
+    
+    // Lost keyframes and keyacks cost samples, never a wrong one
+    test_delta_stream(TEST_DELTA_KEYFRAMES / 4, 100, &deltas);
+    uint32_t lossy_delivered = test_delta_received.delivered;
+    if (test_delta_received.corrupt || lossy_delivered < TEST_DELTA_SAMPLES * 8 / 10 || deltas < TEST_DELTA_SAMPLES / 2) {
+        TEST_PRINT("  ❌ DELTA FAIL: 10%% loss - %lu delivered, %lu corrupt, %lu deltas\n",
+                  (unsigned long)lossy_delivered, (unsigned long)test_delta_received.corrupt,
+                  (unsigned long)deltas);
+        test_passed = false;
+        test_results[36].failures++;
+    }
+    
+    memset(&test_delta_received, 0, sizeof(test_delta_received));
+    uint32_t plain_ns = test_delta_cost(0);
+    uint32_t delta_ns = test_delta_cost(TEST_DELTA_KEYFRAMES);
+    if (test_delta_received.corrupt) {
+        TEST_PRINT("  ❌ DELTA FAIL: %lu corrupt samples over the direct link\n",
+                  (unsigned long)test_delta_received.corrupt);
+        test_passed = false;
+        test_results[36].failures++;
+    }
+    
+    if (test_passed) {
+        TEST_PRINT("  ✅ DELTA PASS: %d %d-byte status samples, %lu bytes on the wire plain, %lu with deltas "
+                  "(%lu deltas, %lu bytes per sample)\n", TEST_DELTA_SAMPLES, (int)sizeof(test_status_t),
+                  (unsigned long)plain_bytes, (unsigned long)delta_bytes, (unsigned long)delta_deltas,
+                  (unsigned long)(delta_bytes / TEST_DELTA_SAMPLES));
+        TEST_PRINT("  ✅ DELTA PASS: 10%% loss both ways, %lu of %d delivered, none corrupt\n",
+                  (unsigned long)lossy_delivered, TEST_DELTA_SAMPLES);
+        TEST_PRINT("  ✅ DELTA PASS: Publish %lu ns plain, %lu ns with deltas\n",
+                  (unsigned long)plain_ns, (unsigned long)delta_ns);
+        test_results[36].passed = true;
+    }
+}
+#else
+void test_delta_compression(void) {
+    esp_dds_test_cleanup();
+    TEST_PRINT("\n🧪 TEST 37: Delta Compression\n");
+    TEST_PRINTLN("  ✅ DELTA PASS: Needs UDP loopback (host builds only)");
+    test_results[36].passed = true;
+}
+#endif
+
 // ===== MAIN TEST RUNNER =====
 
 void esp_dds_run_comprehensive_test(void) {
@@ -865,6 +4279,81 @@ void esp_dds_run_comprehensive_test(void) {
     test_callback_context();
     DDS_DELAY(100);
     
+    test_qos_monitoring();
+    DDS_DELAY(100);
+    
+    test_content_filters();
+    DDS_DELAY(100);
+    
+    test_rate_limits();
+    DDS_DELAY(100);
+    
+    test_wildcard_subscriptions();
+    DDS_DELAY(100);
+    
+    test_name_hashing();
+    DDS_DELAY(100);
+    
+    test_name_arena();
+    DDS_DELAY(100);
+    
+    test_publish_benchmark();
+    DDS_DELAY(100);
+    
+    test_entity_removal();
+    DDS_DELAY(100);
+    
+    test_multiple_domains();
+    DDS_DELAY(100);
+    
+    test_sized_context();
+    DDS_DELAY(100);
+    
+    test_executors();
+    DDS_DELAY(100);
+    
+    test_timers();
+    DDS_DELAY(100);
+    
+    test_waitset();
+    DDS_DELAY(100);
+    
+    test_batch_publish();
+    DDS_DELAY(100);
+    
+    test_keyed_topics();
+    DDS_DELAY(100);
+    
+    test_shm_transport();
+    DDS_DELAY(100);
+    
+    test_uart_transport();
+    DDS_DELAY(100);
+    
+    test_sim_network();
+    DDS_DELAY(100);
+    
+    test_reliable_delivery();
+    DDS_DELAY(100);
+    
+    test_large_samples();
+    DDS_DELAY(100);
+    
+    test_remote_services();
+    DDS_DELAY(100);
+    
+    test_remote_actions();
+    DDS_DELAY(100);
+    
+    test_clock_sync();
+    DDS_DELAY(100);
+    
+    test_typed_messages();
+    DDS_DELAY(100);
+    
+    test_delta_compression();
+    DDS_DELAY(100);
+    
     // Calculate results
     total_failures = 0;
     int passed_tests = 0;
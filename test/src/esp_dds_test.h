@@ -2,6 +2,11 @@
 #define ESP_DDS_TEST_H
 
 #include "esp_dds.h"
+#include "esp_dds_context.h"
+#include "esp_dds_shm.h"
+#include "esp_dds_sim.h"
+#include "esp_dds_uart.h"
+#include "esp_dds_udp.h"
 #include "dds_platform.h"
 #include <stdio.h>
 
@@ -9,6 +14,7 @@
 #define TEST_TOTAL_CYCLES 100
 #define TEST_STRESS_ITERATIONS 3
 #define TEST_TIMING_SAMPLES 5
+#define TEST_BENCH_PUBLISHES 1000
 
 // Test result structure
 typedef struct {
@@ -41,6 +47,11 @@ typedef struct {
     uint32_t timestamp;
 } test_message_t;
 
+typedef struct {
+    uint8_t state;
+    int32_t value;
+} status_message_t;
+
 typedef struct {
     int32_t a;
     int32_t b;
@@ -97,6 +108,31 @@ void test_concurrent_actions(void);
 void test_action_cancellation(void);
 void test_deadlock_scenarios(void);
 void test_callback_context(void);
+void test_qos_monitoring(void);
+void test_content_filters(void);
+void test_rate_limits(void);
+void test_wildcard_subscriptions(void);
+void test_name_hashing(void);
+void test_name_arena(void);
+void test_publish_benchmark(void);
+void test_entity_removal(void);
+void test_multiple_domains(void);
+void test_sized_context(void);
+void test_executors(void);
+void test_timers(void);
+void test_waitset(void);
+void test_batch_publish(void);
+void test_keyed_topics(void);
+void test_shm_transport(void);
+void test_uart_transport(void);
+void test_sim_network(void);
+void test_reliable_delivery(void);
+void test_large_samples(void);
+void test_remote_services(void);
+void test_remote_actions(void);
+void test_clock_sync(void);
+void test_typed_messages(void);
+void test_delta_compression(void);
 
 // Test callbacks
 void test_topic_callback(const char* topic, const void* data, size_t size, void* context);
@@ -0,0 +1,71 @@
+// Generated by tools/esp_dds_gen.py from Imu.msg, do not edit
+#ifndef IMU_MSG_H
+#define IMU_MSG_H
+
+#include "esp_dds_msg.h"
+
+#define IMU_TYPE_HASH 0x3B070478UL
+#define IMU_WIRE_SIZE 32
+#define IMU_FIXED 1
+
+typedef struct {
+    uint64_t stamp_us;
+    float accel[3];
+    float gyro[3];
+} imu_t;
+
+// Struct layout equals the wire layout, serializing is a memcpy
+#define IMU_DENSE (ESP_DDS_WIRE_NATIVE && \
+    sizeof(imu_t) == IMU_WIRE_SIZE && \
+    offsetof(imu_t, stamp_us) == 0 && \
+    offsetof(imu_t, accel) == 8 && \
+    offsetof(imu_t, gyro) == 20)
+
+static inline uint8_t* imu_put(const imu_t* m, uint8_t* p) {
+    esp_dds_put_u64(p + 0, (uint64_t)m->stamp_us);
+    for (uint16_t i = 0; i < 3; i++) esp_dds_put_f32(p + 8 + i * 4, m->accel[i]);
+    for (uint16_t i = 0; i < 3; i++) esp_dds_put_f32(p + 20 + i * 4, m->gyro[i]);
+    p += 32;
+    return p;
+}
+
+// NULL when the input is short or a count is over its bound
+static inline const uint8_t* imu_take(imu_t* m, const uint8_t* p, const uint8_t* end) {
+    if (end - p < 32) return NULL;
+    m->stamp_us = esp_dds_get_u64(p + 0);
+    for (uint16_t i = 0; i < 3; i++) m->accel[i] = esp_dds_get_f32(p + 8 + i * 4);
+    for (uint16_t i = 0; i < 3; i++) m->gyro[i] = esp_dds_get_f32(p + 20 + i * 4);
+    p += 32;
+    return p;
+}
+
+// Returns the wire size, out holds at least IMU_WIRE_SIZE bytes
+static inline size_t imu_serialize(const imu_t* m, uint8_t* out) {
+    if (IMU_DENSE) {
+        memcpy(out, m, IMU_WIRE_SIZE);
+        return IMU_WIRE_SIZE;
+    }
+    return (size_t)(imu_put(m, out) - out);
+}
+
+static inline bool imu_deserialize(imu_t* m, const uint8_t* in, size_t size) {
+    if (size != IMU_WIRE_SIZE) return false;
+    if (IMU_DENSE) {
+        memcpy(m, in, IMU_WIRE_SIZE);
+        return true;
+    }
+    return imu_take(m, in, in + size) == in + size;
+}
+
+#ifdef __cplusplus
+namespace esp_dds {
+template <> struct MessageTraits<imu_t> {
+    static constexpr uint32_t type_hash = IMU_TYPE_HASH;
+    static constexpr size_t max_wire_size = IMU_WIRE_SIZE;
+    static size_t serialize(const imu_t* m, uint8_t* out) { return imu_serialize(m, out); }
+    static bool deserialize(imu_t* m, const uint8_t* in, size_t size) { return imu_deserialize(m, in, size); }
+};
+} // namespace esp_dds
+#endif
+
+#endif // IMU_MSG_H
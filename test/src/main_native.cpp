@@ -0,0 +1,9 @@
+#include "esp_dds.h"
+#include "esp_dds_test.h"
+
+// Host entry point (pio run -e native) - one test cycle, exit code for scripts
+int main(void) {
+    ESP_DDS_INIT();
+    esp_dds_run_comprehensive_test();
+    return total_failures ? 1 : 0;
+}
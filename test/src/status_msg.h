@@ -0,0 +1,91 @@
+// Generated by tools/esp_dds_gen.py from Status.msg, do not edit
+#ifndef STATUS_MSG_H
+#define STATUS_MSG_H
+
+#include "esp_dds_msg.h"
+#include "imu_msg.h"
+
+#define STATUS_TYPE_HASH 0xF7281637UL
+#define STATUS_WIRE_SIZE 85           // Largest sample
+#define STATUS_FIXED 0
+#define STATUS_LEVEL_OK 0
+#define STATUS_LEVEL_WARN 1
+#define STATUS_LEVEL_ERROR 2
+#define STATUS_BATTERY_LOW_V 3.3
+
+typedef struct {
+    uint8_t level;
+    bool charging;
+    uint32_t uptime_ms;
+    float battery_v;
+    imu_t imu;
+    char name[24];
+    uint16_t temperatures_count;
+    int16_t temperatures[8];
+} status_t;
+
+static inline uint8_t* status_put(const status_t* m, uint8_t* p) {
+    esp_dds_put_u8(p + 0, (uint8_t)m->level);
+    esp_dds_put_u8(p + 1, (uint8_t)m->charging);
+    esp_dds_put_u32(p + 2, (uint32_t)m->uptime_ms);
+    esp_dds_put_f32(p + 6, m->battery_v);
+    imu_put(&m->imu, p + 10);
+    p += 42;
+    uint16_t name_length = (uint16_t)strnlen(m->name, 23);
+    esp_dds_put_u16(p, name_length);
+    memcpy(p + 2, m->name, name_length);
+    p += 2 + name_length;
+    uint16_t temperatures_count = m->temperatures_count < 8 ? m->temperatures_count : 8;
+    esp_dds_put_u16(p, temperatures_count);
+    p += 2;
+    for (uint16_t i = 0; i < temperatures_count; i++) esp_dds_put_u16(p + i * 2, (uint16_t)m->temperatures[i]);
+    p += temperatures_count * 2;
+    return p;
+}
+
+// NULL when the input is short or a count is over its bound
+static inline const uint8_t* status_take(status_t* m, const uint8_t* p, const uint8_t* end) {
+    if (end - p < 42) return NULL;
+    m->level = esp_dds_get_u8(p + 0);
+    m->charging = esp_dds_get_u8(p + 1) != 0;
+    m->uptime_ms = esp_dds_get_u32(p + 2);
+    m->battery_v = esp_dds_get_f32(p + 6);
+    imu_take(&m->imu, p + 10, p + 10 + 32);
+    p += 42;
+    if (end - p < 2) return NULL;
+    uint16_t name_length = esp_dds_get_u16(p);
+    p += 2;
+    if (name_length > 23 || end - p < name_length) return NULL;
+    memcpy(m->name, p, name_length);
+    m->name[name_length] = '\0';
+    p += name_length;
+    if (end - p < 2) return NULL;
+    m->temperatures_count = esp_dds_get_u16(p);
+    p += 2;
+    if (m->temperatures_count > 8 || end - p < m->temperatures_count * 2) return NULL;
+    for (uint16_t i = 0; i < m->temperatures_count; i++) m->temperatures[i] = (int16_t)esp_dds_get_u16(p + i * 2);
+    p += m->temperatures_count * 2;
+    return p;
+}
+
+// Returns the wire size, out holds at least STATUS_WIRE_SIZE bytes
+static inline size_t status_serialize(const status_t* m, uint8_t* out) {
+    return (size_t)(status_put(m, out) - out);
+}
+
+static inline bool status_deserialize(status_t* m, const uint8_t* in, size_t size) {
+    return status_take(m, in, in + size) == in + size;
+}
+
+#ifdef __cplusplus
+namespace esp_dds {
+template <> struct MessageTraits<status_t> {
+    static constexpr uint32_t type_hash = STATUS_TYPE_HASH;
+    static constexpr size_t max_wire_size = STATUS_WIRE_SIZE;
+    static size_t serialize(const status_t* m, uint8_t* out) { return status_serialize(m, out); }
+    static bool deserialize(status_t* m, const uint8_t* in, size_t size) { return status_deserialize(m, in, size); }
+};
+} // namespace esp_dds
+#endif
+
+#endif // STATUS_MSG_H
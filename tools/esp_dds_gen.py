@@ -0,0 +1,465 @@
+#!/usr/bin/env python3
+"""Message type generator for ESP-DDS.
+
+Reads ROS2-style .msg files and writes one C/C++ header per message with the struct,
+its type hash, and a serializer/deserializer pair for the little-endian wire format
+described in src/esp_dds_msg.h.
+
+    python3 tools/esp_dds_gen.py -o src msg/Imu.msg msg/Status.msg
+
+Supported: bool, byte, char, int8..int64, uint8..uint64, float32, float64, bounded
+strings (string<=N), fixed arrays (T[N]), bounded sequences (T[<=N]), constants
+(TYPE NAME=value) and nested messages given in the same run. Everything has to fit
+a static buffer, so unbounded strings and sequences are refused.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HASH_SEED = 2166136261   # ESP_DDS_NAME_HASH_SEED
+HASH_PRIME = 16777619    # ESP_DDS_NAME_HASH_PRIME
+
+# name: (C type, wire bytes, put/get suffix, cast on load)
+PRIMITIVES = {
+    'bool':    ('bool',     1, 'u8',  None),
+    'byte':    ('uint8_t',  1, 'u8',  None),
+    'char':    ('char',     1, 'u8',  'char'),
+    'int8':    ('int8_t',   1, 'u8',  'int8_t'),
+    'uint8':   ('uint8_t',  1, 'u8',  None),
+    'int16':   ('int16_t',  2, 'u16', 'int16_t'),
+    'uint16':  ('uint16_t', 2, 'u16', None),
+    'int32':   ('int32_t',  4, 'u32', 'int32_t'),
+    'uint32':  ('uint32_t', 4, 'u32', None),
+    'int64':   ('int64_t',  8, 'u64', 'int64_t'),
+    'uint64':  ('uint64_t', 8, 'u64', None),
+    'float32': ('float',    4, 'f32', None),
+    'float64': ('double',   8, 'f64', None),
+}
+WIRE_TYPES = {'u8': 'uint8_t', 'u16': 'uint16_t', 'u32': 'uint32_t', 'u64': 'uint64_t'}
+COUNT_BYTES = 2          # u16 in front of every string and sequence
+FIELD_RE = re.compile(r'^([A-Za-z][A-Za-z0-9_]*)(<=\d+)?(\[(<=)?(\d*)\])?\s+([A-Za-z][A-Za-z0-9_]*)\s*(=\s*(.+))?$')
+
+
+class GenError(Exception):
+    pass
+
+
+def snake(name):
+    return re.sub(r'(?<=[a-z0-9])([A-Z])', r'_\1', name).lower()
+
+
+def fnv1a(text):
+    h = HASH_SEED
+    for b in text.encode():
+        h = ((h ^ b) * HASH_PRIME) & 0xFFFFFFFF
+    return h or 1        # 0 means "not bound" to the library
+
+
+class Field:
+    def __init__(self, base, name, string_bound=None, array=None, bounded=False):
+        self.base = base               # Primitive name, 'string' or a message name
+        self.name = name
+        self.string_bound = string_bound
+        self.array = array             # None, or the length / bound
+        self.bounded = bounded         # Sequence with a u16 count
+
+
+class Message:
+    def __init__(self, name, path):
+        self.name = name
+        self.path = path
+        self.snake = snake(name)
+        self.macro = self.snake.upper()
+        self.fields = []
+        self.constants = []            # (C type, name, value)
+        self.hash = None
+        self.wire_size = None          # Maximum
+        self.fixed = None              # No strings or sequences anywhere inside
+
+
+def parse(path):
+    name = os.path.splitext(os.path.basename(path))[0]
+    if not re.match(r'^[A-Z][A-Za-z0-9]*$', name):
+        raise GenError('%s: message names are CamelCase' % path)
+    msg = Message(name, path)
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            where = '%s:%d' % (path, number)
+            m = FIELD_RE.match(line)
+            if not m:
+                raise GenError('%s: cannot parse "%s"' % (where, line))
+            base, string_bound, array, bounded, length, field_name, _, value = m.groups()
+            if base == 'string':
+                if not string_bound:
+                    raise GenError('%s: strings need a bound, string<=N' % where)
+                string_bound = int(string_bound[2:])
+            elif string_bound:
+                raise GenError('%s: only strings take <=N' % where)
+            if value is not None:
+                if array or base not in PRIMITIVES and base != 'string':
+                    raise GenError('%s: constants are scalars' % where)
+                if not re.match(r'^[A-Z][A-Z0-9_]*$', field_name):
+                    raise GenError('%s: constant names are UPPER_CASE' % where)
+                msg.constants.append((base, field_name, value.strip()))
+                continue
+            if not re.match(r'^[a-z][a-z0-9_]*$', field_name):
+                raise GenError('%s: field names are snake_case' % where)
+            field = Field(base, field_name, string_bound)
+            if array:
+                if not length:
+                    raise GenError('%s: sequences need a bound, T[<=N]' % where)
+                if base == 'string':
+                    raise GenError('%s: arrays of strings are not supported' % where)
+                field.array = int(length)
+                field.bounded = bool(bounded)
+                if field.array == 0 or field.array > 0xFFFF:
+                    raise GenError('%s: array length out of range' % where)
+            if base == 'string' and (string_bound == 0 or string_bound > 0xFFFF):
+                raise GenError('%s: string bound out of range' % where)
+            if any(f.name == field_name for f in msg.fields):
+                raise GenError('%s: duplicate field %s' % (where, field_name))
+            msg.fields.append(field)
+    if not msg.fields:
+        raise GenError('%s: no fields' % path)
+    return msg
+
+
+def resolve(messages):
+    """Fills in hash, wire size and fixedness, nested types first."""
+    by_name = {m.name: m for m in messages}
+    state = {}
+
+    def visit(msg):
+        if state.get(msg.name) == 'done':
+            return
+        if state.get(msg.name) == 'open':
+            raise GenError('%s: %s contains itself' % (msg.path, msg.name))
+        state[msg.name] = 'open'
+        canonical = []
+        size = 0
+        fixed = True
+        for f in msg.fields:
+            if f.base in PRIMITIVES:
+                element, text = PRIMITIVES[f.base][1], f.base
+            elif f.base == 'string':
+                element, text = COUNT_BYTES + f.string_bound, 'string<=%d' % f.string_bound
+                fixed = False
+            elif f.base in by_name:
+                nested = by_name[f.base]
+                visit(nested)
+                element, text = nested.wire_size, '%s@%08x' % (nested.name, nested.hash)
+                fixed = fixed and nested.fixed
+            else:
+                raise GenError('%s: unknown type %s (nested messages go in the same run)' % (msg.path, f.base))
+            if f.array is None:
+                size += element
+            elif f.bounded:
+                size += COUNT_BYTES + element * f.array
+                text += '[<=%d]' % f.array
+                fixed = False
+            else:
+                size += element * f.array
+                text += '[%d]' % f.array
+            canonical.append('%s %s;' % (text, f.name))
+        msg.hash = fnv1a('%s{%s}' % (msg.name, ''.join(canonical)))
+        msg.wire_size = size
+        msg.fixed = fixed
+        state[msg.name] = 'done'
+
+    for m in messages:
+        visit(m)
+    return by_name
+
+
+class Writer:
+    def __init__(self):
+        self.lines = []
+
+    def __call__(self, text='', indent=0):
+        # Blank lines inside bodies carry the indentation of the code around them
+        self.lines.append(('    ' * indent + text) if text or indent else '')
+
+    def text(self):
+        return '\n'.join(self.lines) + '\n'
+
+
+def c_type(f, by_name):
+    if f.base in PRIMITIVES:
+        return PRIMITIVES[f.base][0]
+    return '%s_t' % by_name[f.base].snake
+
+
+def element_size(f, by_name):
+    if f.base in PRIMITIVES:
+        return PRIMITIVES[f.base][1]
+    return by_name[f.base].wire_size
+
+
+def put_element(f, target, at, by_name):
+    if f.base in PRIMITIVES:
+        _, _, suffix, _ = PRIMITIVES[f.base]
+        value = target if suffix.startswith('f') else '(%s)%s' % (WIRE_TYPES[suffix], target)
+        return 'esp_dds_put_%s(%s, %s);' % (suffix, at, value)
+    return '%s_put(&%s, %s);' % (by_name[f.base].snake, target, at)
+
+
+def get_element(f, target, at, by_name):
+    if f.base in PRIMITIVES:
+        _, _, suffix, cast = PRIMITIVES[f.base]
+        value = 'esp_dds_get_%s(%s)' % (suffix, at)
+        if f.base == 'bool':
+            value += ' != 0'
+        elif cast:
+            value = '(%s)%s' % (cast, value)
+        return '%s = %s;' % (target, value)
+    return '%s_take(&%s, %s, %s + %d);' % (by_name[f.base].snake, target, at, at, by_name[f.base].wire_size)
+
+
+def field_fixed(f, by_name):
+    if f.base == 'string' or f.bounded:
+        return False
+    return f.base in PRIMITIVES or by_name[f.base].fixed
+
+
+def runs(msg, by_name):
+    """Splits the fields into runs of fixed-size fields and single variable fields."""
+    out = []
+    for f in msg.fields:
+        if field_fixed(f, by_name):
+            if out and out[-1][0] == 'fixed':
+                out[-1][1].append(f)
+            else:
+                out.append(('fixed', [f]))
+        else:
+            out.append(('variable', [f]))
+    return out
+
+
+def emit_put(w, msg, by_name):
+    w('static inline uint8_t* %s_put(const %s_t* m, uint8_t* p) {' % (msg.snake, msg.snake))
+    for kind, fields in runs(msg, by_name):
+        if kind == 'fixed':
+            offset = 0
+            for f in fields:
+                size = element_size(f, by_name)
+                if f.array is None:
+                    w(put_element(f, 'm->%s' % f.name, 'p + %d' % offset, by_name), 1)
+                else:
+                    w('for (uint16_t i = 0; i < %d; i++) %s' % (
+                        f.array, put_element(f, 'm->%s[i]' % f.name, 'p + %d + i * %d' % (offset, size), by_name)), 1)
+                offset += size * (f.array or 1)
+            w('p += %d;' % offset, 1)
+            continue
+        f = fields[0]
+        if f.base == 'string':
+            w('uint16_t %s_length = (uint16_t)strnlen(m->%s, %d);' % (f.name, f.name, f.string_bound), 1)
+            w('esp_dds_put_u16(p, %s_length);' % f.name, 1)
+            w('memcpy(p + %d, m->%s, %s_length);' % (COUNT_BYTES, f.name, f.name), 1)
+            w('p += %d + %s_length;' % (COUNT_BYTES, f.name), 1)
+        elif f.bounded:
+            w('uint16_t %s_count = m->%s_count < %d ? m->%s_count : %d;' % (f.name, f.name, f.array, f.name, f.array), 1)
+            w('esp_dds_put_u16(p, %s_count);' % f.name, 1)
+            w('p += %d;' % COUNT_BYTES, 1)
+            if field_fixed(Field(f.base, f.name), by_name):
+                size = element_size(f, by_name)
+                w('for (uint16_t i = 0; i < %s_count; i++) %s' % (
+                    f.name, put_element(f, 'm->%s[i]' % f.name, 'p + i * %d' % size, by_name)), 1)
+                w('p += %s_count * %d;' % (f.name, size), 1)
+            else:
+                w('for (uint16_t i = 0; i < %s_count; i++) p = %s_put(&m->%s[i], p);' % (
+                    f.name, by_name[f.base].snake, f.name), 1)
+        elif f.array is None:
+            w('p = %s_put(&m->%s, p);' % (by_name[f.base].snake, f.name), 1)
+        else:
+            w('for (uint16_t i = 0; i < %d; i++) p = %s_put(&m->%s[i], p);' % (
+                f.array, by_name[f.base].snake, f.name), 1)
+    w('return p;', 1)
+    w('}')
+
+
+def emit_take(w, msg, by_name):
+    w('// NULL when the input is short or a count is over its bound')
+    w('static inline const uint8_t* %s_take(%s_t* m, const uint8_t* p, const uint8_t* end) {' % (msg.snake, msg.snake))
+    for kind, fields in runs(msg, by_name):
+        if kind == 'fixed':
+            total = sum(element_size(f, by_name) * (f.array or 1) for f in fields)
+            w('if (end - p < %d) return NULL;' % total, 1)
+            offset = 0
+            for f in fields:
+                size = element_size(f, by_name)
+                if f.array is None:
+                    w(get_element(f, 'm->%s' % f.name, 'p + %d' % offset, by_name), 1)
+                else:
+                    w('for (uint16_t i = 0; i < %d; i++) %s' % (
+                        f.array, get_element(f, 'm->%s[i]' % f.name, 'p + %d + i * %d' % (offset, size), by_name)), 1)
+                offset += size * (f.array or 1)
+            w('p += %d;' % offset, 1)
+            continue
+        f = fields[0]
+        if f.base == 'string':
+            w('if (end - p < %d) return NULL;' % COUNT_BYTES, 1)
+            w('uint16_t %s_length = esp_dds_get_u16(p);' % f.name, 1)
+            w('p += %d;' % COUNT_BYTES, 1)
+            w('if (%s_length > %d || end - p < %s_length) return NULL;' % (f.name, f.string_bound, f.name), 1)
+            w('memcpy(m->%s, p, %s_length);' % (f.name, f.name), 1)
+            w("m->%s[%s_length] = '\\0';" % (f.name, f.name), 1)
+            w('p += %s_length;' % f.name, 1)
+        elif f.bounded:
+            w('if (end - p < %d) return NULL;' % COUNT_BYTES, 1)
+            w('m->%s_count = esp_dds_get_u16(p);' % f.name, 1)
+            w('p += %d;' % COUNT_BYTES, 1)
+            if field_fixed(Field(f.base, f.name), by_name):
+                size = element_size(f, by_name)
+                w('if (m->%s_count > %d || end - p < m->%s_count * %d) return NULL;' % (
+                    f.name, f.array, f.name, size), 1)
+                w('for (uint16_t i = 0; i < m->%s_count; i++) %s' % (
+                    f.name, get_element(f, 'm->%s[i]' % f.name, 'p + i * %d' % size, by_name)), 1)
+                w('p += m->%s_count * %d;' % (f.name, size), 1)
+            else:
+                w('if (m->%s_count > %d) return NULL;' % (f.name, f.array), 1)
+                w('for (uint16_t i = 0; i < m->%s_count && p; i++) p = %s_take(&m->%s[i], p, end);' % (
+                    f.name, by_name[f.base].snake, f.name), 1)
+                w('if (!p) return NULL;', 1)
+        elif f.array is None:
+            w('if (!(p = %s_take(&m->%s, p, end))) return NULL;' % (by_name[f.base].snake, f.name), 1)
+        else:
+            w('for (uint16_t i = 0; i < %d && p; i++) p = %s_take(&m->%s[i], p, end);' % (
+                f.array, by_name[f.base].snake, f.name), 1)
+            w('if (!p) return NULL;', 1)
+    w('return p;', 1)
+    w('}')
+
+
+def dense_terms(msg, by_name):
+    """Conditions under which the struct is byte for byte its wire form."""
+    terms = ['ESP_DDS_WIRE_NATIVE', 'sizeof(%s_t) == %s_WIRE_SIZE' % (msg.snake, msg.macro)]
+    offset = 0
+    for f in msg.fields:
+        if f.base == 'bool':
+            return None        # Any byte but 0 or 1 is not a valid bool
+        if f.base not in PRIMITIVES:
+            terms.append('%s_DENSE' % by_name[f.base].macro)
+        terms.append('offsetof(%s_t, %s) == %d' % (msg.snake, f.name, offset))
+        offset += element_size(f, by_name) * (f.array or 1)
+    return terms
+
+
+def generate(msg, by_name, source):
+    w = Writer()
+    guard = '%s_MSG_H' % msg.macro
+    nested = []
+    for f in msg.fields:
+        if f.base in by_name and f.base not in nested:
+            nested.append(f.base)
+
+    w('// Generated by tools/esp_dds_gen.py from %s, do not edit' % source)
+    w('#ifndef %s' % guard)
+    w('#define %s' % guard)
+    w()
+    w('#include "esp_dds_msg.h"')
+    for n in nested:
+        w('#include "%s_msg.h"' % by_name[n].snake)
+    w()
+    w('#define %s_TYPE_HASH 0x%08XUL' % (msg.macro, msg.hash))
+    w('#define %s_WIRE_SIZE %d%s' % (msg.macro, msg.wire_size, '' if msg.fixed else '           // Largest sample'))
+    w('#define %s_FIXED %d' % (msg.macro, 1 if msg.fixed else 0))
+    for ros_type, name, value in msg.constants:
+        if ros_type == 'bool':
+            value = '1' if value.lower() == 'true' else '0'
+        elif ros_type in ('float32', 'float64') and not re.search(r'[.eE]', value):
+            value += '.0'
+        w('#define %s_%s %s' % (msg.macro, name, value))
+    w()
+    w('typedef struct {')
+    for f in msg.fields:
+        if f.base == 'string':
+            w('char %s[%d];' % (f.name, f.string_bound + 1), 1)
+            continue
+        if f.bounded:
+            w('uint16_t %s_count;' % f.name, 1)
+        w('%s %s%s;' % (c_type(f, by_name), f.name, '[%d]' % f.array if f.array else ''), 1)
+    w('} %s_t;' % msg.snake)
+    w()
+
+    terms = dense_terms(msg, by_name) if msg.fixed else None
+    if msg.fixed:
+        w('// Struct layout equals the wire layout, serializing is a memcpy')
+        if terms:
+            w('#define %s_DENSE (%s)' % (msg.macro, ' && \\\n    '.join(terms)))
+        else:
+            w('#define %s_DENSE 0' % msg.macro)
+        w()
+
+    emit_put(w, msg, by_name)
+    w()
+    emit_take(w, msg, by_name)
+    w()
+    w('// Returns the wire size, out holds at least %s_WIRE_SIZE bytes' % msg.macro)
+    w('static inline size_t %s_serialize(const %s_t* m, uint8_t* out) {' % (msg.snake, msg.snake))
+    if msg.fixed:
+        w('if (%s_DENSE) {' % msg.macro, 1)
+        w('memcpy(out, m, %s_WIRE_SIZE);' % msg.macro, 2)
+        w('return %s_WIRE_SIZE;' % msg.macro, 2)
+        w('}', 1)
+    w('return (size_t)(%s_put(m, out) - out);' % msg.snake, 1)
+    w('}')
+    w()
+    w('static inline bool %s_deserialize(%s_t* m, const uint8_t* in, size_t size) {' % (msg.snake, msg.snake))
+    if msg.fixed:
+        w('if (size != %s_WIRE_SIZE) return false;' % msg.macro, 1)
+        w('if (%s_DENSE) {' % msg.macro, 1)
+        w('memcpy(m, in, %s_WIRE_SIZE);' % msg.macro, 2)
+        w('return true;', 2)
+        w('}', 1)
+    w('return %s_take(m, in, in + size) == in + size;' % msg.snake, 1)
+    w('}')
+    w()
+    w('#ifdef __cplusplus')
+    w('namespace esp_dds {')
+    w('template <> struct MessageTraits<%s_t> {' % msg.snake)
+    w('static constexpr uint32_t type_hash = %s_TYPE_HASH;' % msg.macro, 1)
+    w('static constexpr size_t max_wire_size = %s_WIRE_SIZE;' % msg.macro, 1)
+    w('static size_t serialize(const %s_t* m, uint8_t* out) { return %s_serialize(m, out); }' % (
+        msg.snake, msg.snake), 1)
+    w('static bool deserialize(%s_t* m, const uint8_t* in, size_t size) { return %s_deserialize(m, in, size); }' % (
+        msg.snake, msg.snake), 1)
+    w('};')
+    w('} // namespace esp_dds')
+    w('#endif')
+    w()
+    w('#endif // %s' % guard)
+    return w.text()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate ESP-DDS message headers from .msg files')
+    parser.add_argument('-o', '--output', default='.', help='directory for the <name>_msg.h headers')
+    parser.add_argument('inputs', nargs='+', help='.msg files, nested types included')
+    args = parser.parse_args()
+    try:
+        messages = [parse(p) for p in args.inputs]
+        names = [m.name for m in messages]
+        if len(set(names)) != len(names):
+            raise GenError('a message name is given twice')
+        by_name = resolve(messages)
+        os.makedirs(args.output, exist_ok=True)
+        for m in messages:
+            source = os.path.basename(m.path)
+            path = os.path.join(args.output, '%s_msg.h' % m.snake)
+            with open(path, 'w') as f:
+                f.write(generate(m, by_name, source))
+            print('%s -> %s (hash 0x%08X, %d bytes%s)' % (
+                source, path, m.hash, m.wire_size, '' if m.fixed else ' max'))
+    except (GenError, OSError) as e:
+        print('esp_dds_gen: %s' % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())